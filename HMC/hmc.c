@@ -167,8 +167,11 @@ int main(int argc, char *argv[])
     eva_vals = malloc(sizeof(double) * eigval_var.nevt);
     eva_vecs = alloc_spinor_field_f(eigval_var.nevt, &glattice);
   }
+  /* with several replicas, the trajectories can be shared between them */
+  init_replica_pool(flow.shared_traj);
+
   rc = acc = 0;
-  for (i = flow.start; i < flow.end; ++i)
+  for (i = flow.start; i < flow.end && replica_pool_next(); ++i)
   {
     int rr;
     double perc;
@@ -212,19 +215,12 @@ int main(int argc, char *argv[])
 
     lprintf("MAIN", 0, "Trajectory #%d: %d/%d (%3.4f%%) MVM (f;d) = %ld ; %ld\n", i, acc, rc, perc, getMVM_flt(), getMVM());
 
+    /* complete the checkpoints written in the background, if they are done */
+    async_save_poll();
+
     if ((i % flow.save_freq) == 0)
     {
-      save_conf(&flow, i);
-      if (u_scalar != NULL)
-      {
-        save_scalar_conf(&flow, i);
-      }
-      /* Only save state if we have a file to save to */
-      if (rlx_var.rlxd_state[0] != '\0')
-      {
-        lprintf("MAIN", 0, "Saving rlxd state to file %s\n", rlx_var.rlxd_state);
-        write_ranlxd_state(rlx_var.rlxd_state);
-      }
+      save_checkpoint(&flow, i, rlx_var.rlxd_state);
     }
 
 #ifdef MEASURE_FORCE
@@ -297,20 +293,14 @@ int main(int argc, char *argv[])
   }
 
   /* save final configuration */
-  if (((--i) % flow.save_freq) != 0)
+  if (rc > 0 && ((--i) % flow.save_freq) != 0)
   {
-    save_conf(&flow, i);
-    if (u_scalar != NULL)
-    {
-      save_scalar_conf(&flow, i);
-    }
-    /* Only save state if we have a file to save to */
-    if (rlx_var.rlxd_state[0] != '\0')
-    {
-      lprintf("MAIN", 0, "Saving rlxd state to file %s\n", rlx_var.rlxd_state);
-      write_ranlxd_state(rlx_var.rlxd_state);
-    }
+    save_checkpoint(&flow, i, rlx_var.rlxd_state);
   }
+  async_save_wait();
+
+  /* throughput of this replica and of all of them */
+  replica_report(rc, acc);
 
 #ifdef MEASURE_FORCE
   free(force_ave);
@@ -273,6 +273,8 @@ int init_mc_ghmc(hmc_flow *rf, char *ifile)
 	strcpy(rf->conf_dir, "./");
 	rf->save_freq = 0;
 	rf->meas_freq = 0;
+	rf->async_save = 0;
+	rf->shared_traj = 0;
 	rf->hmc_v = &hmc_var;
 
 	read_input(hmc_var.read, ifile);
@@ -384,3 +386,44 @@ int save_scalar_conf(hmc_flow *rf, int id)
 
 	return 0;
 }
+
+/* save the gauge config, the scalar field and the rlxd state (if rlxd_state is not empty) with the specified id.
+ * With async save the fields are copied to a staging buffer and written while the next trajectories run:
+ * the files appear under their final names only once they are complete
+ */
+int save_checkpoint(hmc_flow *rf, int id, char *rlxd_state)
+{
+	char buf[256];
+
+	if (rf->async_save == 0)
+	{
+		save_conf(rf, id);
+		if (u_scalar != NULL)
+		{
+			save_scalar_conf(rf, id);
+		}
+		/* Only save state if we have a file to save to */
+		if (rlxd_state[0] != '\0')
+		{
+			lprintf("MAIN", 0, "Saving rlxd state to file %s\n", rlxd_state);
+			write_ranlxd_state(rlxd_state);
+		}
+		return 0;
+	}
+
+	mk_gconf_name(buf, rf, id);
+	async_save_gauge_field(add_dirname(rf->conf_dir, buf));
+	if (u_scalar != NULL)
+	{
+		mk_sconf_name(buf, rf, id);
+		async_save_scalar_field(add_dirname(rf->conf_dir, buf));
+	}
+	if (rlxd_state[0] != '\0')
+	{
+		lprintf("MAIN", 0, "Saving rlxd state to file %s\n", rlxd_state);
+		async_save_ranlxd_state(rlxd_state);
+	}
+	async_save_start();
+
+	return 0;
+}
@@ -15,7 +15,7 @@ typedef struct _input_hmc
   /* hmc parameters */
   ghmc_par hmc_p;
   /* for the reading function */
-  input_record_t read[14];
+  input_record_t read[19];
 
 } input_hmc;
 
@@ -35,6 +35,11 @@ typedef struct _input_hmc
       {"smearing space", "rho_s = %lf", DOUBLE_T, &(varname).hmc_p.rho_s},            \
       {"smearing time", "rho_t = %lf", DOUBLE_T, &(varname).hmc_p.rho_t},             \
       {"csw", "csw = %lf", DOUBLE_T, &(varname).hmc_p.csw},                           \
+      {"tune trajectories", "tune_ntraj = %d", INT_T, &(varname).hmc_p.tune_ntraj},   \
+      {"tune acceptance", "tune_acc = %lf", DOUBLE_T, &(varname).hmc_p.tune_acc},     \
+      {"tune apply", "tune_apply = %d", INT_T, &(varname).hmc_p.tune_apply},          \
+      {"tune log", "tune_log = %s", STRING_T, &((varname).hmc_p.tune_log[0])},        \
+      {"cost log", "cost_log = %s", STRING_T, &((varname).hmc_p.cost_log[0])},        \
       {NULL, NULL, 0, NULL}                                                           \
     }                                                                                 \
   }
@@ -50,6 +55,8 @@ typedef struct _hmc_flow
 
   int save_freq; /* save gauge conf if number%save_freq==0 */
   int meas_freq; /* mk measures if number%meas_freq==0 */
+  int async_save; /* write the checkpoints in the background */
+  int shared_traj; /* trajectories shared by the replicas (0 => no limit) */
 
   /* these are not actually read from input
    * but inferred from the above
@@ -58,7 +65,7 @@ typedef struct _hmc_flow
   input_hmc *hmc_v;
 
   /* for the reading function */
-  input_record_t read[7];
+  input_record_t read[9];
 
 } hmc_flow;
 
@@ -71,6 +78,8 @@ typedef struct _hmc_flow
       {"conf save frequency", "save freq = %d", INT_T, &((varname).save_freq)},   \
       {"measure frequency", "meas freq = %d", INT_T, &((varname).meas_freq)},     \
       {"config dir", "conf dir = %s", STRING_T, &((varname).conf_dir[0])},        \
+      {"asynchronous save", "async save = %d", INT_T, &((varname).async_save)},   \
+      {"shared trajectories", "shared traj = %d", INT_T, &((varname).shared_traj)}, \
       {NULL, NULL, 0, NULL}                                                       \
     }                                                                             \
   }
@@ -78,5 +87,6 @@ typedef struct _hmc_flow
 int init_mc_ghmc(hmc_flow *rf, char *ifile);
 int save_conf(hmc_flow *rf, int id);
 int save_scalar_conf(hmc_flow *rf, int id);
+int save_checkpoint(hmc_flow *rf, int id, char *rlxd_state);
 
 #endif /* HMC_UTILS_H */
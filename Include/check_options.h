@@ -216,4 +216,16 @@
 #error Exponential lover term cannot be use simultaneously with the dirac smearing (not yet implemented)
 #endif
 
+#if defined(WITH_SIMD_LAYOUT) && defined(GAUGE_SPN) && defined(REPR_FUNDAMENTAL)
+#error The site-blocked layout is not available for the compressed Sp(2N) fundamental links
+#endif
+
+#if defined(WITH_PROJECTED_HALO) && !defined(WITH_MPI)
+#error The projected halo exchange requires WITH_MPI
+#endif
+
+#if defined(WITH_COMM_OVERLAP) && !defined(WITH_MPI)
+#error The communication overlap requires WITH_MPI
+#endif
+
 #endif /* CHECK_OPTIONS_H */
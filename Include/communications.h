@@ -7,6 +7,14 @@
 #define COMMUNICATIONS_H
 
 void global_sum(double *d, int n);
+#ifdef WITH_MPI
+#include <mpi.h>
+typedef MPI_Request global_sum_request;
+#else
+typedef int global_sum_request;
+#endif
+void global_sum_start(double *d, int n, global_sum_request *req);
+void global_sum_wait(global_sum_request *req);
 void global_sum_int(int *d, int n);
 void global_max(double *d, int n);
 void bcast(double *d, int n);
@@ -17,6 +25,8 @@ void complete_gf_sendrecv(suNg_field *gf);
 void start_gf_sendrecv(suNg_field *gf);
 void complete_sf_sendrecv(spinor_field *gf);
 void start_sf_sendrecv(spinor_field *gf);
+void complete_sf_sendrecv_block(spinor_field *sf, int n);
+void start_sf_sendrecv_block(spinor_field *sf, int n);
 void complete_sc_sendrecv(suNg_scalar_field *gf);
 void start_sc_sendrecv(suNg_scalar_field *gf);
 
@@ -38,6 +48,38 @@ void complete_gf_sendrecv_flt(suNg_field_flt *gf);
 void start_gf_sendrecv_flt(suNg_field_flt *gf);
 void complete_sf_sendrecv_flt(spinor_field_flt *gf);
 void start_sf_sendrecv_flt(spinor_field_flt *gf);
+void complete_sf_sendrecv_half(spinor_field_half *gf);
+void start_sf_sendrecv_half(spinor_field_half *gf);
+
+#ifdef WITH_PROJECTED_HALO
+/* Spin-projected halo exchange (communications_proj.c) */
+void complete_sf_sendrecv_proj(spinor_field *sf);
+void start_sf_sendrecv_proj(spinor_field *sf);
+void sf_proj_halo(geometry_descriptor *gd, int **slot, suNf_hspinor **hbuf);
+#endif
+
+#ifdef WITH_COMM_OVERLAP
+/* Overlap of the halo exchange with the Dirac operator (communications_overlap.c) */
+#include <sys/time.h>
+typedef struct
+{
+  geometry_descriptor *out_type, *in_type;
+  int nfaces, npieces;
+  unsigned int *mask;   /* receive buffers needed by each boundary piece */
+  unsigned int *queued; /* boundary pieces already in order */
+  unsigned int arrived; /* receive buffers completed */
+  int *order;           /* boundary pieces in order of availability */
+  int nready;
+  MPI_Request *req;
+  struct timeval tstart, tinner, *tface;
+} sf_overlap;
+
+sf_overlap *sf_overlap_start(geometry_descriptor *out_type, geometry_descriptor *in_type, MPI_Request *req);
+void sf_overlap_progress(sf_overlap *ov);
+int sf_overlap_next_piece(sf_overlap *ov, int k);
+void sf_overlap_inner_done(sf_overlap *ov);
+void sf_overlap_end(sf_overlap *ov);
+#endif
 
 
 #endif /* COMMUNICATIONS_H */
@@ -12,6 +12,7 @@
 
 void Dphi_(spinor_field *out, spinor_field *in);
 void Dphi_fused_(spinor_field *out, spinor_field *in);
+void Dphi_block_(spinor_field *out, spinor_field *in, int n);
 void Dphi(double m0, spinor_field *out, spinor_field *in);
 void g5Dphi(double m0, spinor_field *out, spinor_field *in);
 void g5Dphi_sq(double m0, spinor_field *out, spinor_field *in);
@@ -21,6 +22,22 @@ void Dphi_flt(double m0, spinor_field_flt *out, spinor_field_flt *in);
 void g5Dphi_flt(double m0, spinor_field_flt *out, spinor_field_flt *in);
 void g5Dphi_sq_flt(double m0, spinor_field_flt *out, spinor_field_flt *in);
 
+/* 16-bit storage, single precision arithmetic; no spinor boundary conditions */
+void Dphi_half_(spinor_field_half *out, spinor_field_half *in);
+void Dphi_half(double m0, spinor_field_half *out, spinor_field_half *in);
+void g5Dphi_half(double m0, spinor_field_half *out, spinor_field_half *in);
+void g5Dphi_sq_half(double m0, spinor_field_half *out, spinor_field_half *in);
+void g5Dphi_eopre_half(double m0, spinor_field_half *out, spinor_field_half *in);
+void g5Dphi_eopre_sq_half(double m0, spinor_field_half *out, spinor_field_half *in);
+
+#ifdef WITH_SIMD_LAYOUT
+void Dphi_simd_(spinor_field *out, spinor_field *in);
+void Dphi_flt_simd_(spinor_field_flt *out, spinor_field_flt *in);
+#endif
+#ifdef WITH_PROJECTED_HALO
+void Dphi_proj_(spinor_field *out, spinor_field *in);
+#endif
+
 unsigned long int getMVM();
 unsigned long int getMVM_flt();
 
@@ -39,6 +56,8 @@ void Dphi_eopre(double m0, spinor_field *out, spinor_field *in);
 void Dphi_oepre(double m0, spinor_field *out, spinor_field *in);
 void g5Dphi_eopre(double m0, spinor_field *out, spinor_field *in);
 void g5Dphi_eopre_sq(double m0, spinor_field *out, spinor_field *in);
+void Dphi_eopre_block(double m0, spinor_field *out, spinor_field *in, int n);
+void g5Dphi_eopre_block(double m0, spinor_field *out, spinor_field *in, int n);
 
 void Dphi_eopre_flt(double m0, spinor_field_flt *out, spinor_field_flt *in);
 void Dphi_oepre_flt(double m0, spinor_field_flt *out, spinor_field_flt *in);
@@ -58,6 +77,7 @@ void set_twisted_mass(double mass); //this is the twisted mass used in the twist
 void H(spinor_field *out, spinor_field *in);
 void H_flt(spinor_field_flt *out, spinor_field_flt *in);
 void H2(spinor_field *out, spinor_field *in);
+void H2_flt(spinor_field_flt *out, spinor_field_flt *in);
 void D(spinor_field *out, spinor_field *in);
 void D_flt(spinor_field_flt *out, spinor_field_flt *in);
 
@@ -93,6 +93,25 @@ int proc_dn(int id, int dir);
 void free_geometry_mpi_eo(void);
 
 void init_geometry_SAP(void);
+
+/*
+ * Blocks of bs[0]x..xbs[3] sites of the local lattice, coloured as a
+ * checkerboard of the global block coordinates (geometry_SAP.c).
+ * Blocks and the sites inside a block are in lexicographic order, T slowest.
+ */
+typedef struct _SAP_blocks
+{
+  int bs[4];      /* size of the blocks */
+  int nbl[4];     /* number of blocks in each direction */
+  int nb, bvol;   /* local blocks, sites per block */
+  int *site;      /* site[b*bvol+n]: index of the n-th site of the block b */
+  int *cblk[2];   /* blocks of each colour */
+  int ncblk[2];
+  int *iup, *idn; /* iup[4*n+mu]: neighbour in direction mu of the n-th site of a block, -1 outside the block */
+} SAP_blocks;
+
+SAP_blocks *init_SAP_blocks(int *bs);
+void free_SAP_blocks(SAP_blocks *sb);
 void test_geometry_mpi(void);
 void test_geometry_mpi_eo(void);
 void print_wdmatrix(char *filename);
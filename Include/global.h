@@ -143,6 +143,7 @@ GLB_VAR(suNg_field_flt,*u_gauge_flt,=NULL);
 GLB_VAR(suNf_field,*u_gauge_f,=NULL);
 GLB_VAR(suNg_field,*u_gauge_s,=NULL);
 GLB_VAR(suNf_field_flt,*u_gauge_f_flt,=NULL);
+GLB_VAR(suNf_field_half,*u_gauge_f_half,=NULL);
 #if defined(GAUGE_SPN) && defined(REPR_FUNDAMENTAL)
 GLB_VAR(suNffull_field,*cl_term,=NULL);
 GLB_VAR(suNffull_field,*cl_force,=NULL);
@@ -151,6 +152,10 @@ GLB_VAR(suNfc_field,*cl_term,=NULL);
 GLB_VAR(suNf_field,*cl_force,=NULL);
 #endif
 GLB_VAR(ldl_field,*cl_ldl,=NULL);
+#ifdef WITH_SIMD_LAYOUT
+GLB_VAR(suNf_field_simd,*u_gauge_f_simd,=NULL);
+GLB_VAR(suNf_field_simd_flt,*u_gauge_f_simd_flt,=NULL);
+#endif
 GLB_VAR(suNg_av_field,*suN_momenta,=NULL);
 GLB_VAR(suNg_scalar_field,*scalar_momenta,=NULL);
 GLB_VAR(int,gauge_field_active,=0); // whether gauge field interactions is active
@@ -160,6 +165,7 @@ GLB_VAR(int,gauge_field_active,=0); // whether gauge field interactions is activ
 #define pu_gauge_flt(ix,mu) ((u_gauge_flt->ptr)+coord_to_index(ix,mu))
 #define pu_gauge_f(ix,mu) ((u_gauge_f->ptr)+coord_to_index(ix,mu))
 #define pu_gauge_f_flt(ix,mu) ((u_gauge_f_flt->ptr)+coord_to_index(ix,mu))
+#define pu_gauge_f_half(ix,mu) ((u_gauge_f_half->ptr)+coord_to_index(ix,mu))
 
 /* input parameters */
 #include "input_par.h"
@@ -214,6 +220,19 @@ GLB_VAR(scalar_field,*ff_pi_mom,=NULL);
 
 GLB_VAR(int,four_fermion_active,=0); // whether four fermion interactions are active
 
+/* Counters of the work done by this process, never reset:
+ * read by the cost accounting of the HMC (hmc_cost.c)
+ */
+typedef struct
+{
+  unsigned long int mvm;        /* Dirac operator applications, double precision (x2 on the full lattice) */
+  unsigned long int mvm_flt;    /* Dirac operator applications, single precision (x2 on the full lattice) */
+  unsigned long int iter;       /* iterations of the solvers used by the monomials */
+  unsigned long int halo_bytes; /* bytes sent in halo exchanges */
+  unsigned long int halos;      /* halo exchanges */
+  unsigned long int reductions; /* global reductions (MPI) */
+} cost_counters;
+GLB_VAR(cost_counters,cost_cnt,={0});
 
 
 
@@ -13,7 +13,9 @@
 
 typedef void (*spinor_operator)(spinor_field *out, spinor_field *in);
 typedef void (*spinor_operator_flt)(spinor_field_flt *out, spinor_field_flt *in);
+typedef void (*spinor_operator_half)(spinor_field_half *out, spinor_field_half *in);
 typedef void (*spinor_operator_m)(spinor_field *out, spinor_field *in, double m);
+typedef void (*spinor_operator_block)(spinor_field *out, spinor_field *in, int n);
 
 typedef struct _mshift_par {
    int n; /* number of shifts */
@@ -37,8 +39,45 @@ void SAP_prec(int nu, inverter_ptr inv, mshift_par *par, spinor_operator M, spin
  */
 int cg_mshift(mshift_par *par, spinor_operator M, spinor_field *in, spinor_field *out);
 int cg_mshift_def(mshift_par *par, spinor_operator M, spinor_operator P, spinor_operator_m Pinv, spinor_field *in, spinor_field *out);
+/*
+ * as cg_mshift, with the bulk of the iterations done in single precision
+ * with F, the same operator as M: converged shifts leave the recursion,
+ * then each shift is refined in double precision to par->err2.
+ */
 int cg_mshift_flt(mshift_par *par, spinor_operator M, spinor_operator_flt F, spinor_field *in, spinor_field *out);
 
+/*
+ * CG for (M-par->shift[0]) out = in, M hermitian positive, par->n = 1,
+ * with the same operator in three precisions: M (double), F (single)
+ * and H (half, see spinor_field.h).
+ * The Krylov vectors are stored in half precision; the solution and the
+ * residual are single precision, the residual being recomputed with F
+ * (reliable update) each time it has dropped by a factor 10.
+ * An outer defect correction with M gives the accuracy par->err2.
+ * out is used as initial guess; par->max_iter bounds the applications of H.
+ * Returns the total number of operator applications.
+ */
+int cg_half(mshift_par *par, spinor_operator M, spinor_operator_flt F, spinor_operator_half H, spinor_field *in, spinor_field *out);
+
+/*
+ * Pipelined CG for (M-par->shift[0]) out = in, M hermitian positive, par->n = 1:
+ * the scalar products of an iteration are combined in one non-blocking
+ * global sum, which runs during the application of M.
+ * out is used as initial guess.
+ * Returns the number of applications of M.
+ */
+int cg_pipelined(mshift_par *par, spinor_operator M, spinor_field *in, spinor_field *out);
+
+/*
+ * Block solvers for n right-hand sides sharing one Krylov space, with one
+ * application of the block operator M and one global reduction per iteration:
+ * cg_block:     (M-par->shift[0]) out[k] = in[k], M hermitian positive, par->n = 1
+ * MINRES_block: M out[k] = in[k], M hermitian
+ * out is used as initial guess.
+ * They return the number of applications of M to a single spinor field.
+ */
+int cg_block(mshift_par *par, spinor_operator_block M, spinor_field *in, spinor_field *out, int n);
+
 
 typedef struct {
   double err2; /* maximum error on the solutions */
@@ -71,6 +110,86 @@ int MINRES_mshift(mshift_par *par, spinor_operator M, spinor_field *in, spinor_f
 
 int MINRES(MINRES_par *par, spinor_operator M, spinor_field *in, spinor_field *out, spinor_field *trial);
 int MINRES_flt(MINRES_par *par, spinor_operator_flt M, spinor_field_flt *in, spinor_field_flt *out, spinor_field_flt *trial);
+int MINRES_block(MINRES_par *par, spinor_operator_block M, spinor_field *in, spinor_field *out, int n);
+
+/*
+ * Flexible restarted GCR: M out = in, with a (possibly variable)
+ * preconditioner prec, which may be NULL.
+ * out is used as initial guess.
+ * Returns the number of applications of M.
+ */
+typedef struct _GCR_par {
+  double err2; /* maximum error on the solutions */
+  int max_iter; /* maximum number of iterations: 0 => infinity */
+  int nkv; /* number of Krylov vectors before restart: 0 => default */
+} GCR_par;
+
+int GCR(GCR_par *par, spinor_operator M, spinor_operator prec, spinor_field *in, spinor_field *out);
+
+/*
+ * Schwarz alternating procedure on blocks of the local lattice for the
+ * Wilson(-clover) operator D(mass) (SAP_precondition.c).
+ * The blocks are coloured as a checkerboard; the block systems, with
+ * Dirichlet boundary conditions, are solved with niter MR iterations,
+ * the blocks of one colour in parallel over the OpenMP threads.
+ * SAP_block_prec computes out = K in with nu cycles on glattice and returns
+ * the number of applications of D. SAP_update must be called when the gauge
+ * field or the mass change.
+ * SAP_GCR has the interface of inverter_ptr and takes the SAP_par from
+ * par->add_par: it solves M out = in with a flexible GCR preconditioned by K,
+ * M being D(mass) on glattice or the even/odd preconditioned D(mass) on glat_even.
+ */
+struct _SAP_data;
+
+typedef struct _SAP_par {
+  double mass; /* mass of the Dirac operator */
+  int block[4]; /* size of the blocks in the T,X,Y,Z directions */
+  int nu; /* SAP cycles */
+  int niter; /* MR iterations for the block solves */
+  int gcr_nkv; /* Krylov vectors of the outer GCR */
+  struct _SAP_data *data;
+} SAP_par;
+
+void SAP_init(SAP_par *sap, double mass);
+void SAP_free(SAP_par *sap);
+void SAP_update(SAP_par *sap);
+int SAP_block_prec(SAP_par *sap, spinor_field *in, spinor_field *out);
+int SAP_GCR(mshift_par *par, spinor_operator M, spinor_field *in, spinor_field *out);
+
+/*
+ * Adaptive aggregation multigrid for the Wilson(-clover) operator
+ * D(mass) (multigrid.c).
+ * The aggregates are blocks of the local lattice; the coarse space is
+ * spanned by the chiral projections of nvec null-space vectors on each
+ * block. The cycle is a coarse-grid correction followed by SAP smoothing
+ * on the same blocks, used as preconditioner of a flexible GCR.
+ * mg_solve has the interface of inverter_ptr and takes the mg_par from
+ * par->add_par; M must be D(mass) on glattice or the even/odd
+ * preconditioned D(mass) on glat_even.
+ */
+struct _mg_data;
+
+typedef struct _mg_par {
+  double mass; /* mass of the Dirac operator */
+  int block[4]; /* size of the aggregates in the T,X,Y,Z directions */
+  int nvec; /* number of null-space vectors */
+  int setup_iter; /* inverse iterations in the setup */
+  int setup_eva; /* if >0, maximal eva iterations to start the setup from the low modes of (g5 D)^2 */
+  int reuse; /* when the gauge field changes, refresh the null space instead of rebuilding it */
+  int refresh_iter; /* inverse iterations of a refresh */
+  int nu; /* SAP smoothing cycles */
+  int sap_iter; /* MR iterations for the SAP block solves */
+  double coarse_err2; /* error on the coarse-grid solutions */
+  int coarse_max_iter; /* maximum number of coarse-grid iterations */
+  int gcr_nkv; /* Krylov vectors of the outer GCR */
+  struct _mg_data *data;
+} mg_par;
+
+void mg_init(mg_par *mg, double mass);
+void mg_free(mg_par *mg);
+void mg_setup(mg_par *mg);
+void mg_update(mg_par *mg);
+int mg_solve(mshift_par *par, spinor_operator M, spinor_field *in, spinor_field *out);
 
 int eva(int nev,int nevt,int init,int kmax,
                int imax,double ubnd,double omega1,double omega2,
@@ -83,6 +202,7 @@ int eva_tuned(int nev,int nevt,int init,int kmax,
 
 void jacobi1(int n,double a[],double d[],double v[]);
 void jacobi2(int n,double complex a[],double d[],double complex v[]);
+int block_orthonormalize(int n, double complex *g, double tol, double complex *t);
 
 
 
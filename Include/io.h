@@ -22,6 +22,11 @@ int fread_BE_double(double* ptr, size_t n, FILE* fp);
 int fread_LE_double(double* ptr, size_t n, FILE* fp);
 int fread_BE_float(float* ptr, size_t n, FILE* fp);
 
+void to_BE_int(int* ptr, size_t n);
+void to_LE_int(int* ptr, size_t n);
+void to_BE_double(double* ptr, size_t n);
+void to_LE_double(double* ptr, size_t n);
+
 void read_gauge_field(char filename[]);
 void write_gauge_field(char filename[]);
 void read_scalar_field(char filename[]);
@@ -43,6 +48,14 @@ void write_gauge_field_su2q(char filename[]);
 void write_ranlxd_state(char filename[]);
 void read_ranlxd_state(char filename[]);
 
+/* checkpoints written in the background (archive_async.c) */
+void async_save_gauge_field(char filename[]);
+void async_save_scalar_field(char filename[]);
+void async_save_ranlxd_state(char filename[]);
+void async_save_start(void);
+int async_save_poll(void);
+void async_save_wait(void);
+
 void read_input(input_record_t irec[], char *filename);
 void read_action(char *filename, integrator_par **ipp);
 
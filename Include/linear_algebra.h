@@ -38,4 +38,9 @@
 #undef _REAL
 #undef _COMPLEX
 
+/* block operations, double precision */
+void spinor_field_block_prod_local_f(double complex *res, spinor_field *s1, int n1, spinor_field *s2, int n2);
+void spinor_field_block_mul_add_assign_f(spinor_field *out, int n, spinor_field *in, int m, double complex *c);
+void spinor_field_block_mul_f(spinor_field *out, int n, spinor_field *in, int m, double complex *c);
+
 #endif
@@ -27,6 +27,17 @@
 void *amalloc(size_t size, int p);
 void afree(void *addr);
 
+/*
+ * Pool of the data buffers of the fields (field_pool.c), used by all the
+ * alloc_* and free_* functions below: released buffers are recycled by
+ * geometry type and size. pool_release gives the unused buffers back to
+ * the system, pool_report prints the high-water marks.
+ */
+void *pool_alloc(geometry_descriptor *type, size_t site_size, size_t nsites, unsigned int n);
+void pool_free(void *addr);
+void pool_release(void);
+void pool_report(void);
+
 void free_gfield(suNg_field *u);
 suNg_field *alloc_gfield(geometry_descriptor *type);
 void free_scalar_field(suNg_scalar_field *u);
@@ -37,11 +48,20 @@ void free_gfield_flt(suNg_field_flt *u);
 suNg_field_flt *alloc_gfield_flt(geometry_descriptor *type);
 void free_gfield_f_flt(suNf_field_flt *u);
 suNf_field_flt *alloc_gfield_f_flt(geometry_descriptor *type);
+void free_gfield_f_half(suNf_field_half *u);
+suNf_field_half *alloc_gfield_f_half(geometry_descriptor *type);
 void free_gtransf(suNg_field *u);
 suNg_field *alloc_gtransf(geometry_descriptor *type);
 void free_avfield(suNg_av_field *u);
 suNg_av_field *alloc_avfield(geometry_descriptor *type);
 
+#ifdef WITH_SIMD_LAYOUT
+void free_gfield_f_simd(suNf_field_simd *u);
+suNf_field_simd *alloc_gfield_f_simd(geometry_descriptor *type);
+void free_gfield_f_simd_flt(suNf_field_simd_flt *u);
+suNf_field_simd_flt *alloc_gfield_f_simd_flt(geometry_descriptor *type);
+#endif
+
 void free_clover_ldl(ldl_field *u);
 ldl_field *alloc_clover_ldl(geometry_descriptor* type);
 
@@ -62,6 +82,8 @@ void free_spinor_field_f(spinor_field *s);
 spinor_field *alloc_spinor_field_f(unsigned int n, geometry_descriptor *type);
 void free_spinor_field_f_flt(spinor_field_flt *s);
 spinor_field_flt *alloc_spinor_field_f_flt(unsigned int n, geometry_descriptor *type);
+void free_spinor_field_f_half(spinor_field_half *s);
+spinor_field_half *alloc_spinor_field_f_half(unsigned int n, geometry_descriptor *type);
 void free_sfield(scalar_field *s);
 scalar_field *alloc_sfield(unsigned int n, geometry_descriptor *type);
 
@@ -52,12 +52,19 @@ typedef struct {
 typedef struct {
 	double mass;
 	int mre_past;
+	int mre_share; /* chronological history shared in this group, 0 => private */
+	int mre_half; /* history in half precision */
+	int mg_nvec; /* multigrid null-space vectors, 0 => no multigrid */
+	int mg_block; /* multigrid aggregate size */
+	int defl_nev; /* deflated low modes, 0 => no deflation */
+	int defl_refine; /* Rayleigh-Ritz steps per change of the gauge field */
 	force_hmc_par fpar;
 	spinor_field *pf;
 } mon_hmc_par;
 
 typedef struct {
 	double mass;
+	int mixed_prec; /* forces with the mixed precision multi-shift CG */
 	rational_app ratio;
 	force_rhmc_par fpar;
 	spinor_field *pf;
@@ -67,6 +74,8 @@ typedef struct {
 	double mass;
 	double mu;
 	int mre_past;
+	int mre_share; /* chronological history shared in this group, 0 => private */
+	int mre_half; /* history in half precision */
 	force_hmc_par fpar;
 	spinor_field *pf;
 } mon_tm_par;
@@ -75,6 +84,12 @@ typedef struct {
 	double mass;
 	double dm;
 	int mre_past;
+	int mre_share; /* chronological history shared in this group, 0 => private */
+	int mre_half; /* history in half precision */
+	int mg_nvec; /* multigrid null-space vectors, 0 => no multigrid */
+	int mg_block; /* multigrid aggregate size */
+	int defl_nev; /* deflated low modes, 0 => no deflation */
+	int defl_refine; /* Rayleigh-Ritz steps per change of the gauge field */
 	force_hmc_par fpar;
 	spinor_field *pf;
 } mon_hasenbusch_par;
@@ -84,6 +99,8 @@ typedef struct {
 	double mu;
 	double dmu;
 	int mre_past;
+	int mre_share; /* chronological history shared in this group, 0 => private */
+	int mre_half; /* history in half precision */
 	force_hmc_par fpar;
 	spinor_field *pf;
 } mon_hasenbusch_tm_par;
@@ -135,5 +152,6 @@ struct _monomial* scalar_create(const monomial_data*);
 const monomial *add_mon(monomial_data*);
 const monomial *mon_n(int);
 int num_mon();
+const char *mon_type_name(mon_type type);
 
 #endif
@@ -110,6 +110,7 @@ void zero_even_or_odd_site_spinorfield(spinor_field *source, int nspinor, int eo
 
 void init_propagator_eo(int nm, double *m, double acc);
 void eig_init(int nev, int nevt, int kmax, int maxiter, double lbnd, double omega1, double omega2);
+void init_propagator_mg(int nvec, int *block);
 void free_propagator_eo();
 void calc_propagator_eo(spinor_field *psi, spinor_field *eta, int ndilute);
 void calc_propagator(spinor_field *psi, spinor_field *eta, int ndilute);
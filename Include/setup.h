@@ -15,4 +15,10 @@ int setup_process(int *argc, char ***argv);
 int finalize_process(void);
 void setup_gauge_fields();
 
+/* replicas.c */
+void init_replica_pool(int ntraj);
+int replica_pool_next();
+void replica_report(int ntraj, int nacc);
+void free_replica_pool();
+
 #endif
\ No newline at end of file
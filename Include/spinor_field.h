@@ -34,6 +34,68 @@ typedef struct
   double complex dn[NF * (2 * NF + 1)];
 } ldl_t;
 
+#ifdef WITH_SIMD_LAYOUT
+/* Site-blocked (AoSoA) storage of the represented links used by the
+ * vectorized hopping term: SIMD_VLEN consecutive site indices form one
+ * block and real/imaginary parts are stored lane-innermost.
+ */
+#ifndef SIMD_VLEN
+#define SIMD_VLEN 4
+#endif
+
+#if defined(REPR_ADJOINT) || defined(GAUGE_SON)
+typedef struct
+{
+  double re[NF * NF][SIMD_VLEN];
+} suNf_simd;
+
+typedef struct
+{
+  float re[NF * NF][SIMD_VLEN];
+} suNf_simd_flt;
+#else
+typedef struct
+{
+  double re[NF * NF][SIMD_VLEN];
+  double im[NF * NF][SIMD_VLEN];
+} suNf_simd;
+
+typedef struct
+{
+  float re[NF * NF][SIMD_VLEN];
+  float im[NF * NF][SIMD_VLEN];
+} suNf_simd_flt;
+#endif
+#endif /* WITH_SIMD_LAYOUT */
+
+#ifdef WITH_PROJECTED_HALO
+/* Two-component half-spinor exchanged in the projected halo of Dphi_ */
+typedef struct
+{
+  suNf_vector c[2];
+} suNf_hspinor;
+#endif
+
+/* 16-bit fixed-point storage (half precision) for the inner solvers:
+ * the components of a spinor are scaled by the largest one at the site,
+ * which is kept in norm; those of the represented links, which are bounded
+ * by 1, by HALF_MAX. The arithmetic is done in single precision.
+ */
+#define HALF_MAX 32767.f
+#define _HALF_SPINOR_LEN (sizeof(suNf_spinor_flt) / sizeof(float))
+#define _HALF_LINK_LEN (sizeof(suNf_flt) / sizeof(float))
+
+typedef struct
+{
+  float norm;
+  short c[_HALF_SPINOR_LEN];
+} suNf_spinor_half;
+
+typedef struct
+{
+  short c[_HALF_LINK_LEN];
+} suNf_half;
+
 #define _DECLARE_FIELD_STRUCT(_name, _type) \
   typedef struct _##_name                   \
   {                                         \
@@ -50,6 +112,8 @@ _DECLARE_FIELD_STRUCT(suNf_field, suNf);
 _DECLARE_FIELD_STRUCT(suNf_field_flt, suNf_flt);
 _DECLARE_FIELD_STRUCT(spinor_field, suNf_spinor);
 _DECLARE_FIELD_STRUCT(spinor_field_flt, suNf_spinor_flt);
+_DECLARE_FIELD_STRUCT(spinor_field_half, suNf_spinor_half);
+_DECLARE_FIELD_STRUCT(suNf_field_half, suNf_half);
 _DECLARE_FIELD_STRUCT(suNg_av_field, suNg_algebra_vector);
 _DECLARE_FIELD_STRUCT(scalar_field, double);
 _DECLARE_FIELD_STRUCT(ldl_field, ldl_t);
@@ -57,6 +121,10 @@ _DECLARE_FIELD_STRUCT(suNfc_field, suNfc);
 #if defined(GAUGE_SPN) && defined(REPR_FUNDAMENTAL)
 _DECLARE_FIELD_STRUCT(suNffull_field, suNffull);
 #endif
+#ifdef WITH_SIMD_LAYOUT
+_DECLARE_FIELD_STRUCT(suNf_field_simd, suNf_simd);
+_DECLARE_FIELD_STRUCT(suNf_field_simd_flt, suNf_simd_flt);
+#endif
 
 
 /* LOOPING MACRO */
@@ -100,6 +168,63 @@ _DECLARE_FIELD_STRUCT(suNffull_field, suNffull);
 #define _4FIELD_AT(s, i, mu) (((s)->ptr) + coord_to_index(i - (s)->type->master_shift, mu))
 #define _6FIELD_AT(s, i, mu) (((s)->ptr) + ((i - (s)->type->master_shift) * 6 + mu))
 
+#ifdef WITH_SIMD_LAYOUT
+/* the 8 links entering the hopping term at site i: mu=0..3 are U(i,mu),
+ * mu=4..7 are U(i-mu,mu) to be used as U^dagger */
+#define _SIMD_BLOCK(i) ((i) / SIMD_VLEN)
+#define _SIMD_LANE(i) ((i) % SIMD_VLEN)
+#define _8SIMD_FIELD_AT(s, i, mu) (((s)->ptr) + (_SIMD_BLOCK(i) * 8 + (mu)))
+#endif
+
 #define _SPINOR_PTR(s) _FIELD_AT(s, _spinor_for_is)
 
+/* conversion of one site between single and half precision */
+#define _spinor_flt2half(h, s)                                      \
+  do                                                                \
+  {                                                                 \
+    const float *_v = (const float *)&(s);                          \
+    float _m = 0.f, _k;                                             \
+    for (int _i = 0; _i < _HALF_SPINOR_LEN; _i++)                   \
+    {                                                               \
+      const float _a = (_v[_i] < 0.f) ? -_v[_i] : _v[_i];           \
+      if (_a > _m)                                                  \
+        _m = _a;                                                    \
+    }                                                               \
+    (h).norm = _m;                                                  \
+    _k = (_m > 0.f) ? HALF_MAX / _m : 0.f;                          \
+    for (int _i = 0; _i < _HALF_SPINOR_LEN; _i++)                   \
+    {                                                               \
+      const float _a = _k * _v[_i];                                 \
+      (h).c[_i] = (short)((_a < 0.f) ? _a - 0.5f : _a + 0.5f);      \
+    }                                                               \
+  } while (0)
+
+#define _spinor_half2flt(s, h)                                      \
+  do                                                                \
+  {                                                                 \
+    float *_v = (float *)&(s);                                      \
+    const float _k = (h).norm * (1.f / HALF_MAX);                   \
+    for (int _i = 0; _i < _HALF_SPINOR_LEN; _i++)                   \
+      _v[_i] = _k * (float)(h).c[_i];                               \
+  } while (0)
+
+#define _suNf_flt2half(h, u)                                        \
+  do                                                                \
+  {                                                                 \
+    const float *_v = (const float *)&(u);                          \
+    for (int _i = 0; _i < _HALF_LINK_LEN; _i++)                     \
+    {                                                               \
+      const float _a = HALF_MAX * _v[_i];                           \
+      (h).c[_i] = (short)((_a < 0.f) ? _a - 0.5f : _a + 0.5f);      \
+    }                                                               \
+  } while (0)
+
+#define _suNf_half2flt(u, h)                                        \
+  do                                                                \
+  {                                                                 \
+    float *_v = (float *)&(u);                                      \
+    for (int _i = 0; _i < _HALF_LINK_LEN; _i++)                     \
+      _v[_i] = (1.f / HALF_MAX) * (float)(h).c[_i];                 \
+  } while (0)
+
 #endif
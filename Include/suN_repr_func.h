@@ -0,0 +1,169 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica and Agostino Patella                     *   
+* All rights reserved.                                                      * 
+\***************************************************************************/
+
+#ifndef SUN_REPR_FUNC_H
+#define SUN_REPR_FUNC_H
+
+#if (NG!=3) 
+#error : Mismatch between NG and representation functions!
+#endif
+#if (NF!=3) 
+#error : Mismatch between NF and representation functions!
+#endif
+
+
+
+/*
+*   _FUND_NORM2 = C(FUND)
+*   _FUND_NORM2 = C(REPR)
+*/
+#define _FUND_NORM2 (+5.000000000000000e-01)
+#define _REPR_NORM2 (+5.000000000000000e-01)
+
+/*
+*	v COMPLEX matrix 3*3
+*	u complex matrix 3*3
+*	v is the representation of u, as element of SU(3)
+*/
+#define _group_represent(v,u) \
+	(v).c[0]= +creal((u).c[0])+I*(+cimag((u).c[0])); \
+	(v).c[1]= +creal((u).c[1])+I*(+cimag((u).c[1])); \
+	(v).c[2]= +creal((u).c[2])+I*(+cimag((u).c[2])); \
+	(v).c[3]= +creal((u).c[3])+I*(+cimag((u).c[3])); \
+	(v).c[4]= +creal((u).c[4])+I*(+cimag((u).c[4])); \
+	(v).c[5]= +creal((u).c[5])+I*(+cimag((u).c[5])); \
+	(v).c[6]= +creal((u).c[6])+I*(+cimag((u).c[6])); \
+	(v).c[7]= +creal((u).c[7])+I*(+cimag((u).c[7])); \
+	(v).c[8]= +creal((u).c[8])+I*(+cimag((u).c[8]));
+
+
+/*
+*	m COMPLEX matrix 3*3
+*	h real 8-vector
+*	m = sum(A) i*h(A)*rT(A)
+*/
+#define _algebra_represent(m,h) \
+	(m).c[0]= 0.0+I*(+5.000000000000000e-01*(h).c[3]+2.886751345948129e-01*(h).c[7]); \
+	(m).c[1]= -5.000000000000000e-01*(h).c[0]+I*(+5.000000000000000e-01*(h).c[2]); \
+	(m).c[2]= -5.000000000000000e-01*(h).c[1]+I*(+5.000000000000000e-01*(h).c[5]); \
+	(m).c[3]= +5.000000000000000e-01*(h).c[0]+I*(+5.000000000000000e-01*(h).c[2]); \
+	(m).c[4]= 0.0+I*(-5.000000000000000e-01*(h).c[3]+2.886751345948129e-01*(h).c[7]); \
+	(m).c[5]= -5.000000000000000e-01*(h).c[4]+I*(+5.000000000000000e-01*(h).c[6]); \
+	(m).c[6]= +5.000000000000000e-01*(h).c[1]+I*(+5.000000000000000e-01*(h).c[5]); \
+	(m).c[7]= +5.000000000000000e-01*(h).c[4]+I*(+5.000000000000000e-01*(h).c[6]); \
+	(m).c[8]= 0.0+I*(-5.773502691896257e-01*(h).c[7]);
+
+
+
+#ifndef WITH_QUATERNIONS
+
+/*
+*	h real 8-vector
+*	m COMPLEX matrix 3*3
+*	h(A) = -i*ReTr[rT(A).m]/C(r)
+*/
+#define _algebra_project(h,m) \
+	(h).c[0] = -creal((m).c[1])+creal((m).c[3]); \
+	(h).c[1] = -creal((m).c[2])+creal((m).c[6]); \
+	(h).c[2] = +cimag((m).c[1])+cimag((m).c[3]); \
+	(h).c[3] = -(-cimag((m).c[0])+cimag((m).c[4])); \
+	(h).c[4] = -creal((m).c[5])+creal((m).c[7]); \
+	(h).c[5] = +cimag((m).c[2])+cimag((m).c[6]); \
+	(h).c[6] = +cimag((m).c[5])+cimag((m).c[7]); \
+	(h).c[7] = +5.773502691896257e-01*cimag((m).c[0])+5.773502691896257e-01*cimag((m).c[4])-1.154700538379251e+00*cimag((m).c[8]);
+
+
+#define _algebra_project_FMAT(h,m) _algebra_project(h,m) 
+
+
+/*
+*	m COMPLEX matrix 3*3
+*	h real 8-vector
+*	m = sum(A) i*h(A)*T(A)
+*/
+#define _fund_algebra_represent(m,h) \
+	(m).c[0]= 0.0+I*(+5.000000000000000e-01*(h).c[3]+2.886751345948129e-01*(h).c[7]); \
+	(m).c[1]= -5.000000000000000e-01*(h).c[0]+I*(+5.000000000000000e-01*(h).c[2]); \
+	(m).c[2]= -5.000000000000000e-01*(h).c[1]+I*(+5.000000000000000e-01*(h).c[5]); \
+	(m).c[3]= +5.000000000000000e-01*(h).c[0]+I*(+5.000000000000000e-01*(h).c[2]); \
+	(m).c[4]= 0.0+I*(-5.000000000000000e-01*(h).c[3]+2.886751345948129e-01*(h).c[7]); \
+	(m).c[5]= -5.000000000000000e-01*(h).c[4]+I*(+5.000000000000000e-01*(h).c[6]); \
+	(m).c[6]= +5.000000000000000e-01*(h).c[1]+I*(+5.000000000000000e-01*(h).c[5]); \
+	(m).c[7]= +5.000000000000000e-01*(h).c[4]+I*(+5.000000000000000e-01*(h).c[6]); \
+	(m).c[8]= 0.0+I*(-5.773502691896257e-01*(h).c[7]);
+
+
+
+/*
+*	h real 8-vector
+*	m COMPLEX matrix 3*3
+*	h(A) = -i*ReTr[T(A).m]/C(FUND)
+*/
+#define _fund_algebra_project(h,m) \
+	(h).c[0] = -creal((m).c[1])+creal((m).c[3]); \
+	(h).c[1] = -creal((m).c[2])+creal((m).c[6]); \
+	(h).c[2] = +cimag((m).c[1])+cimag((m).c[3]); \
+	(h).c[3] = -(-cimag((m).c[0])+cimag((m).c[4])); \
+	(h).c[4] = -creal((m).c[5])+creal((m).c[7]); \
+	(h).c[5] = +cimag((m).c[2])+cimag((m).c[6]); \
+	(h).c[6] = +cimag((m).c[5])+cimag((m).c[7]); \
+	(h).c[7] = +5.773502691896257e-01*cimag((m).c[0])+5.773502691896257e-01*cimag((m).c[4])-1.154700538379251e+00*cimag((m).c[8]);
+
+
+
+#else
+
+/* QUATERNION CASE */
+/* there is no represented field in this case */
+
+/*
+*	h real 8-vector
+*	m COMPLEX matrix 3*3
+*	h(A) = -i*ReTr[T(A).m]/C(FUND)
+*/
+#define _fund_algebra_project(h,m) \
+	(h).c[0] = 2.*(m).c[2]; \
+	(h).c[1] = 2.*(m).c[1]; \
+	(h).c[2] = 2.*(m).c[3]
+
+/*
+*	h real 8-vector
+*	m COMPLEX matrix 3*3
+*	h(A) = -i*ReTr[rT(A).m]/C(r)
+*/
+#define _algebra_project(h,m) _fund_algebra_project(h,m)
+
+/*
+*	h real 8-vector
+*	m COMPLEX matrix 3*3
+*	h(A) = -i*ReTr[rT(A).m]/C(r)
+*/
+#define _algebra_project_FMAT(h,m) \
+	(h).c[0] = -creal((m).c[1])+creal((m).c[3]); \
+	(h).c[1] = -creal((m).c[2])+creal((m).c[6]); \
+	(h).c[2] = +cimag((m).c[1])+cimag((m).c[3]); \
+	(h).c[3] = -(-cimag((m).c[0])+cimag((m).c[4])); \
+	(h).c[4] = -creal((m).c[5])+creal((m).c[7]); \
+	(h).c[5] = +cimag((m).c[2])+cimag((m).c[6]); \
+	(h).c[6] = +cimag((m).c[5])+cimag((m).c[7]); \
+	(h).c[7] = +5.773502691896257e-01*cimag((m).c[0])+5.773502691896257e-01*cimag((m).c[4])-1.154700538379251e+00*cimag((m).c[8]);
+
+
+
+/*
+*	m COMPLEX matrix 3*3
+*	h real 8-vector
+*	m = sum(A) i*h(A)*T(A)
+*/
+#define _fund_algebra_represent(m,h) \
+	(m).c[2] = 0.5*(h).c[0]; \
+	(m).c[1] = 0.5*(h).c[1]; \
+	(m).c[3] = 0.5*(h).c[2]; \
+	(m).c[0] = 0.
+    
+
+#endif 
+
+#endif 
@@ -25,17 +25,55 @@ void set_max_mh_level(int max_lev);
 void update_hb_multilevel_gb_measure(int lev, double *beta, int nhb, int nor, int *ml_up, int *ml_skip, int nblockingstart, int nblockingsend, double *smear_val, cor_list *lcor);
 
 /* functions and structures for the MRE algorithm */
+struct _mre_history;
+
 typedef struct
 {
-	spinor_field *s[2];
-	int num[2];
+	struct _mre_history *h[2]; /* past solutions, possibly shared */
 	int max;
 	int init;
+	double prec;		/* precision of the inversions */
+	double guess_res2;	/* relative residual of the last guess */
+	int guess_cost;		/* operator applications of the last guess */
+	int nsolve;			/* inversions started from a guess */
+	double iter;		/* their iterations */
+	double zero_iter;	/* estimated iterations without the guess */
+	double guess_iter;	/* operator applications of the guesses */
 } mre_par;
 
+/*
+ * mre_init sets up a history of max past solutions, in half (half = 1) or
+ * single precision, shared with the other mre_par of the same share group
+ * if share != 0. mre_store is called after each inversion with its number of
+ * iterations, which is used to report the iterations saved by the guess.
+ */
 void mre_guess(mre_par *, int, spinor_field *, spinor_operator, spinor_field *);
-void mre_store(mre_par *, int, spinor_field *);
-void mre_init(mre_par *, int, double);
+void mre_store(mre_par *, int, spinor_field *, int);
+void mre_init(mre_par *, int, int, int, double);
+
+/*
+ * Low-mode deflation of the force solves (hmc_deflation.c).
+ * The nev lowest eigenvectors of H2 = (g5 D)^2 are computed with eva at the
+ * start of the trajectory (defl_reset) and refined with refine Rayleigh-Ritz
+ * steps each time the gauge field or the mass has changed.
+ * defl_solve has the interface of inverter_ptr and takes the defl_par from
+ * par->add_par: it solves D out = in, D being the operator D of D_update.c,
+ * as H2 out = D^dag in with a CG whose search directions are kept
+ * H2-orthogonal to the low modes (deflated CG).
+ */
+struct _defl_data;
+
+typedef struct _defl_par
+{
+	int nev; /* number of low modes */
+	int refine; /* Rayleigh-Ritz steps when the gauge field has changed */
+	struct _defl_data *data;
+} defl_par;
+
+void defl_init(defl_par *, int, int);
+void defl_free(defl_par *);
+void defl_reset(defl_par *);
+int defl_solve(mshift_par *par, spinor_operator M, spinor_field *in, spinor_field *out);
 
 typedef struct
 {
@@ -45,6 +83,7 @@ typedef struct
 	double mass;
 	rational_app *ratio;
 	double inv_err2;
+	int mixed; /* mixed precision multi-shift solver */
 	suNg_av_field **momenta;
 } force_rhmc_par;
 
@@ -60,6 +99,8 @@ typedef struct
 	double inv_err2, inv_err2_flt;
 	mre_par mpar;
 	int logdet;
+	mg_par *mg; /* multigrid solver, NULL => g5QMR */
+	defl_par *defl; /* deflated CG, NULL => no deflation */
 	suNg_av_field **momenta;
 } force_hmc_par;
 
@@ -145,6 +186,38 @@ typedef struct _integrator_par
 void leapfrog_multistep(double tlen, integrator_par *int_par);
 void O2MN_multistep(double tlen, integrator_par *int_par);
 void O4MN_multistep(double tlen, integrator_par *int_par);
+void FG_multistep(double tlen, integrator_par *int_par);
+void FG_pos_multistep(double tlen, integrator_par *int_par);
+
+/*
+ * Integrator tuner (update_mt.c).
+ * During the first tune_ntraj trajectories after init_ghmc, ghmc_tune_on is set
+ * and monomial_force calls ghmc_tune_force, which measures the force of each
+ * monomial and the time spent computing it. At the end of the window the step
+ * counts of the levels which minimize the time per accepted trajectory at the
+ * target acceptance are proposed, and applied if tune_apply is set.
+ */
+extern int ghmc_tune_on;
+void ghmc_tune_force(double dt, const monomial *m);
+
+/*
+ * Cost accounting of the HMC (hmc_cost.c).
+ * When cost_log is set, the time and the work counted in cost_cnt between
+ * hmc_cost_begin and hmc_cost_end are attributed to the monomial and the
+ * phase given to hmc_cost_end. At the end of each trajectory one JSON line
+ * with the totals and the breakdown per monomial is appended to cost_log.
+ */
+typedef enum
+{
+	COST_PF,	 /* pseudofermion generation */
+	COST_FORCE,	 /* forces */
+	COST_FIELD,	 /* field updates */
+	COST_ACTION, /* action at the end of the trajectory */
+	COST_NPHASE
+} cost_phase;
+
+void hmc_cost_begin();
+void hmc_cost_end(const monomial *m, cost_phase phase);
 
 typedef struct _ghmc_par
 {
@@ -166,12 +239,25 @@ typedef struct _ghmc_par
 	double SF_ct;
 	int SF_background;
 
+	/* integrator tuning */
+	int tune_ntraj;		/* trajectories of the warm-up window: 0 => no tuning */
+	double tune_acc;	/* target acceptance */
+	int tune_apply;		/* 1 => apply the proposed step counts, 0 => only log them */
+	char tune_log[256]; /* file to which the tuning records are appended: empty => none */
+
+	/* cost accounting */
+	char cost_log[256]; /* file to which the cost of each trajectory is appended: empty => none */
+
 } ghmc_par;
 
 void init_ghmc(ghmc_par *par);
 void free_ghmc();
 int update_ghmc();
 int reverse_update_ghmc();
+void init_hmc_cost(ghmc_par *par);
+void free_hmc_cost();
+void hmc_cost_trajectory_begin();
+void hmc_cost_trajectory_end(double deltaH, int accepted);
 
 /* stout smearing */
 void init_smearing(double, double);
@@ -94,16 +94,28 @@ void diag_hmat(suNg *hmat, double *dag);
 void assign_u2ud(void);
 void assign_ud2u(void);
 void assign_ud2u_f(void);
+void assign_ud2u_f_half(void);
+#ifdef WITH_SIMD_LAYOUT
+void assign_u_f2u_f_simd(void);
+void assign_u_f2u_f_simd_flt(void);
+#endif
 
 /* void assign_s2sd(int len, suNf_spinor *out, suNf_spinor_flt *in); */
 /* void assign_sd2s(int len, suNf_spinor_flt *out, suNf_spinor *in); */
 
 void assign_s2sd(spinor_field *out, spinor_field_flt *in);
 void assign_sd2s(spinor_field_flt *out, spinor_field *in);
+void assign_s2sh(spinor_field_half *out, spinor_field_flt *in);
+void assign_sh2s(spinor_field_flt *out, spinor_field_half *in);
+void assign_sd2sh(spinor_field_half *out, spinor_field *in);
+void assign_sh2sd(spinor_field *out, spinor_field_half *in);
 
 /* use power method to find max eigvalue of H2 */
 int max_H(spinor_operator H, geometry_descriptor *type, double *max);
 
+/* weighted sum of the represented links, changes whenever the gauge field does */
+double gauge_fingerprint(void);
+
 /* EVA preconditioning */
 typedef struct _eva_prec
 {
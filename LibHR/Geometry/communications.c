@@ -24,6 +24,7 @@ int gf_control = 0, sf_control = 0;
 
 void global_sum(double *d, int n) {
 #ifdef WITH_MPI
+  ++cost_cnt.reductions;
   int mpiret;
   (void)mpiret; // Remove warning of variable set but not used
   double pres[n];
@@ -61,8 +62,55 @@ void global_sum(double *d, int n) {
 #endif
 }
 
+/* Non-blocking global sum: d is summed in place over the processes and
+ * must not be accessed until global_sum_wait returns */
+void global_sum_start(double *d, int n, global_sum_request *req) {
+#ifdef WITH_MPI
+  ++cost_cnt.reductions;
+  int mpiret;
+  (void)mpiret; // Remove warning of variable set but not used
+
+  mpiret = MPI_Iallreduce(MPI_IN_PLACE, d, n, MPI_DOUBLE, MPI_SUM, GLB_COMM, req);
+
+#ifndef NDEBUG
+  if (mpiret != MPI_SUCCESS) {
+    char mesg[MPI_MAX_ERROR_STRING];
+    int mesglen;
+    MPI_Error_string(mpiret, mesg, &mesglen);
+    lprintf("MPI", 0, "ERROR: %s\n", mesg);
+    error(1, 1, "global_sum_start " __FILE__, "Cannot start global_sum");
+  }
+#endif
+#else
+  /* for non mpi do nothing */
+  *req = 0;
+#endif
+}
+
+void global_sum_wait(global_sum_request *req) {
+#ifdef WITH_MPI
+  int mpiret;
+  (void)mpiret; // Remove warning of variable set but not used
+
+  mpiret = MPI_Wait(req, MPI_STATUS_IGNORE);
+
+#ifndef NDEBUG
+  if (mpiret != MPI_SUCCESS) {
+    char mesg[MPI_MAX_ERROR_STRING];
+    int mesglen;
+    MPI_Error_string(mpiret, mesg, &mesglen);
+    lprintf("MPI", 0, "ERROR: %s\n", mesg);
+    error(1, 1, "global_sum_wait " __FILE__, "Cannot complete global_sum");
+  }
+#endif
+#else
+  (void)req;
+#endif
+}
+
 void global_sum_int(int *d, int n) {
 #ifdef WITH_MPI
+  ++cost_cnt.reductions;
   int mpiret;
   (void)mpiret; // Remove warning of variable set but not used
   int pres[n];
@@ -102,6 +150,7 @@ void global_sum_int(int *d, int n) {
 
 void global_max(double *d, int n) {
 #ifdef WITH_MPI
+  ++cost_cnt.reductions;
   int mpiret;
   (void)mpiret; // Remove warning of variable set but not used
   double pres[n];
@@ -385,7 +434,9 @@ void start_clover_force_sendrecv(suNf_field *gf)
   gf_control = 1;
 #endif
 
+  ++cost_cnt.halos;
   for (i = 0; i < (gd->nbuffers_gauge); ++i) {
+    cost_cnt.halo_bytes += (gd->sbuf_len[i]) * sizeof(suNf) * 6;
     /* send ith buffer */
     mpiret =
         MPI_Isend((double *)((gf->ptr) + 6 * gd->sbuf_start[i]), /* buffer */
@@ -499,7 +550,9 @@ void start_gf_sendrecv(suNg_field *gf) {
   gf_control = 1;
 #endif
 
+  ++cost_cnt.halos;
   for (i = 0; i < (gd->nbuffers_gauge); ++i) {
+    cost_cnt.halo_bytes += (gd->sbuf_len[i]) * sizeof(suNg) * 4;
     /* send ith buffer */
     mpiret =
         MPI_Isend((double *)((gf->ptr) + 4 * gd->sbuf_start[i]), /* buffer */
@@ -613,7 +666,9 @@ void start_sf_sendrecv(spinor_field *sf) {
   sf_control = 1;
 #endif
 
+  ++cost_cnt.halos;
   for (i = 0; i < (gd->nbuffers_spinor); ++i) {
+    cost_cnt.halo_bytes += (gd->sbuf_len[i]) * sizeof(suNf_spinor);
     /* send ith buffer */
     mpiret = MPI_Isend(
         (double *)((sf->ptr) + (gd->sbuf_start[i]) -
@@ -662,6 +717,131 @@ void start_sf_sendrecv(spinor_field *sf) {
 #endif /* WITH_MPI */
 }
 
+/*
+ * Halo exchange of a block of n spinor fields with a single message per
+ * buffer. The fields must be defined on the same geometry and be equally
+ * spaced in memory, as the fields returned by alloc_spinor_field_f: the
+ * buffers of the n fields are then described by one strided datatype.
+ * Otherwise the fields are exchanged one by one.
+ * The requests of the first field are used for the whole block.
+ */
+#ifdef WITH_MPI
+static int sf_block_stride(spinor_field *sf, int n, MPI_Aint *stride) {
+  int k;
+
+  if (n < 2) return 0;
+  *stride = (char *)(sf[1].ptr) - (char *)(sf[0].ptr);
+  for (k = 1; k < n; ++k) {
+    if (sf[k].type != sf[0].type)
+      return 0;
+    if ((char *)(sf[k].ptr) - (char *)(sf[0].ptr) != k * (*stride))
+      return 0;
+  }
+  return 1;
+}
+#endif
+
+void complete_sf_sendrecv_block(spinor_field *sf, int n) {
+#ifdef WITH_MPI
+  int k;
+  MPI_Aint stride;
+
+  if (!sf_block_stride(sf, n, &stride)) {
+    for (k = 0; k < n; ++k)
+      complete_sf_sendrecv(&sf[k]);
+    return;
+  }
+  complete_sf_sendrecv(sf);
+#endif /* WITH_MPI */
+}
+
+void start_sf_sendrecv_block(spinor_field *sf, int n) {
+#ifdef WITH_MPI
+  int i, k, mpiret;
+  (void)mpiret; // Remove warning of variable set but not used
+  geometry_descriptor *gd = sf->type;
+  MPI_Aint stride;
+  MPI_Datatype block_type;
+
+  if (!sf_block_stride(sf, n, &stride)) {
+    for (k = 0; k < n; ++k) {
+#ifdef MPI_TIMING
+      sf_control = 0; /* only the last field is timed */
+#endif
+      start_sf_sendrecv(&sf[k]);
+    }
+    return;
+  }
+
+  complete_sf_sendrecv(sf);
+
+  /* fill send buffers */
+  for (k = 0; k < n; ++k)
+    sync_spinor_field(&sf[k]);
+#ifdef MPI_TIMING
+  error(sf_control > 0, 1, "start_sf_sendrecv_block " __FILE__,
+        "Multiple send without receive");
+  gettimeofday(&sfstart, 0);
+  sf_control = 1;
+#endif
+
+  ++cost_cnt.halos;
+  for (i = 0; i < (gd->nbuffers_spinor); ++i) {
+    cost_cnt.halo_bytes += n * (gd->sbuf_len[i]) * sizeof(suNf_spinor);
+    /* send ith buffer of the n fields */
+    MPI_Type_create_hvector(n, (gd->sbuf_len[i]) * (sizeof(suNf_spinor) / sizeof(double)),
+                            stride, MPI_DOUBLE, &block_type);
+    MPI_Type_commit(&block_type);
+    mpiret = MPI_Isend(
+        (double *)((sf->ptr) + (gd->sbuf_start[i]) -
+                   (gd->master_shift)), /* buffer */
+        1,                              /* one block */
+        block_type,                     /* n strided buffers */
+        gd->sbuf_to_proc[i],            /* cid of destination */
+        i,                              /* tag of communication */
+        cart_comm,                      /* use the cartesian communicator */
+        &(sf->comm_req[2 * i])          /* handle to communication request */
+    );
+    MPI_Type_free(&block_type);
+#ifndef NDEBUG
+    if (mpiret != MPI_SUCCESS) {
+      char mesg[MPI_MAX_ERROR_STRING];
+      int mesglen;
+      MPI_Error_string(mpiret, mesg, &mesglen);
+      lprintf("MPI", 0, "ERROR: %s\n", mesg);
+      error(1, 1, "start_sf_sendrecv_block " __FILE__, "Cannot start send buffer");
+    }
+#endif
+
+    /* receive ith buffer of the n fields */
+    MPI_Type_create_hvector(n, (gd->rbuf_len[i]) * (sizeof(suNf_spinor) / sizeof(double)),
+                            stride, MPI_DOUBLE, &block_type);
+    MPI_Type_commit(&block_type);
+    mpiret = MPI_Irecv(
+        (double *)((sf->ptr) + (gd->rbuf_start[i]) -
+                   (gd->master_shift)), /* buffer */
+        1,                              /* one block */
+        block_type,                     /* n strided buffers */
+        gd->rbuf_from_proc[i],          /* cid of origin */
+        i,                              /* tag of communication */
+        cart_comm,                      /* use the cartesian communicator */
+        &(sf->comm_req[2 * i + 1])      /* handle to communication request */
+    );
+    MPI_Type_free(&block_type);
+#ifndef NDEBUG
+    if (mpiret != MPI_SUCCESS) {
+      char mesg[MPI_MAX_ERROR_STRING];
+      int mesglen;
+      MPI_Error_string(mpiret, mesg, &mesglen);
+      lprintf("MPI", 0, "ERROR: %s\n", mesg);
+      error(1, 1, "start_sf_sendrecv_block " __FILE__, "Cannot start receive buffer");
+    }
+#endif
+  }
+
+#endif /* WITH_MPI */
+}
+
 void complete_gt_sendrecv(suNg_field *gf) {
 #ifdef WITH_MPI
   int mpiret;
@@ -709,7 +889,9 @@ void start_gt_sendrecv(suNg_field *gf) {
   /* fill send buffers */
   sync_gauge_transf(gf);
 
+  ++cost_cnt.halos;
   for (i = 0; i < (gd->nbuffers_gauge); ++i) {
+    cost_cnt.halo_bytes += (gd->sbuf_len[i]) * sizeof(suNg);
     /* send ith buffer */
     mpiret =
         MPI_Isend((double *)((gf->ptr) + gd->sbuf_start[i]), /* buffer */
@@ -820,7 +1002,9 @@ void start_sc_sendrecv(suNg_scalar_field *sf) {
   sf_control = 1;
 #endif
 
+  ++cost_cnt.halos;
   for (i = 0; i < (gd->nbuffers_spinor); ++i) {
+    cost_cnt.halo_bytes += (gd->sbuf_len[i]) * sizeof(suNg_vector);
     /* send ith buffer */
     mpiret = MPI_Isend(
         (double *)((sf->ptr) + (gd->sbuf_start[i]) -
@@ -19,8 +19,9 @@
 #include "logger.h"
 
 #ifdef MPI_TIMING
-struct timeval gfstart, gfend, gfetime,sfstart, sfend, sfetime;
-int gf_control=0,sf_control=0;
+/* defined in communications.c */
+extern struct timeval gfstart, gfend, gfetime,sfstart, sfend, sfetime;
+extern int gf_control,sf_control;
 #endif
 
 
@@ -45,6 +46,14 @@ static void sync_spinor_field_flt(spinor_field_flt *p) {
   }
 }
 
+static void sync_spinor_field_half(spinor_field_half *p) {
+  geometry_descriptor *gd = p->type;
+
+  for(int i=0; i<gd->ncopies_spinor; ++i) {
+    memcpy((p->ptr+gd->copy_to[i]-gd->master_shift),(p->ptr+gd->copy_from[i]-gd->master_shift),(gd->copy_len[i])*sizeof(*(p->ptr)));
+  }
+}
+
 static void sync_gauge_field_flt(suNg_field_flt *gf) {
   int i;
   geometry_descriptor *gd=gf->type;
@@ -129,7 +138,9 @@ void start_gf_sendrecv_flt(suNg_field_flt *gf) {
   gf_control=1;
 #endif
 
+  ++cost_cnt.halos;
   for (i=0; i<(gd->nbuffers_gauge); ++i) {
+    cost_cnt.halo_bytes += (gd->sbuf_len[i])*sizeof(suNg_flt)*4;
     /* send ith buffer */
     mpiret=MPI_Isend((float*)((gf->ptr)+4*gd->sbuf_start[i]), /* buffer */
         (gd->sbuf_len[i])*sizeof(suNg_flt)/sizeof(float)*4, /* lenght in units of flaots */
@@ -242,7 +253,9 @@ void start_sf_sendrecv_flt(spinor_field_flt *sf) {
 #endif
 
   nreq=0;
+  ++cost_cnt.halos;
   for (i=0; i<(gd->nbuffers_spinor); ++i) {
+    cost_cnt.halo_bytes += (gd->sbuf_len[i])*sizeof(suNf_spinor_flt);
 
     /* send ith buffer */
     mpiret=MPI_Isend((float*)((sf->ptr)+(gd->sbuf_start[i])-(gd->master_shift)), /* buffer */
@@ -289,3 +302,88 @@ void start_sf_sendrecv_flt(spinor_field_flt *sf) {
 #endif /* WITH_MPI */
 }
 
+
+/* half precision spinors: the sites are sent as raw bytes */
+void complete_sf_sendrecv_half(spinor_field_half *sf) {
+#ifdef WITH_MPI
+  int mpiret; (void)mpiret; // Remove warning of variable set but not used
+  int nreq=2*sf->type->nbuffers_spinor;
+
+  if(nreq>0) {
+    MPI_Status status[nreq];
+
+    mpiret=MPI_Waitall(nreq, sf->comm_req, status);
+
+#ifndef NDEBUG
+    if (mpiret != MPI_SUCCESS) {
+      char mesg[MPI_MAX_ERROR_STRING];
+      int mesglen;
+      MPI_Error_string(mpiret,mesg,&mesglen);
+      lprintf("MPI",0,"ERROR: %s\n",mesg);
+      error(1,1,"complete_sf_sendrecv_half" __FILE__,"Cannot complete communications");
+    }
+#endif
+  }
+#endif /* WITH_MPI */
+}
+
+
+void start_sf_sendrecv_half(spinor_field_half *sf) {
+#ifdef WITH_MPI
+  int i, mpiret, nreq; (void)mpiret; // Remove warning of variable set but not used
+  geometry_descriptor *gd=sf->type;
+
+  complete_sf_sendrecv_half(sf);
+
+  /* fill send buffers */
+  sync_spinor_field_half(sf);
+
+  nreq=0;
+  ++cost_cnt.halos;
+  for (i=0; i<(gd->nbuffers_spinor); ++i) {
+    cost_cnt.halo_bytes += (gd->sbuf_len[i])*sizeof(suNf_spinor_half);
+
+    /* send ith buffer */
+    mpiret=MPI_Isend((char*)((sf->ptr)+(gd->sbuf_start[i])-(gd->master_shift)), /* buffer */
+        (gd->sbuf_len[i])*sizeof(suNf_spinor_half), /* lenght in units of bytes */
+        MPI_BYTE, /* basic datatype */
+        gd->sbuf_to_proc[i], /* cid of destination */
+        i, /* tag of communication */
+        cart_comm, /* use the cartesian communicator */
+        &(sf->comm_req[nreq]) /* handle to communication request */
+        );
+    nreq++;
+#ifndef NDEBUG
+    if (mpiret != MPI_SUCCESS) {
+      char mesg[MPI_MAX_ERROR_STRING];
+      int mesglen;
+      MPI_Error_string(mpiret,mesg,&mesglen);
+      lprintf("MPI",0,"ERROR: %s\n",mesg);
+      error(1,1,"start_sf_sendrecv_half" __FILE__,"Cannot start send buffer");
+    }
+#endif
+
+    /* receive ith buffer */
+    mpiret=MPI_Irecv((char*)((sf->ptr)+(gd->rbuf_start[i])-(gd->master_shift)), /* buffer */
+        (gd->rbuf_len[i])*sizeof(suNf_spinor_half), /* lenght in units of bytes */
+        MPI_BYTE, /* basic datatype */
+        gd->rbuf_from_proc[i], /* cid of origin */
+        i, /* tag of communication */
+        cart_comm, /* use the cartesian communicator */
+        &(sf->comm_req[nreq]) /* handle to communication request */
+        );
+    nreq++;
+#ifndef NDEBUG
+    if (mpiret != MPI_SUCCESS) {
+      char mesg[MPI_MAX_ERROR_STRING];
+      int mesglen;
+      MPI_Error_string(mpiret,mesg,&mesglen);
+      lprintf("MPI",0,"ERROR: %s\n",mesg);
+      error(1,1,"start_sf_sendrecv_half" __FILE__,"Cannot start receive buffer");
+    }
+#endif
+
+  }
+
+#endif /* WITH_MPI */
+}
@@ -0,0 +1,228 @@
+/***************************************************************************\
+ * Copyright (c) 2008, Claudio Pica                                          *
+ * All rights reserved.                                                      *
+ \***************************************************************************/
+
+/*******************************************************************************
+ *
+ * File communications_overlap.c
+ *
+ * Scheduling of the boundary pieces of the Dirac operator while the halo
+ * exchange is in flight. The OpenMP master thread drives the MPI progress
+ * with MPI_Testsome on the requests of the input field and publishes the
+ * boundary pieces whose faces have all arrived; the other threads compute
+ * the inner sites and then consume the ready pieces in order of arrival.
+ * Only the master thread calls MPI, as required by MPI_THREAD_FUNNELED.
+ *
+ *******************************************************************************/
+
+#include "communications.h"
+#include "error.h"
+#include "geometry.h"
+#include "global.h"
+#include "logger.h"
+#include "spinor_field.h"
+#include "utils.h"
+#include <stdlib.h>
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+#ifdef WITH_COMM_OVERLAP
+
+static sf_overlap overlap[3] = {{NULL}, {NULL}, {NULL}};
+
+static int timeval_later(struct timeval *x, struct timeval *y)
+{
+  return (x->tv_sec > y->tv_sec) || (x->tv_sec == y->tv_sec && x->tv_usec > y->tv_usec);
+}
+
+/* bit i of mask[ip] is set if piece ip of out uses the halo received in buffer i of in */
+static void init_overlap(sf_overlap *ov, geometry_descriptor *out_type, geometry_descriptor *in_type)
+{
+  int *face;
+  const int size = glattice.gsize_gauge;
+
+  ov->out_type = out_type;
+  ov->in_type = in_type;
+  ov->nfaces = in_type->nbuffers_spinor;
+  ov->npieces = out_type->local_master_pieces - out_type->inner_master_pieces;
+  error(ov->nfaces > 8 * (int)sizeof(unsigned int), 1, "init_overlap [communications_overlap.c]",
+        "Too many communication buffers");
+
+  ov->mask = malloc((2 * ov->npieces + 1) * sizeof(unsigned int));
+  ov->order = malloc((ov->npieces + 1) * sizeof(int));
+  ov->tface = malloc((ov->nfaces + 1) * sizeof(struct timeval));
+  face = malloc(size * sizeof(int));
+  error(ov->mask == NULL || ov->order == NULL || ov->tface == NULL || face == NULL, 1,
+        "init_overlap [communications_overlap.c]", "Cannot allocate memory");
+  ov->queued = ov->mask + ov->npieces;
+
+  for (int ix = 0; ix < size; ix++)
+    face[ix] = -1;
+  for (int i = 0; i < ov->nfaces; i++)
+    for (int k = 0; k < in_type->rbuf_len[i]; k++)
+      face[in_type->rbuf_start[i] + k] = i;
+
+  for (int n = 0; n < ov->npieces; n++)
+  {
+    const int ip = out_type->inner_master_pieces + n;
+    ov->mask[n] = 0;
+    for (int ix = out_type->master_start[ip]; ix <= out_type->master_end[ip]; ix++)
+      for (int mu = 0; mu < 4; mu++)
+      {
+        if (face[iup(ix, mu)] >= 0)
+          ov->mask[n] |= 1u << face[iup(ix, mu)];
+        if (face[idn(ix, mu)] >= 0)
+          ov->mask[n] |= 1u << face[idn(ix, mu)];
+      }
+  }
+  free(face);
+}
+
+sf_overlap *sf_overlap_start(geometry_descriptor *out_type, geometry_descriptor *in_type, MPI_Request *req)
+{
+  sf_overlap *ov;
+
+  if (out_type == &glattice)
+    ov = &overlap[0];
+  else if (out_type == &glat_even)
+    ov = &overlap[1];
+  else if (out_type == &glat_odd)
+    ov = &overlap[2];
+  else
+  {
+    error(1, 1, "sf_overlap_start [communications_overlap.c]",
+          "Overlap only available for glattice, glat_even and glat_odd");
+    return NULL;
+  }
+  if (ov->out_type == NULL)
+    init_overlap(ov, out_type, in_type);
+  error(ov->in_type != in_type, 1, "sf_overlap_start [communications_overlap.c]",
+        "Spinors don't match");
+
+  ov->req = req;
+  ov->arrived = 0;
+  ov->nready = 0;
+  gettimeofday(&ov->tstart, 0);
+  ov->tinner = ov->tstart;
+
+  /* pieces not touching the halo are ready from the start */
+  for (int n = 0; n < ov->npieces; n++)
+  {
+    ov->queued[n] = (ov->mask[n] == 0);
+    if (ov->queued[n])
+      ov->order[ov->nready++] = out_type->inner_master_pieces + n;
+  }
+
+  return ov;
+}
+
+/* master thread only: test the pending requests once and queue the ready pieces */
+static void overlap_test(sf_overlap *ov)
+{
+  int nreq = 2 * ov->nfaces, ndone, nready = ov->nready;
+  int done[nreq];
+  MPI_Status status[nreq];
+  struct timeval now;
+
+  if (nreq == 0 || nready == ov->npieces)
+    return;
+
+  MPI_Testsome(nreq, ov->req, &ndone, done, status);
+  if (ndone == MPI_UNDEFINED || ndone == 0)
+    return;
+
+  gettimeofday(&now, 0);
+  for (int k = 0; k < ndone; k++)
+  {
+    if (done[k] % 2 == 1)
+    {
+      ov->arrived |= 1u << (done[k] / 2);
+      ov->tface[done[k] / 2] = now;
+    }
+  }
+
+  for (int n = 0; n < ov->npieces; n++)
+  {
+    if (!ov->queued[n] && (ov->mask[n] & ~ov->arrived) == 0)
+    {
+      ov->queued[n] = 1;
+      ov->order[nready++] = ov->out_type->inner_master_pieces + n;
+    }
+  }
+
+  _OMP_PRAGMA(flush)
+  _OMP_PRAGMA(atomic write)
+  ov->nready = nready;
+}
+
+void sf_overlap_progress(sf_overlap *ov)
+{
+  int nready;
+  do
+  {
+    overlap_test(ov);
+    _OMP_PRAGMA(atomic read)
+    nready = ov->nready;
+  } while (nready < ov->npieces);
+}
+
+int sf_overlap_next_piece(sf_overlap *ov, int k)
+{
+  int nready;
+#ifdef _OPENMP
+  const int master = (omp_get_thread_num() == 0);
+#else
+  const int master = 1;
+#endif
+  while (1)
+  {
+    _OMP_PRAGMA(atomic read)
+    nready = ov->nready;
+    if (nready > k)
+      break;
+    if (master)
+      overlap_test(ov);
+  }
+  _OMP_PRAGMA(flush)
+  return ov->order[k];
+}
+
+void sf_overlap_inner_done(sf_overlap *ov)
+{
+  struct timeval now;
+  gettimeofday(&now, 0);
+  _OMP_PRAGMA(critical(sf_overlap_inner))
+  {
+    if (timeval_later(&now, &ov->tinner))
+      ov->tinner = now;
+  }
+}
+
+void sf_overlap_end(sf_overlap *ov)
+{
+#ifdef MPI_TIMING
+  struct timeval inner, arrival, exposed;
+  timeval_subtract(&inner, &ov->tinner, &ov->tstart);
+  for (int i = 0; i < ov->nfaces; i++)
+  {
+    if (!(ov->arrived & (1u << i)))
+      continue;
+    timeval_subtract(&arrival, &ov->tface[i], &ov->tstart);
+    if (timeval_later(&ov->tface[i], &ov->tinner))
+      timeval_subtract(&exposed, &ov->tface[i], &ov->tinner);
+    else
+      exposed.tv_sec = exposed.tv_usec = 0;
+    lprintf("MPI TIMING", 0,
+            "overlap face %d from %d: arrival %ld usec, inner %ld usec, exposed %ld usec\n",
+            i, ov->in_type->rbuf_from_proc[i],
+            arrival.tv_sec * 1000000 + arrival.tv_usec,
+            inner.tv_sec * 1000000 + inner.tv_usec,
+            exposed.tv_sec * 1000000 + exposed.tv_usec);
+  }
+#endif
+  ov->req = NULL;
+}
+
+#endif /* WITH_COMM_OVERLAP */
@@ -0,0 +1,361 @@
+/***************************************************************************\
+ * Copyright (c) 2008, Claudio Pica                                          *
+ * All rights reserved.                                                      *
+ \***************************************************************************/
+
+/*******************************************************************************
+ *
+ * File communications_proj.c
+ *
+ * Spin-projected halo exchange for the hopping term of the Wilson-Dirac
+ * operator. Each border site is used by the neighbouring process in a
+ * single hopping direction, where only the (1 -/+ gamma_mu) projection of
+ * the spinor enters. The sender therefore packs two-component half-spinors
+ * into contiguous buffers, multiplying them by U^dagger(x,mu) for the
+ * backward directions, and the receiver reconstructs the spinor inside
+ * the hopping kernel (see Update/Dphi_proj.c).
+ * This halves the volume of the spinor communications.
+ *
+ *******************************************************************************/
+
+#include "communications.h"
+#include "error.h"
+#include "geometry.h"
+#include "global.h"
+#include "logger.h"
+#include "memory.h"
+#include "spinor_field.h"
+#include "suN.h"
+#include "utils.h"
+#include <stdlib.h>
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+#ifdef WITH_PROJECTED_HALO
+
+typedef struct
+{
+  geometry_descriptor *gd;
+  int nbuf;
+  int *dir;         /* hopping direction served by buffer i: mu for x+mu, 4+mu for x-mu */
+  int *soff, *roff; /* offsets of buffer i in sbuf and rbuf */
+  int *ssite;       /* master site packed in each entry of sbuf */
+  int *slot;        /* offset in rbuf of each halo site, -1 otherwise */
+  suNf_hspinor *sbuf, *rbuf;
+  int pending;
+} proj_halo_data;
+
+static proj_halo_data proj_halo[3] = {{NULL}, {NULL}, {NULL}};
+
+#ifdef MPI_TIMING
+static struct timeval pstart, pend, petime;
+#endif
+
+/* master site whose copy is stored at index ix of the field */
+static int copy_source(geometry_descriptor *gd, int ix)
+{
+  for (int n = 0; n <= gd->ncopies_spinor; n++)
+  {
+    int found = 0;
+    for (int i = 0; i < gd->ncopies_spinor; i++)
+    {
+      if (ix >= gd->copy_to[i] && ix < gd->copy_to[i] + gd->copy_len[i])
+      {
+        ix = gd->copy_from[i] + (ix - gd->copy_to[i]);
+        found = 1;
+        break;
+      }
+    }
+    if (!found)
+      return ix;
+  }
+  error(1, 1, "copy_source [communications_proj.c]", "Circular copy list");
+  return -1;
+}
+
+static void init_proj_halo(proj_halo_data *ph, geometry_descriptor *gd)
+{
+  int *hop, ns = 0, nr = 0;
+  const int size = glattice.gsize_gauge;
+
+  ph->gd = gd;
+  ph->nbuf = gd->nbuffers_spinor;
+  ph->dir = malloc((3 * ph->nbuf + 1) * sizeof(int));
+  error(ph->dir == NULL, 1, "init_proj_halo [communications_proj.c]", "Cannot allocate memory");
+  ph->soff = ph->dir + ph->nbuf;
+  ph->roff = ph->soff + ph->nbuf + 1;
+  ph->slot = malloc(size * sizeof(int));
+  hop = malloc(size * sizeof(int));
+  error(ph->slot == NULL || hop == NULL, 1, "init_proj_halo [communications_proj.c]",
+        "Cannot allocate memory");
+
+  /* direction in which each site is reached from the local master sites */
+  for (int ix = 0; ix < size; ix++)
+  {
+    hop[ix] = -1;
+    ph->slot[ix] = -1;
+  }
+  for (int ip = 0; ip < glattice.local_master_pieces; ip++)
+    for (int ix = glattice.master_start[ip]; ix <= glattice.master_end[ip]; ix++)
+      for (int mu = 0; mu < 4; mu++)
+      {
+        const int iy[2] = {iup(ix, mu), idn(ix, mu)};
+        for (int k = 0; k < 2; k++)
+          hop[iy[k]] = (hop[iy[k]] == -1 || hop[iy[k]] == mu + 4 * k) ? mu + 4 * k : -2;
+      }
+
+  /* every buffer serves a single direction; the geometry is the same on
+   * all processes, so the send buffer i is used by the receiver in the
+   * direction of the local receive buffer i */
+  for (int i = 0; i < ph->nbuf; i++)
+  {
+    error(gd->sbuf_len[i] != gd->rbuf_len[i], 1, "init_proj_halo [communications_proj.c]",
+          "Send and receive buffers of different length");
+    ph->dir[i] = hop[gd->rbuf_start[i]];
+    for (int k = 0; k < gd->rbuf_len[i]; k++)
+    {
+      const int iy = gd->rbuf_start[i] + k;
+      error(hop[iy] < 0 || hop[iy] != ph->dir[i], 1, "init_proj_halo [communications_proj.c]",
+            "Halo buffer not associated to a single hopping direction");
+      ph->slot[iy] = nr + k;
+    }
+    ph->soff[i] = ns;
+    ph->roff[i] = nr;
+    ns += gd->sbuf_len[i];
+    nr += gd->rbuf_len[i];
+  }
+  ph->soff[ph->nbuf] = ns;
+  free(hop);
+
+  ph->ssite = malloc((ns + 1) * sizeof(int));
+  ph->sbuf = amalloc((ns + nr + 1) * sizeof(suNf_hspinor), ALIGN);
+  error(ph->ssite == NULL || ph->sbuf == NULL, 1, "init_proj_halo [communications_proj.c]",
+        "Cannot allocate memory");
+  ph->rbuf = ph->sbuf + ns;
+
+  for (int i = 0; i < ph->nbuf; i++)
+    for (int k = 0; k < gd->sbuf_len[i]; k++)
+      ph->ssite[ph->soff[i] + k] = copy_source(gd, gd->sbuf_start[i] + k);
+
+  ph->pending = 0;
+
+  lprintf("COMM", 50, "Projected halo: %d buffers, %d sites sent, %d sites received\n",
+          ph->nbuf, ns, nr);
+}
+
+static proj_halo_data *get_proj_halo(geometry_descriptor *gd)
+{
+  int k;
+  if (gd == &glattice)
+    k = 0;
+  else if (gd == &glat_even)
+    k = 1;
+  else if (gd == &glat_odd)
+    k = 2;
+  else
+  {
+    error(1, 1, "get_proj_halo [communications_proj.c]",
+          "Projected halo only available for glattice, glat_even and glat_odd");
+    return NULL;
+  }
+  if (proj_halo[k].gd == NULL)
+    init_proj_halo(&proj_halo[k], gd);
+  return &proj_halo[k];
+}
+
+void sf_proj_halo(geometry_descriptor *gd, int **slot, suNf_hspinor **hbuf)
+{
+  proj_halo_data *ph = get_proj_halo(gd);
+  *slot = ph->slot;
+  *hbuf = ph->rbuf;
+}
+
+/* half-spinor of site ix as needed by the receiver in direction dir.
+ * The projections match the ones in Dphi_ */
+static void project_site(suNf_hspinor *h, suNf_spinor *s, int dir, int ix)
+{
+  suNf_vector psi, psi2;
+
+  switch (dir)
+  {
+  case 0:
+    _vector_add_f(h->c[0], s->c[0], s->c[2]);
+    _vector_add_f(h->c[1], s->c[1], s->c[3]);
+    return;
+  case 1:
+    _vector_i_add_f(h->c[0], s->c[0], s->c[3]);
+    _vector_i_add_f(h->c[1], s->c[1], s->c[2]);
+    return;
+  case 2:
+    _vector_add_f(h->c[0], s->c[0], s->c[3]);
+    _vector_sub_f(h->c[1], s->c[1], s->c[2]);
+    return;
+  case 3:
+    _vector_i_add_f(h->c[0], s->c[0], s->c[2]);
+    _vector_i_sub_f(h->c[1], s->c[1], s->c[3]);
+    return;
+  case 4:
+    _vector_sub_f(psi, s->c[0], s->c[2]);
+    _vector_sub_f(psi2, s->c[1], s->c[3]);
+    break;
+  case 5:
+    _vector_i_sub_f(psi, s->c[0], s->c[3]);
+    _vector_i_sub_f(psi2, s->c[1], s->c[2]);
+    break;
+  case 6:
+    _vector_sub_f(psi, s->c[0], s->c[3]);
+    _vector_add_f(psi2, s->c[1], s->c[2]);
+    break;
+  case 7:
+    _vector_i_sub_f(psi, s->c[0], s->c[2]);
+    _vector_i_add_f(psi2, s->c[1], s->c[3]);
+    break;
+  default:
+    error(1, 1, "project_site [communications_proj.c]", "Invalid direction");
+    return;
+  }
+
+  /* backward directions: the link U(x,mu) is local to the sender */
+  suNf *u = pu_gauge_f(ix, dir - 4);
+  _suNf_inverse_multiply(h->c[0], *u, psi);
+  _suNf_inverse_multiply(h->c[1], *u, psi2);
+}
+
+void complete_sf_sendrecv_proj(spinor_field *sf)
+{
+#ifdef WITH_MPI
+  int mpiret;
+  (void)mpiret; // Remove warning of variable set but not used
+  proj_halo_data *ph = get_proj_halo(sf->type);
+  int nreq = 2 * ph->nbuf;
+
+  if (!ph->pending)
+    return;
+
+  if (nreq > 0)
+  {
+    MPI_Status status[nreq];
+
+    mpiret = MPI_Waitall(nreq, sf->comm_req, status);
+
+#ifndef NDEBUG
+    if (mpiret != MPI_SUCCESS)
+    {
+      char mesg[MPI_MAX_ERROR_STRING];
+      int mesglen, k;
+      MPI_Error_string(mpiret, mesg, &mesglen);
+      lprintf("MPI", 0, "ERROR: %s\n", mesg);
+      for (k = 0; k < nreq; ++k)
+      {
+        if (status[k].MPI_ERROR != MPI_SUCCESS)
+        {
+          MPI_Error_string(status[k].MPI_ERROR, mesg, &mesglen);
+          lprintf("MPI", 0, "Req [%d] Source [%d] Tag [%d] ERROR: %s\n", k,
+                  status[k].MPI_SOURCE, status[k].MPI_TAG, mesg);
+        }
+      }
+      error(1, 1, "complete_sf_sendrecv_proj " __FILE__,
+            "Cannot complete communications");
+    }
+#endif
+  }
+
+#ifdef MPI_TIMING
+  gettimeofday(&pend, 0);
+  timeval_subtract(&petime, &pend, &pstart);
+  lprintf("MPI TIMING", 0,
+          "complete_sf_sendrecv_proj" __FILE__ " %ld sec %ld usec\n",
+          petime.tv_sec, petime.tv_usec);
+#endif
+
+  ph->pending = 0;
+#endif /* WITH_MPI */
+}
+
+void start_sf_sendrecv_proj(spinor_field *sf)
+{
+#ifdef WITH_MPI
+  int mpiret;
+  (void)mpiret; // Remove warning of variable set but not used
+  proj_halo_data *ph = get_proj_halo(sf->type);
+  geometry_descriptor *gd = sf->type;
+
+  /* the buffers are shared by all fields of the same geometry */
+  error(ph->pending, 1, "start_sf_sendrecv_proj " __FILE__,
+        "Projected halo exchange already in progress");
+
+  /* pending full exchanges use the same requests */
+  complete_sf_sendrecv(sf);
+
+#ifdef MPI_TIMING
+  gettimeofday(&pstart, 0);
+#endif
+
+  /* fill send buffers */
+  for (int i = 0; i < ph->nbuf; i++)
+  {
+    const int dir = ph->dir[i];
+    _OMP_PRAGMA(_omp_parallel)
+    _OMP_PRAGMA(_omp_for)
+    for (int k = ph->soff[i]; k < ph->soff[i + 1]; k++)
+    {
+      const int ix = ph->ssite[k];
+      project_site(ph->sbuf + k, _FIELD_AT(sf, ix), dir, ix);
+    }
+  }
+
+  ++cost_cnt.halos;
+  for (int i = 0; i < ph->nbuf; ++i)
+  {
+    cost_cnt.halo_bytes += (gd->sbuf_len[i]) * sizeof(suNf_hspinor);
+    /* send ith buffer */
+    mpiret = MPI_Isend(
+        (double *)(ph->sbuf + ph->soff[i]), /* buffer */
+        (gd->sbuf_len[i]) * (sizeof(suNf_hspinor) /
+                             sizeof(double)), /* lenght in units of doubles */
+        MPI_DOUBLE,                           /* basic datatype */
+        gd->sbuf_to_proc[i],                  /* cid of destination */
+        i,                                    /* tag of communication */
+        cart_comm,             /* use the cartesian communicator */
+        &(sf->comm_req[2 * i]) /* handle to communication request */
+    );
+#ifndef NDEBUG
+    if (mpiret != MPI_SUCCESS)
+    {
+      char mesg[MPI_MAX_ERROR_STRING];
+      int mesglen;
+      MPI_Error_string(mpiret, mesg, &mesglen);
+      lprintf("MPI", 0, "ERROR: %s\n", mesg);
+      error(1, 1, "start_sf_sendrecv_proj " __FILE__, "Cannot start send buffer");
+    }
+#endif
+
+    /* receive ith buffer */
+    mpiret = MPI_Irecv(
+        (double *)(ph->rbuf + ph->roff[i]), /* buffer */
+        (gd->rbuf_len[i]) * (sizeof(suNf_hspinor) /
+                             sizeof(double)), /* lenght in units of doubles */
+        MPI_DOUBLE,                           /* basic datatype */
+        gd->rbuf_from_proc[i],                /* cid of origin */
+        i,                                    /* tag of communication */
+        cart_comm,                 /* use the cartesian communicator */
+        &(sf->comm_req[2 * i + 1]) /* handle to communication request */
+    );
+#ifndef NDEBUG
+    if (mpiret != MPI_SUCCESS)
+    {
+      char mesg[MPI_MAX_ERROR_STRING];
+      int mesglen;
+      MPI_Error_string(mpiret, mesg, &mesglen);
+      lprintf("MPI", 0, "ERROR: %s\n", mesg);
+      error(1, 1, "start_sf_sendrecv_proj " __FILE__, "Cannot start receive buffer");
+    }
+#endif
+  }
+
+  ph->pending = 1;
+#endif /* WITH_MPI */
+}
+
+#endif /* WITH_PROJECTED_HALO */
@@ -3,6 +3,7 @@
 #include "error.h"
 #include "logger.h"
 #include <string.h>
+#include <stdlib.h>
 
 static geometry_descriptor empty_gd = {0};
 
@@ -55,4 +56,105 @@ void empty_buffers(spinor_field *s)
 		size = sizeof(suNf_spinor) * s->type->rbuf_len[i];
 		memset(s->ptr+shift, 0, size);
 	}
-}
\ No newline at end of file
+}
+
+/*
+ * Blocks of the local lattice for the Schwarz alternating procedure.
+ * The colour of a block is the parity of its global block coordinates, so
+ * that neighbouring blocks have different colours also across processes:
+ * the global number of blocks must be even in each direction.
+ */
+SAP_blocks *init_SAP_blocks(int *bs)
+{
+	const int L[4] = {T, X, Y, Z};
+	const int np[4] = {NP_T, NP_X, NP_Y, NP_Z};
+	int c[4], bc[4], stride[4];
+	SAP_blocks *sb;
+
+	sb = malloc(sizeof(*sb));
+	error(sb == NULL, 1, "init_SAP_blocks [geometry_SAP.c]", "Cannot allocate memory");
+
+	sb->nb = 1;
+	sb->bvol = 1;
+	for(int mu = 0; mu < 4; mu++)
+	{
+		error(bs[mu] < 1 || L[mu] % bs[mu] != 0, 1, "init_SAP_blocks [geometry_SAP.c]",
+		      "The size of the blocks must divide the local lattice");
+		sb->bs[mu] = bs[mu];
+		sb->nbl[mu] = L[mu] / bs[mu];
+		error((sb->nbl[mu] * np[mu]) % 2 != 0, 1, "init_SAP_blocks [geometry_SAP.c]",
+		      "The global number of blocks must be even in each direction");
+		sb->nb *= sb->nbl[mu];
+		sb->bvol *= bs[mu];
+	}
+	for(int mu = 3, s = 1; mu >= 0; mu--)
+	{
+		stride[mu] = s;
+		s *= bs[mu];
+	}
+
+	/* sites of the blocks */
+	sb->site = malloc(sizeof(int) * sb->nb * sb->bvol);
+	error(sb->site == NULL, 1, "init_SAP_blocks [geometry_SAP.c]", "Cannot allocate memory");
+	for(int i = 0; i < T * X * Y * Z; i++)
+	{
+		int b = 0, n = 0;
+		for(int mu = 3, j = i; mu >= 0; mu--)
+		{
+			c[mu] = j % L[mu];
+			j /= L[mu];
+		}
+		for(int mu = 0; mu < 4; mu++)
+		{
+			b = b * sb->nbl[mu] + c[mu] / bs[mu];
+			n = n * bs[mu] + c[mu] % bs[mu];
+		}
+		sb->site[b * sb->bvol + n] = ipt(c[0], c[1], c[2], c[3]);
+	}
+
+	/* checkerboard of the global block coordinates */
+	sb->cblk[0] = malloc(sizeof(int) * 2 * sb->nb);
+	error(sb->cblk[0] == NULL, 1, "init_SAP_blocks [geometry_SAP.c]", "Cannot allocate memory");
+	sb->cblk[1] = sb->cblk[0] + sb->nb;
+	sb->ncblk[0] = sb->ncblk[1] = 0;
+	for(int b = 0; b < sb->nb; b++)
+	{
+		int col = 0;
+		for(int mu = 3, j = b; mu >= 0; mu--)
+		{
+			bc[mu] = j % sb->nbl[mu];
+			j /= sb->nbl[mu];
+			col += zerocoord[mu] / bs[mu] + bc[mu];
+		}
+		col %= 2;
+		sb->cblk[col][sb->ncblk[col]++] = b;
+	}
+
+	/* neighbours inside a block */
+	sb->iup = malloc(sizeof(int) * 8 * sb->bvol);
+	error(sb->iup == NULL, 1, "init_SAP_blocks [geometry_SAP.c]", "Cannot allocate memory");
+	sb->idn = sb->iup + 4 * sb->bvol;
+	for(int n = 0; n < sb->bvol; n++)
+	{
+		for(int mu = 0; mu < 4; mu++)
+		{
+			const int cm = (n / stride[mu]) % bs[mu];
+			sb->iup[4 * n + mu] = (cm < bs[mu] - 1) ? n + stride[mu] : -1;
+			sb->idn[4 * n + mu] = (cm > 0) ? n - stride[mu] : -1;
+		}
+	}
+
+	lprintf("GEOMETRY", 30, "SAP blocks %dx%dx%dx%d: %d local blocks\n", bs[0], bs[1], bs[2], bs[3], sb->nb);
+
+	return sb;
+}
+
+void free_SAP_blocks(SAP_blocks *sb)
+{
+	if(sb == NULL)
+		return;
+	free(sb->site);
+	free(sb->cblk[0]);
+	free(sb->iup);
+	free(sb);
+}
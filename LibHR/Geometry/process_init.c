@@ -20,6 +20,7 @@
 #include <unistd.h>
 #include <string.h>
 #include <getopt.h>
+#include <sys/stat.h>
 #include "utils.h"
 #include "io.h"
 #include "random.h"
@@ -247,6 +248,8 @@ int finalize_process()
 
   free_ghmc();
 
+  free_replica_pool();
+
   free_BCs();
 
   free_wrk_space();
@@ -262,6 +265,9 @@ int finalize_process()
   if (u_gauge_f_flt != NULL)
     free_gfield_f_flt(u_gauge_f_flt);
 
+  pool_report();
+  pool_release();
+
   free_geometry_mpi_eo();
 
   lprintf("SYSTEM", 0, "Process finalized.\n");
@@ -283,6 +289,11 @@ int finalize_process()
  * return codes:
  * 0 => success
  *
+ * Each replica works in the directory Rep_<RID>, where its log, configurations
+ * and random state are written. If the directory contains a copy of the input
+ * file, it is used instead of the common one (e.g. for replicas on different
+ * volumes).
+ *
  * AFFECTS THE GLOBAL VARIABLES: GLB_COMM, RID, PID, WORLD_SIZE
  */
 static int setup_replicas()
@@ -320,9 +331,32 @@ static int setup_replicas()
     MPI_Comm_rank(GLB_COMM, &PID);
     MPI_Comm_size(GLB_COMM, &WORLD_SIZE);
 
-    /* chdir to replica dir */
+    /* chdir to replica dir, creating it if needed */
     sprintf(sbuf, "Rep_%d", RID);
+    mkdir(sbuf, 0755);
     mpiret = chdir(sbuf);
+    error(mpiret != 0, 1, "setup_replicas " __FILE__, "Cannot enter the replica directory");
+
+    /* an input file in the replica directory overrides the common one */
+    if (access(input_filename, R_OK) != 0)
+    {
+      error(strlen(input_filename) + 4 > sizeof(input_filename), 1, "setup_replicas " __FILE__, "Input file name too long");
+      memmove(input_filename + 3, input_filename, strlen(input_filename) + 1);
+      memcpy(input_filename, "../", 3);
+    }
+    else
+    {
+      read_input(glb_var.read, input_filename);
+      error(N_REP * WORLD_SIZE != MPI_WORLD_SIZE, 1, "setup_replicas " __FILE__, "The number of replicas must be the same for all replicas");
+    }
+  }
+
+#else
+
+  if (N_REP > 1)
+  {
+    lprintf("SETUP_REPLICAS", 0, "WARNING: replicas need MPI, running a single replica\n");
+    N_REP = 1;
   }
 
 #endif // ifdef WITH_MPI
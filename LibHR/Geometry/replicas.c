@@ -0,0 +1,172 @@
+/***************************************************************************\
+ * Copyright (c) 2008, Claudio Pica                                          *
+ * All rights reserved.                                                      *
+ \***************************************************************************/
+
+/*******************************************************************************
+ *
+ * File replicas.c
+ *
+ * Multi-stream runs: the N_REP replicas created by setup_process, each with its
+ * own communicator GLB_COMM, directory Rep_<RID> and random seed, run
+ * independent Markov chains in the same job.
+ *
+ * The trajectories can be taken from a pool shared by all the replicas: before
+ * each trajectory process 0 of the replica takes a ticket from a counter held
+ * by process 0 of MPI_COMM_WORLD (one-sided atomic fetch-and-add, without
+ * synchronising with the other replicas). The replica stops when the pool is
+ * empty, so that faster replicas (e.g. on smaller volumes) run more
+ * trajectories and all of them finish at about the same time.
+ *
+ *******************************************************************************/
+
+#include "global.h"
+#include "setup.h"
+#include "error.h"
+#include "logger.h"
+#include "utils.h"
+#include <stdlib.h>
+
+static int pool_size = 0; /* 0 => no shared pool */
+static int pool_taken = 0; /* tickets taken by this replica */
+static struct timeval pool_start;
+static unsigned long int pool_mvm; /* Dirac operator applications at the start */
+#ifdef WITH_MPI
+static MPI_Win pool_win = MPI_WIN_NULL;
+static int *pool_cnt = NULL;
+#endif
+
+/* init_replica_pool
+ * Start the timing of the run and share ntraj trajectories between the
+ * replicas (ntraj <= 0 => no limit). Collective over MPI_COMM_WORLD.
+ */
+void init_replica_pool(int ntraj)
+{
+  free_replica_pool();
+
+  pool_size = (ntraj > 0) ? ntraj : 0;
+  pool_taken = 0;
+  gettimeofday(&pool_start, 0);
+  pool_mvm = cost_cnt.mvm + cost_cnt.mvm_flt;
+
+  if (pool_size == 0)
+    return;
+
+#ifdef WITH_MPI
+  if (N_REP > 1)
+  {
+    MPI_Aint size = (MPI_PID == 0) ? sizeof(int) : 0;
+    int mpiret = MPI_Win_allocate(size, sizeof(int), MPI_INFO_NULL, MPI_COMM_WORLD, &pool_cnt, &pool_win);
+    error(mpiret != MPI_SUCCESS, 1, "init_replica_pool [replicas.c]", "Cannot create the shared trajectory counter");
+    if (MPI_PID == 0)
+    {
+      MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, pool_win);
+      *pool_cnt = 0;
+      MPI_Win_unlock(0, pool_win);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+#endif
+
+  lprintf("REPLICAS", 0, "%d trajectories shared by %d replicas\n", pool_size, N_REP);
+}
+
+/* replica_pool_next
+ * Returns 1 if the replica can run one more trajectory, 0 if the pool is
+ * empty. Collective over GLB_COMM.
+ */
+int replica_pool_next()
+{
+  if (pool_size == 0)
+    return 1;
+
+  int ticket = pool_taken;
+#ifdef WITH_MPI
+  if (pool_win != MPI_WIN_NULL)
+  {
+    if (PID == 0)
+    {
+      const int one = 1;
+      MPI_Win_lock(MPI_LOCK_SHARED, 0, 0, pool_win);
+      MPI_Fetch_and_op(&one, &ticket, MPI_INT, 0, 0, MPI_SUM, pool_win);
+      MPI_Win_unlock(0, pool_win);
+    }
+    MPI_Bcast(&ticket, 1, MPI_INT, 0, GLB_COMM);
+  }
+#endif
+
+  if (ticket >= pool_size)
+    return 0;
+  pool_taken++;
+  return 1;
+}
+
+/* replica_report
+ * Throughput of this replica (ntraj trajectories, nacc accepted, Dirac
+ * operator applications in single and double precision since
+ * init_replica_pool) and aggregated over all the replicas. The wall time of
+ * the job is the one of the slowest replica; the efficiency is the fraction of
+ * it the replicas were busy. Collective over MPI_COMM_WORLD.
+ */
+void replica_report(int ntraj, int nacc)
+{
+  struct timeval end, etime;
+  gettimeofday(&end, 0);
+  timeval_subtract(&etime, &end, &pool_start);
+
+  /* PID, trajectories, accepted, time, volume, MVM */
+  double v[6] = {PID, ntraj, nacc, etime.tv_sec + 1.e-6 * etime.tv_usec, GLB_VOLUME, 0.5 * (cost_cnt.mvm + cost_cnt.mvm_flt - pool_mvm)};
+  double *all = v;
+  int n = 1;
+
+  lprintf("REPLICAS", 0, "Replica %d: %d trajectories (%d accepted) in %1.3f s, %1.4f traj/s, %1.4e site-traj/s, %1.4e MVM/s\n",
+          RID, ntraj, nacc, v[3], (v[3] > 0.) ? ntraj / v[3] : 0., (v[3] > 0.) ? v[4] * ntraj / v[3] : 0., (v[3] > 0.) ? v[5] / v[3] : 0.);
+
+#ifdef WITH_MPI
+  if (N_REP > 1)
+  {
+    n = MPI_WORLD_SIZE;
+    if (MPI_PID == 0)
+    {
+      all = malloc(6 * n * sizeof(double));
+      error(all == NULL, 1, "replica_report [replicas.c]", "Could not allocate memory space for the report");
+    }
+    MPI_Gather(v, 6, MPI_DOUBLE, all, 6, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  }
+#endif
+
+  if (MPI_PID == 0)
+  {
+    double traj = 0., acc = 0., sites = 0., mvm = 0., busy = 0., wall = 0.;
+    for (int i = 0; i < n; i++)
+    {
+      const double *r = all + 6 * i;
+      if (r[0] != 0.)
+        continue; /* one entry per replica */
+      traj += r[1];
+      acc += r[2];
+      sites += r[4] * r[1];
+      mvm += r[5];
+      busy += r[3];
+      wall = (r[3] > wall) ? r[3] : wall;
+    }
+    lprintf("REPLICAS", 0, "All %d replicas: %.0f trajectories (%.0f accepted) in %1.3f s, %1.4f traj/s, %1.4e site-traj/s, %1.4e MVM/s, efficiency %3.1f%%\n",
+            N_REP, traj, acc, wall, (wall > 0.) ? traj / wall : 0., (wall > 0.) ? sites / wall : 0., (wall > 0.) ? mvm / wall : 0.,
+            (wall > 0.) ? 100. * busy / (N_REP * wall) : 100.);
+    if (all != v)
+      free(all);
+  }
+}
+
+/* free_replica_pool
+ * Collective over MPI_COMM_WORLD if the pool is shared.
+ */
+void free_replica_pool()
+{
+#ifdef WITH_MPI
+  if (pool_win != MPI_WIN_NULL)
+    MPI_Win_free(&pool_win);
+  pool_cnt = NULL;
+#endif
+  pool_size = 0;
+}
@@ -0,0 +1,389 @@
+/***************************************************************************\
+ * Copyright (c) 2008, Claudio Pica                                          *
+ * All rights reserved.                                                      *
+ \***************************************************************************/
+
+/*******************************************************************************
+ *
+ * File archive_async.c
+ *
+ * Checkpoints written while the simulation goes on.
+ *
+ * async_save_gauge_field, async_save_scalar_field and async_save_ranlxd_state
+ * copy the local data of the process into a staging buffer, in the format
+ * of write_gauge_field, write_scalar_field and write_ranlxd_state.
+ * async_save_start hands the staged files to a writer thread (WITH_ASYNC_IO)
+ * or writes them at once: each process writes its own part of the files at
+ * the right offsets, so that no data goes through PID 0.
+ *
+ * The files are written as <name>.tmp and are renamed only when all the
+ * processes have written and flushed their parts (async_save_poll,
+ * async_save_wait), so that a crash never leaves an incomplete file under
+ * the name used for a restart.
+ *
+ *******************************************************************************/
+
+#define _DEFAULT_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#ifdef WITH_ASYNC_IO
+#include <pthread.h>
+#endif
+#include "io.h"
+#include "error.h"
+#include "global.h"
+#include "logger.h"
+#include "observables.h"
+#include "communications.h"
+#include "utils.h"
+#include "ranlux.h"
+
+#define ASYNC_MAX_FILES 4
+
+typedef struct
+{
+  char name[256]; /* final name of the file */
+  char tmp[260];  /* name while it is being written */
+  int nchunk;
+  off_t *off;    /* offsets of the chunks in the file */
+  size_t *len;   /* lengths of the chunks */
+  char *data;    /* the chunks, one after the other */
+  size_t used;
+} async_file;
+
+static async_file files[ASYNC_MAX_FILES];
+static int nfiles = 0;
+static int pending = 0;   /* files handed to the writer */
+static int werr = 0;      /* errno of the first failed write */
+static int werr_file = 0; /* and the file it refers to */
+static struct timeval tstart, tend;
+
+#ifdef WITH_ASYNC_IO
+static pthread_t writer;
+static pthread_mutex_t done_lock = PTHREAD_MUTEX_INITIALIZER;
+static int done = 0;
+#endif
+
+static async_file *new_file(char filename[], int nchunk, size_t size)
+{
+  async_file *f;
+
+  /* the staging buffers of the previous checkpoint are still in use */
+  async_save_wait();
+
+  error(nfiles == ASYNC_MAX_FILES, 1, "new_file [archive_async.c]", "Too many files in the checkpoint");
+  f = files + nfiles++;
+  error(strlen(filename) >= sizeof(f->name), 1, "new_file [archive_async.c]", "File name too long");
+  strcpy(f->name, filename);
+  strcpy(f->tmp, filename);
+  strcat(f->tmp, ".tmp");
+  f->nchunk = 0;
+  f->used = 0;
+  f->off = malloc(sizeof(*f->off) * nchunk);
+  f->len = malloc(sizeof(*f->len) * nchunk);
+  f->data = malloc(size);
+  error(f->off == NULL || f->len == NULL || (size > 0 && f->data == NULL), 1, "new_file [archive_async.c]",
+        "Could not allocate the staging buffer");
+  return f;
+}
+
+static char *add_chunk(async_file *f, off_t off, size_t len)
+{
+  char *p = f->data + f->used;
+  f->off[f->nchunk] = off;
+  f->len[f->nchunk] = len;
+  f->nchunk++;
+  f->used += len;
+  return p;
+}
+
+/* the local sites in the global (t,x,y,z) order, nd doubles each from fill */
+static void stage_sites(async_file *f, off_t header, int nd, void (*fill)(double *, int), int big_endian)
+{
+  const size_t run = (size_t)Z * nd;
+  int lsite[4], org[4];
+
+  origin_coord(org);
+  for (lsite[0] = 0; lsite[0] < T; ++lsite[0])
+    for (lsite[1] = 0; lsite[1] < X; ++lsite[1])
+      for (lsite[2] = 0; lsite[2] < Y; ++lsite[2])
+      {
+        off_t site = (((off_t)(org[0] + lsite[0]) * GLB_X + org[1] + lsite[1]) * GLB_Y + org[2] + lsite[2]) * GLB_Z + org[3];
+        double *buf = (double *)add_chunk(f, header + site * nd * sizeof(double), run * sizeof(double));
+        for (lsite[3] = 0; lsite[3] < Z; ++lsite[3])
+          fill(buf + lsite[3] * nd, ipt(lsite[0], lsite[1], lsite[2], lsite[3]));
+        if (big_endian)
+          to_BE_double(buf, run);
+        else
+          to_LE_double(buf, run);
+      }
+}
+
+#if NG != 2 || defined(WITH_QUATERNIONS)
+static void gauge_site(double *buf, int ix)
+{
+  memcpy(buf, pu_gauge(ix, 0), 4 * sizeof(suNg)); /* 4 directions */
+  if (four_fermion_active)
+  {
+    buf += 4 * sizeof(suNg) / sizeof(double);
+    buf[0] = *_FIELD_AT(ff_sigma, ix);
+    buf[1] = *_FIELD_AT(ff_pi, ix);
+  }
+}
+#endif
+
+static void scalar_site(double *buf, int ix)
+{
+  memcpy(buf, pu_scalar(ix), sizeof(suNg_vector));
+}
+
+void async_save_gauge_field(char filename[])
+{
+#if NG == 2 && !defined(WITH_QUATERNIONS)
+  /* the quaternion format is written by PID 0 only */
+  async_save_wait();
+  write_gauge_field(filename);
+#else
+  const int nd = sizeof(suNg) / sizeof(double) * 4 + (four_fermion_active ? 2 : 0); /* doubles per site */
+  const off_t header = 5 * sizeof(int) + sizeof(double);
+  async_file *f;
+  double plaq;
+
+#ifndef ALLOCATE_REPR_GAUGE_FIELD
+  complete_gf_sendrecv(u_gauge);
+  apply_BCs_on_represented_gauge_field(); //Save the link variables with periodic boundary conditions
+#endif
+
+  plaq = avr_plaquette(); /* to use as a checksum in the header */
+  f = new_file(filename, T * X * Y + 1, header + (size_t)T * X * Y * Z * nd * sizeof(double));
+  if (PID == 0)
+  {
+    int d[5] = {NG, GLB_T, GLB_X, GLB_Y, GLB_Z};
+    char *h = add_chunk(f, 0, header);
+    to_BE_int(d, 5);
+    to_BE_double(&plaq, 1);
+    memcpy(h, d, sizeof(d));
+    memcpy(h + sizeof(d), &plaq, sizeof(plaq));
+  }
+  stage_sites(f, header, nd, &gauge_site, 1);
+
+#ifndef ALLOCATE_REPR_GAUGE_FIELD
+  complete_gf_sendrecv(u_gauge);
+  apply_BCs_on_represented_gauge_field(); //Restore the right boundary conditions
+#endif
+#endif
+}
+
+void async_save_scalar_field(char filename[])
+{
+  const int nd = sizeof(suNg_vector) / sizeof(double);
+  const off_t header = 5 * sizeof(int);
+  async_file *f;
+
+#ifndef ALLOCATE_REPR_GAUGE_FIELD
+  complete_sc_sendrecv(u_scalar);
+#endif
+
+  f = new_file(filename, T * X * Y + 1, header + (size_t)T * X * Y * Z * nd * sizeof(double));
+  if (PID == 0)
+  {
+    int d[5] = {NG, GLB_T, GLB_X, GLB_Y, GLB_Z};
+    to_LE_int(d, 5);
+    memcpy(add_chunk(f, 0, header), d, sizeof(d));
+  }
+  stage_sites(f, header, nd, &scalar_site, 0);
+}
+
+void async_save_ranlxd_state(char filename[])
+{
+  const int rsize = rlxd_size();
+  const int ip = ((COORD[0] * NP_X + COORD[1]) * NP_Y + COORD[2]) * NP_Z + COORD[3]; /* position in the processor grid loop */
+  const off_t header = 2 * sizeof(int);
+  async_file *f;
+  int *buf;
+
+  f = new_file(filename, 2, header + rsize * sizeof(int));
+  if (PID == 0)
+  {
+    int d[2] = {NP_T * NP_X * NP_Y * NP_Z, rsize};
+    to_BE_int(d, 2);
+    memcpy(add_chunk(f, 0, header), d, sizeof(d));
+  }
+  buf = (int *)add_chunk(f, header + (off_t)ip * rsize * sizeof(int), rsize * sizeof(int));
+  rlxd_get(buf);
+  to_BE_int(buf, rsize);
+}
+
+/* this process' part of the staged files, flushed to the disk */
+static void write_files(void)
+{
+  for (int k = 0; k < nfiles && werr == 0; k++)
+  {
+    async_file *f = files + k;
+    size_t p = 0;
+    int fd;
+
+    fd = open(f->tmp, O_WRONLY);
+    if (fd < 0)
+    {
+      werr = errno;
+      werr_file = k;
+      break;
+    }
+    for (int c = 0; c < f->nchunk && werr == 0; c++)
+    {
+      size_t n = 0;
+      while (n < f->len[c])
+      {
+        ssize_t w = pwrite(fd, f->data + p + n, f->len[c] - n, f->off[c] + n);
+        if (w < 0)
+        {
+          werr = errno;
+          werr_file = k;
+          break;
+        }
+        n += w;
+      }
+      p += f->len[c];
+    }
+    if (werr == 0 && fsync(fd) != 0)
+    {
+      werr = errno;
+      werr_file = k;
+    }
+    close(fd);
+  }
+  gettimeofday(&tend, 0);
+}
+
+#ifdef WITH_ASYNC_IO
+static void *writer_main(void *arg)
+{
+  (void)arg;
+  write_files();
+  pthread_mutex_lock(&done_lock);
+  done = 1;
+  pthread_mutex_unlock(&done_lock);
+  return NULL;
+}
+#endif
+
+/* all the processes are done: the files get their final names */
+static void async_commit(void)
+{
+  int err = werr;
+  struct timeval etime;
+
+  if (werr != 0)
+    lprintf("IO", 0, "Failed to write [%s]: %s\n", files[werr_file].name, strerror(werr));
+#ifdef WITH_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &err, 1, MPI_INT, MPI_MAX, GLB_COMM);
+#endif
+  error(err != 0, 1, "async_commit [archive_async.c]", "Failed to write the checkpoint");
+
+  timeval_subtract(&etime, &tend, &tstart);
+  for (int k = 0; k < nfiles; k++)
+  {
+    if (PID == 0)
+    {
+      error(rename(files[k].tmp, files[k].name) != 0, 1, "async_commit [archive_async.c]", "Failed to rename the checkpoint");
+    }
+    lprintf("IO", 0, "File [%s] saved in the background [%ld sec %ld usec]\n", files[k].name, etime.tv_sec, etime.tv_usec);
+    free(files[k].off);
+    free(files[k].len);
+    free(files[k].data);
+  }
+  nfiles = 0;
+  pending = 0;
+
+#ifdef WITH_MPI
+  MPI_Barrier(GLB_COMM);
+#endif
+}
+
+/*
+ * Starts writing the staged files. Without WITH_ASYNC_IO the files are
+ * written and renamed before returning.
+ */
+void async_save_start(void)
+{
+  if (nfiles == 0)
+    return;
+
+  /* the temporary files are created by PID 0 only */
+  if (PID == 0)
+  {
+    for (int k = 0; k < nfiles; k++)
+    {
+      int fd = open(files[k].tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      error(fd < 0, 1, "async_save_start [archive_async.c]", "Failed to open file for writing");
+      close(fd);
+    }
+  }
+#ifdef WITH_MPI
+  MPI_Barrier(GLB_COMM);
+#endif
+
+  werr = 0;
+  pending = 1;
+  gettimeofday(&tstart, 0);
+#ifdef WITH_ASYNC_IO
+  done = 0;
+  error(pthread_create(&writer, NULL, &writer_main, NULL) != 0, 1, "async_save_start [archive_async.c]",
+        "Failed to start the writer thread");
+#else
+  write_files();
+  async_commit();
+#endif
+}
+
+/*
+ * Returns 1 if no checkpoint is being written, renaming the files of the
+ * last one if it has just been completed. Must be called by all processes.
+ */
+int async_save_poll(void)
+{
+  int all_done = 1;
+
+  if (!pending)
+    return 1;
+
+#ifdef WITH_ASYNC_IO
+  pthread_mutex_lock(&done_lock);
+  all_done = done;
+  pthread_mutex_unlock(&done_lock);
+#endif
+#ifdef WITH_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &all_done, 1, MPI_INT, MPI_MIN, GLB_COMM);
+#endif
+  if (!all_done)
+    return 0;
+
+#ifdef WITH_ASYNC_IO
+  pthread_join(writer, NULL);
+#endif
+  async_commit();
+  return 1;
+}
+
+/* waits for the checkpoint being written. Must be called by all processes */
+void async_save_wait(void)
+{
+  if (!pending)
+    return;
+
+#ifdef WITH_ASYNC_IO
+  pthread_join(writer, NULL);
+  pthread_mutex_lock(&done_lock);
+  done = 1;
+  pthread_mutex_unlock(&done_lock);
+#endif
+  async_commit();
+}
@@ -239,3 +239,30 @@ int fread_LE_double(double* ptr, size_t n, FILE* fp) {
   return ret;
 }
 
+/* in place conversion from the machine byte order, for the buffers written with pwrite */
+static void swap_n(void* ptr, size_t size, size_t n) {
+  size_t i;
+  char* c=ptr;
+  if(size*CHAR_BIT==16)
+    for(i=0; i<n; i++) swapendian16(c+i*size);
+  else if(size*CHAR_BIT==32)
+    for(i=0; i<n; i++) swapendian32(c+i*size);
+  else if(size*CHAR_BIT==64)
+    for(i=0; i<n; i++) swapendian64(c+i*size);
+}
+
+void to_BE_int(int* ptr, size_t n) {
+  if(which_endian()==_LITTLE_ENDIAN_HRP) swap_n(ptr,sizeof(int),n);
+}
+
+void to_LE_int(int* ptr, size_t n) {
+  if(which_endian()==_BIG_ENDIAN_HRP) swap_n(ptr,sizeof(int),n);
+}
+
+void to_BE_double(double* ptr, size_t n) {
+  if(which_endian()==_LITTLE_ENDIAN_HRP) swap_n(ptr,sizeof(double),n);
+}
+
+void to_LE_double(double* ptr, size_t n) {
+  if(which_endian()==_BIG_ENDIAN_HRP) swap_n(ptr,sizeof(double),n);
+}
@@ -79,6 +79,32 @@ static double find_double(section *sec, char *key)
    return 0;
 }
 
+// Optional sharing and precision of the chronological history
+static void find_mre(section *sec, int *share, int *half)
+{
+   char *prec;
+
+   *share = find_double(sec, "mre_share");
+   prec = find_string(sec, "mre_prec");
+   *half = (prec != 0 && strcmp(prec, "half") == 0);
+   check(prec != 0 && !*half && strcmp(prec, "single") != 0, "Invalid 'mre_prec' in monomial: must be single or half\n");
+   last_error = 0;
+}
+
+// Optional deflation of the low modes in the force
+static void find_defl(section *sec, int *nev, int *refine, int mg_nvec)
+{
+   *nev = find_double(sec, "defl_nev");
+   *refine = find_double(sec, "defl_refine");
+   if (last_error)
+   {
+      *refine = 1;
+   }
+   check(*nev < 0 || *refine < 0, "Invalid 'defl_nev' or 'defl_refine' in monomial\n");
+   check(*nev > 0 && mg_nvec > 0, "Options 'defl_nev' and 'mg_nvec' cannot be used together\n");
+   last_error = 0;
+}
+
 static void add_monomial_to_integrator(const monomial *m, int level)
 {
    integrator_par *iter = ip;
@@ -162,6 +188,18 @@ static void setup_monomials()
 
          par->mre_past = find_double(cur, "mre_past");
          check(last_error, "Unable to find 'mre_past' in monomial of type 'hmc'\n");
+         find_mre(cur, &par->mre_share, &par->mre_half);
+
+         // Optional multigrid solver
+         par->mg_nvec = find_double(cur, "mg_nvec");
+         par->mg_block = find_double(cur, "mg_block");
+         if (par->mg_block == 0)
+         {
+            par->mg_block = 4;
+         }
+
+         // Optional deflation of the low modes
+         find_defl(cur, &par->defl_nev, &par->defl_refine, par->mg_nvec);
 
          // Add monomial
          mret = add_mon(&data);
@@ -169,6 +207,14 @@ static void setup_monomials()
          // Monomial information
          lprintf("ACTION", 10, "Monomial %d: level = %d, type = hmc, mass = %1.6f, force_prec = %1.2e, mt_prec = %1.2e\n",
                  i, level, par->mass, data.force_prec, data.MT_prec);
+         if (par->mg_nvec > 0)
+         {
+            lprintf("ACTION", 10, "Monomial %d: multigrid solver with %d null vectors, blocks of size %d\n", i, par->mg_nvec, par->mg_block);
+         }
+         if (par->defl_nev > 0)
+         {
+            lprintf("ACTION", 10, "Monomial %d: deflation of %d low modes, %d Rayleigh-Ritz steps per update\n", i, par->defl_nev, par->defl_refine);
+         }
       }
       else if (strcmp(type, "tm") == 0)
       {
@@ -191,6 +237,7 @@ static void setup_monomials()
 
          par->mre_past = find_double(cur, "mre_past");
          check(last_error, "Unable to find 'mre_past' in monomial of type 'tm'\n");
+         find_mre(cur, &par->mre_share, &par->mre_half);
 
          // Add monomial
          mret = add_mon(&data);
@@ -220,6 +267,7 @@ static void setup_monomials()
 
          par->mre_past = find_double(cur, "mre_past");
          check(last_error, "Unable to find 'mre_past' in monomial of type 'tm_alt'\n");
+         find_mre(cur, &par->mre_share, &par->mre_half);
 
          // Add monomial
          mret = add_mon(&data);
@@ -249,6 +297,18 @@ static void setup_monomials()
 
          par->mre_past = find_double(cur, "mre_past");
          check(last_error, "Unable to find 'mre_past' in monomial of type 'hasenbusch'\n");
+         find_mre(cur, &par->mre_share, &par->mre_half);
+
+         // Optional multigrid solver
+         par->mg_nvec = find_double(cur, "mg_nvec");
+         par->mg_block = find_double(cur, "mg_block");
+         if (par->mg_block == 0)
+         {
+            par->mg_block = 4;
+         }
+
+         // Optional deflation of the low modes
+         find_defl(cur, &par->defl_nev, &par->defl_refine, par->mg_nvec);
 
          // Add monomial
          mret = add_mon(&data);
@@ -256,6 +316,14 @@ static void setup_monomials()
          // Monomial information
          lprintf("ACTION", 10, "Monomial %d: level = %d, type = hasenbusch, mass = %1.6f, dm = %1.6f, force_prec = %1.2e, mt_prec = %1.2e\n",
                  i, level, par->mass, par->dm, data.force_prec, data.MT_prec);
+         if (par->mg_nvec > 0)
+         {
+            lprintf("ACTION", 10, "Monomial %d: multigrid solver with %d null vectors, blocks of size %d\n", i, par->mg_nvec, par->mg_block);
+         }
+         if (par->defl_nev > 0)
+         {
+            lprintf("ACTION", 10, "Monomial %d: deflation of %d low modes, %d Rayleigh-Ritz steps per update\n", i, par->defl_nev, par->defl_refine);
+         }
       }
       else if (strcmp(type, "rhmc") == 0)
       {
@@ -282,12 +350,22 @@ static void setup_monomials()
          data.force_prec = find_double(cur, "force_prec");
          check(last_error, "Unable to find 'force_prec' in monomial of type 'rhmc'\n");
 
+         // Optional mixed precision solver for the force
+         par->mixed_prec = find_double(cur, "mixed_prec");
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+         check(par->mixed_prec, "Option 'mixed_prec' in monomial of type 'rhmc' is not available with clover\n");
+#endif
+
          // Add monomial
          mret = add_mon(&data);
 
          // Monomial information
          lprintf("ACTION", 10, "Monomial %d: level = %d, type = rhmc, mass = %1.6f, force_prec = %1.2e, mt_prec = %1.2e, md_prec = %1.2e\n",
                  i, level, par->mass, data.force_prec, data.MT_prec, data.MD_prec);
+         if (par->mixed_prec)
+         {
+            lprintf("ACTION", 10, "Monomial %d: mixed precision multi-shift solver\n", i);
+         }
       }
       else if (strcmp(type, "hasenbusch_tm") == 0)
       {
@@ -313,6 +391,7 @@ static void setup_monomials()
 
          par->mre_past = find_double(cur, "mre_past");
          check(last_error, "Unable to find 'mre_past' in monomial of type 'hasenbusch_tm'\n");
+         find_mre(cur, &par->mre_share, &par->mre_half);
 
          // Add monomial
          mret = add_mon(&data);
@@ -345,6 +424,7 @@ static void setup_monomials()
 
          par->mre_past = find_double(cur, "mre_past");
          check(last_error, "Unable to find 'mre_past' in monomial of type 'hasenbusch_tm_alt'\n");
+         find_mre(cur, &par->mre_share, &par->mre_half);
 
          // Add monomial
          mret = add_mon(&data);
@@ -400,6 +480,7 @@ static void setup_monomials()
 
          par->mre_past = find_double(cur, "mre_past");
          check(last_error, "Unable to find 'mre_past' in monomial of type 'hmc_ff'\n");
+         find_mre(cur, &par->mre_share, &par->mre_half);
 
          // Add monomial
          mret = add_mon(&data);
@@ -429,6 +510,7 @@ static void setup_monomials()
 
          par->mre_past = find_double(cur, "mre_past");
          check(last_error, "Unable to find 'mre_past' in monomial of type 'hasenbusch_ff'\n");
+         find_mre(cur, &par->mre_share, &par->mre_half);
 
          // Add monomial
          mret = add_mon(&data);
@@ -518,6 +600,16 @@ static void setup_integrator()
          tmp.integrator = &leapfrog_multistep;
          lprintf("INTEGRATOR", 10, "Level %d: type = lf, steps = %d\n", i, tmp.nsteps);
       }
+      else if (strcmp(type, "fg") == 0)
+      {
+         tmp.integrator = &FG_multistep;
+         lprintf("INTEGRATOR", 10, "Level %d: type = fg, steps = %d\n", i, tmp.nsteps);
+      }
+      else if (strcmp(type, "fg_pos") == 0)
+      {
+         tmp.integrator = &FG_pos_multistep;
+         lprintf("INTEGRATOR", 10, "Level %d: type = fg_pos, steps = %d\n", i, tmp.nsteps);
+      }
       else
       {
          check(1, "Unknown integrator type\n");
@@ -0,0 +1,252 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *   
+* All rights reserved.                                                      * 
+\***************************************************************************/
+
+#include "inverters.h"
+#include "linear_algebra.h"
+#include "communications.h"
+#include "memory.h"
+#include "logger.h"
+#include <stdlib.h>
+#include <math.h>
+
+/* relative squared norm below which a search direction is dropped */
+#define BLOCK_DEFLATION_TOL 1.e-12
+
+/*
+ * Block minimal residual solver for n right-hand sides sharing one Krylov
+ * space: M out[k] = in[k], k<n, with M hermitian, not necessarily positive
+ * (e.g. g5 D). out is used as initial guess.
+ *
+ * The images Q = M P of the search directions are an orthonormal basis of
+ * the block Krylov space M K(M,R0), built with the block Lanczos three-term
+ * recursion; the residual is minimised over it as in MINRES.
+ * Directions which have become (almost) linearly dependent are dropped by
+ * block_orthonormalize, so that the block size s<=n can only decrease.
+ * At each step M is applied once to the s newest basis vectors, and all the
+ * scalar products are computed in a single sweep and a single global sum:
+ *   S = M Z ,  Z = Q (Z = R at the first step)
+ *   [Qold Q R S]^dag [S R]
+ *   a = Q^dag S ,  b = Qold^dag S
+ *   P' = (Z - P a - Pold b) T ,  Q' = (S - Q a - Qold b) T ,  T from Q'^dag Q' = 1
+ *   alpha = Q'^dag R
+ *   X += P' alpha ,  R -= Q' alpha
+ */
+static int MINRES_block_core(short int *valid, MINRES_par *par, spinor_operator_block M, spinor_field *in, spinor_field *out, int n)
+{
+  spinor_field *base, *p, *q, *pold, *qold, *r, *sv, *pn, *z, *ptmp, *lhs, *rhs;
+  double complex *g, *a, *b, *wr, *ww, *t, *tmp;
+  double innorm2[n];
+  int i, j, k, m, s, so, ns, nc, cgiter;
+  unsigned short notconverged;
+
+  /* allocate spinors fields and the small matrices */
+  base = alloc_spinor_field_f(7 * n, in->type);
+  p = base;
+  pold = p + n;
+  q = pold + n;
+  qold = q + n;
+  r = qold + n;
+  sv = r + n;
+  pn = sv + n;
+  lhs = malloc(sizeof(spinor_field) * 6 * n);
+  rhs = lhs + 4 * n;
+
+  g = malloc(sizeof(double complex) * (8 * n * n + 6 * n * n));
+  a = g + 8 * n * n;
+  b = a + n * n;
+  wr = b + n * n;
+  ww = wr + n * n;
+  t = ww + n * n;
+  tmp = t + n * n;
+
+  /* init recursion: R = in - M out */
+  cgiter = 0;
+  M(sv, out, n);
+  cgiter += n;
+  for (k = 0; k < n; ++k)
+  {
+    innorm2[k] = spinor_field_sqnorm_f(&in[k]);
+    spinor_field_sub_f(&r[k], &in[k], &sv[k]);
+  }
+  s = so = 0;
+  z = r;
+  m = n;
+
+  do
+  {
+    M(sv, z, m);
+    cgiter += m;
+
+    /* g = [Qold Q R S]^dag [S R], ns = so+s+n+m rows of nc = m+n columns */
+    ns = so + s + n + m;
+    nc = m + n;
+    for (i = 0; i < so; ++i)
+      lhs[i] = qold[i];
+    for (i = 0; i < s; ++i)
+      lhs[so + i] = q[i];
+    for (i = 0; i < n; ++i)
+      lhs[so + s + i] = r[i];
+    for (i = 0; i < m; ++i)
+      lhs[so + s + n + i] = rhs[i] = sv[i];
+    for (i = 0; i < n; ++i)
+      rhs[m + i] = r[i];
+    spinor_field_block_prod_local_f(g, lhs, ns, rhs, nc);
+#ifdef WITH_MPI
+    global_sum((double *)g, 2 * ns * nc);
+#endif
+#define _QoS(i, j) g[(i) * nc + (j)]
+#define _QoR(i, j) g[(i) * nc + m + (j)]
+#define _QS(i, j) g[(so + (i)) * nc + (j)]
+#define _QR(i, j) g[(so + (i)) * nc + m + (j)]
+#define _RR(i, j) g[(so + s + (i)) * nc + m + (j)]
+#define _SS(i, j) g[(so + s + n + (i)) * nc + (j)]
+#define _SR(i, j) g[(so + s + n + (i)) * nc + m + (j)]
+
+    /* check convergence of vectors */
+    notconverged = 0;
+    for (k = 0; k < n; ++k)
+      if (creal(_RR(k, k)) > par->err2 * innorm2[k])
+        notconverged++;
+    if (!notconverged)
+      break;
+
+    /* W = S - Q a - Qold b is orthogonal to the previous basis vectors */
+    for (i = 0; i < s; ++i)
+      for (j = 0; j < m; ++j)
+        a[i * m + j] = _QS(i, j);
+    for (i = 0; i < so; ++i)
+      for (j = 0; j < m; ++j)
+        b[i * m + j] = _QoS(i, j);
+    /* ww = W^dag W = S^dag S - a^dag a - b^dag b */
+    /* wr = W^dag R = S^dag R - a^dag Q^dag R - b^dag Qold^dag R */
+    for (i = 0; i < m; ++i)
+    {
+      for (j = 0; j < m; ++j)
+      {
+        double complex c = _SS(i, j);
+        for (k = 0; k < s; ++k)
+          c -= conj(a[k * m + i]) * a[k * m + j];
+        for (k = 0; k < so; ++k)
+          c -= conj(b[k * m + i]) * b[k * m + j];
+        ww[i * m + j] = c;
+      }
+      for (j = 0; j < n; ++j)
+      {
+        double complex c = _SR(i, j);
+        for (k = 0; k < s; ++k)
+          c -= conj(a[k * m + i]) * _QR(k, j);
+        for (k = 0; k < so; ++k)
+          c -= conj(b[k * m + i]) * _QoR(k, j);
+        wr[i * n + j] = c;
+      }
+    }
+#undef _QoS
+#undef _QoR
+#undef _QS
+#undef _QR
+#undef _RR
+#undef _SS
+#undef _SR
+
+    /* Pn = Z - P a - Pold b, W = S - Q a - Qold b (in sv) */
+    for (k = 0; k < m; ++k)
+    {
+      spinor_field_copy_f(&pn[k], &z[k]);
+    }
+    for (i = 0; i < s * m; ++i)
+      a[i] = -a[i];
+    for (i = 0; i < so * m; ++i)
+      b[i] = -b[i];
+    spinor_field_block_mul_add_assign_f(pn, m, p, s, a);
+    spinor_field_block_mul_add_assign_f(pn, m, pold, so, b);
+    spinor_field_block_mul_add_assign_f(sv, m, q, s, a);
+    spinor_field_block_mul_add_assign_f(sv, m, qold, so, b);
+
+    /* orthonormalise the new basis vectors, P and Q move to Pold and Qold */
+    so = s;
+    s = block_orthonormalize(m, ww, BLOCK_DEFLATION_TOL, t);
+    if (s == 0)
+      break;
+    for (i = 0; i < m; ++i)
+      for (j = 0; j < s; ++j)
+        tmp[i * s + j] = t[i * m + j];
+    ptmp = pold;
+    pold = p;
+    p = ptmp;
+    ptmp = qold;
+    qold = q;
+    q = ptmp;
+    spinor_field_block_mul_f(p, s, pn, m, tmp);
+    spinor_field_block_mul_f(q, s, sv, m, tmp);
+
+    /* alpha = T^dag W^dag R */
+    for (i = 0; i < s; ++i)
+      for (j = 0; j < n; ++j)
+      {
+        double complex c = 0.;
+        for (k = 0; k < m; ++k)
+          c += conj(t[k * m + i]) * wr[k * n + j];
+        tmp[i * n + j] = c;
+      }
+    spinor_field_block_mul_add_assign_f(out, n, p, s, tmp);
+    for (i = 0; i < s * n; ++i)
+      tmp[i] = -tmp[i];
+    spinor_field_block_mul_add_assign_f(r, n, q, s, tmp);
+
+    z = q;
+    m = s;
+
+  } while ((par->max_iter == 0 || cgiter < par->max_iter * n));
+
+  /* test results */
+  M(sv, out, n);
+  cgiter += n;
+  for (k = 0; k < n; ++k)
+  {
+    double norm;
+    spinor_field_sub_assign_f(&sv[k], &in[k]);
+    norm = spinor_field_sqnorm_f(&sv[k]) / innorm2[k];
+    valid[k] = 1;
+    if (fabs(norm) > par->err2)
+    {
+      valid[k] = 0;
+      lprintf("INVERTER", 30, "MINRES_block failed on vect %d: err2 = %1.8e > %1.8e\n", k, norm, par->err2);
+    }
+    else
+    {
+      lprintf("INVERTER", 20, "MINRES_block inversion: err2 = %1.8e < %1.8e\n", norm, par->err2);
+    }
+  }
+
+  /* free memory */
+  free_spinor_field_f(base);
+  free(lhs);
+  free(g);
+
+  return cgiter;
+}
+
+int MINRES_block(MINRES_par *par, spinor_operator_block M, spinor_field *in, spinor_field *out, int n)
+{
+  int cgiter, rep = 0;
+  short int valid[n];
+  int notconverged;
+
+  cgiter = 0;
+  do
+  {
+    cgiter += MINRES_block_core(valid, par, M, in, out, n);
+    notconverged = 0;
+    for (int k = 0; k < n; ++k)
+      if (!valid[k])
+        notconverged++;
+    if (notconverged && (++rep) % 5 == 0)
+      lprintf("INVERTER", -10, "MINRES_block recursion = %d (precision too high?)\n", rep);
+  } while (notconverged);
+
+  lprintf("INVERTER", 10, "MINRES_block: MVM = %d (%d right-hand sides)\n", cgiter, n);
+
+  return cgiter;
+}
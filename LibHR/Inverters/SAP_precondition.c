@@ -6,6 +6,10 @@
 #include "inverters.h" 
 #include "linear_algebra.h"
 #include "memory.h"
+#include "dirac.h"
+#include "gamma_spinor.h"
+#include "hr_omp.h"
+#include <math.h>
 
 void SAP_prec(int nu, inverter_ptr inv, mshift_par *par, spinor_operator M, spinor_field *in, spinor_field *out)
 {
@@ -93,3 +97,419 @@ void SAP_prec(int nu, inverter_ptr inv, mshift_par *par, spinor_operator M, spin
 	// Free temporary spinors
 	free_spinor_field_f(res);
 }
+
+
+/*
+ * SAP on blocks of the local lattice (see inverters.h).
+ * Each thread solves the systems of whole blocks, on its own copies of the
+ * links, of the residual and of the correction of the block: for 4^4 blocks
+ * they take about 300 kB and stay in the cache during the MR iterations.
+ * The block operator is D(mass) with Dirichlet boundary conditions on the
+ * faces of the block; its diagonal part is 4+mass or, with the clover term,
+ * the two chiral blocks of Cphi_diag at each site, stored in block order.
+ */
+
+#define SAP_HALF (2 * NF) /* complex components of one chirality */
+
+struct _SAP_data
+{
+	SAP_blocks *sb;
+	int nthreads;
+	suNf *ub;              /* links of a block, for each thread */
+	suNf_spinor *wb;       /* residual, correction and workspace of a block, for each thread */
+	double complex *cdiag; /* diagonal part of D at the sites of the blocks, NULL without clover */
+	double complex phase[4];
+	spinor_field *ws;
+	int mvm;               /* applications of D */
+};
+
+static SAP_par *cur_sap = NULL;
+
+static void sap_D(SAP_par *sap, spinor_field *out, spinor_field *in)
+{
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+	Cphi(sap->mass, out, in);
+#else
+	Dphi(sap->mass, out, in);
+#endif
+	sap->data->mvm++;
+}
+
+static void SAP_alloc(SAP_par *sap)
+{
+	struct _SAP_data *d;
+	int nt = 1;
+
+	d = malloc(sizeof(*d));
+	error(d == NULL, 1, "SAP_alloc [SAP_precondition.c]", "Cannot allocate memory");
+	sap->data = d;
+
+#ifdef _OPENMP
+	nt = omp_get_max_threads();
+#endif
+	d->sb = init_SAP_blocks(sap->block);
+	d->nthreads = nt;
+	d->ub = amalloc(sizeof(suNf) * 4 * d->sb->bvol * nt, ALIGN);
+	d->wb = amalloc(sizeof(suNf_spinor) * 3 * d->sb->bvol * nt, ALIGN);
+	error(d->ub == NULL || d->wb == NULL, 1, "SAP_alloc [SAP_precondition.c]", "Cannot allocate memory");
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+	d->cdiag = amalloc(sizeof(double complex) * 2 * SAP_HALF * SAP_HALF * d->sb->nb * d->sb->bvol, ALIGN);
+	error(d->cdiag == NULL, 1, "SAP_alloc [SAP_precondition.c]", "Cannot allocate memory");
+#else
+	d->cdiag = NULL;
+#endif
+	d->ws = alloc_spinor_field_f(4, &glattice);
+	d->mvm = 0;
+}
+
+void SAP_init(SAP_par *sap, double mass)
+{
+	sap->mass = mass;
+	for(int mu = 0; mu < 4; mu++)
+		sap->block[mu] = 4;
+	sap->nu = 4;
+	sap->niter = 4;
+	sap->gcr_nkv = 16;
+	sap->data = NULL;
+}
+
+void SAP_free(SAP_par *sap)
+{
+	struct _SAP_data *d = sap->data;
+
+	if(d == NULL)
+		return;
+
+	free_SAP_blocks(d->sb);
+	afree(d->ub);
+	afree(d->wb);
+	if(d->cdiag != NULL)
+		afree(d->cdiag);
+	free_spinor_field_f(d->ws);
+	free(d);
+	sap->data = NULL;
+}
+
+/* diagonal part of the block operator for the current gauge field and mass */
+void SAP_update(SAP_par *sap)
+{
+	struct _SAP_data *d;
+
+	if(sap->data == NULL)
+		SAP_alloc(sap);
+	d = sap->data;
+
+	for(int mu = 0; mu < 4; mu++)
+		d->phase[mu] = 1.;
+#ifdef BC_T_THETA
+	d->phase[0] = eitheta[0];
+#endif
+#ifdef BC_X_THETA
+	d->phase[1] = eitheta[1];
+#endif
+#ifdef BC_Y_THETA
+	d->phase[2] = eitheta[2];
+#endif
+#ifdef BC_Z_THETA
+	d->phase[3] = eitheta[3];
+#endif
+
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+	{
+		SAP_blocks *sb = d->sb;
+		spinor_field *e = &d->ws[0];
+		spinor_field *f = &d->ws[1];
+
+		/* column j of both chiral blocks at once */
+		for(int j = 0; j < SAP_HALF; j++)
+		{
+			spinor_field_zero_f(e);
+			_MASTER_FOR(&glattice, ix)
+			{
+				double complex *v = (double complex *)_FIELD_AT(e, ix);
+				v[j] = 1.;
+				v[SAP_HALF + j] = 1.;
+			}
+			Cphi_diag(sap->mass, f, e);
+
+			_OMP_PRAGMA(_omp_parallel)
+			_OMP_PRAGMA(_omp_for)
+			for(int i = 0; i < sb->nb * sb->bvol; i++)
+			{
+				double complex *v = (double complex *)_FIELD_AT(f, sb->site[i]);
+				double complex *A = d->cdiag + 2 * SAP_HALF * SAP_HALF * i;
+				for(int a = 0; a < SAP_HALF; a++)
+				{
+					A[a * SAP_HALF + j] = v[a];
+					A[(SAP_HALF + a) * SAP_HALF + j] = v[SAP_HALF + a];
+				}
+			}
+		}
+	}
+#endif
+}
+
+/* out = D_b in on the block b, with the links u of the block */
+static void block_D(SAP_par *sap, int b, suNf *u, suNf_spinor *out, suNf_spinor *in)
+{
+	struct _SAP_data *d = sap->data;
+	SAP_blocks *sb = d->sb;
+	const double m4 = 4. + sap->mass;
+	suNf_spinor chi, gchi;
+
+	for(int n = 0; n < sb->bvol; n++)
+	{
+		if(d->cdiag != NULL)
+		{
+			const double complex *A = d->cdiag + 2 * SAP_HALF * SAP_HALF * (b * sb->bvol + n);
+			double complex *o = (double complex *)(out + n);
+			double complex *v = (double complex *)(in + n);
+			for(int a = 0; a < 2 * SAP_HALF; a++)
+			{
+				const int s0 = (a < SAP_HALF) ? 0 : SAP_HALF;
+				o[a] = 0.;
+				for(int c = 0; c < SAP_HALF; c++)
+					o[a] += A[a * SAP_HALF + c] * v[s0 + c];
+			}
+		}
+		else
+		{
+			_spinor_mul_f(out[n], m4, in[n]);
+		}
+
+		for(int mu = 0; mu < 4; mu++)
+		{
+			const int nu = sb->iup[4 * n + mu];
+			const int nd = sb->idn[4 * n + mu];
+
+			/* -1/2 (1 - g_mu) U(x,mu) in(x+mu) */
+			if(nu >= 0)
+			{
+				for(int k = 0; k < 4; k++)
+				{
+					_suNf_multiply(chi.c[k], u[4 * n + mu], in[nu].c[k]);
+				}
+				if(d->phase[mu] != 1.)
+				{
+					_spinor_mulc_f(chi, d->phase[mu], chi);
+				}
+				switch(mu)
+				{
+				case 0:
+					_spinor_g0_f(gchi, chi);
+					break;
+				case 1:
+					_spinor_g1_f(gchi, chi);
+					break;
+				case 2:
+					_spinor_g2_f(gchi, chi);
+					break;
+				default:
+					_spinor_g3_f(gchi, chi);
+					break;
+				}
+				_spinor_sub_assign_f(chi, gchi);
+				_spinor_mul_add_assign_f(out[n], -0.5, chi);
+			}
+
+			/* -1/2 (1 + g_mu) U(x-mu,mu)^dag in(x-mu) */
+			if(nd >= 0)
+			{
+				for(int k = 0; k < 4; k++)
+				{
+					_suNf_inverse_multiply(chi.c[k], u[4 * nd + mu], in[nd].c[k]);
+				}
+				if(d->phase[mu] != 1.)
+				{
+					_spinor_mulc_f(chi, conj(d->phase[mu]), chi);
+				}
+				switch(mu)
+				{
+				case 0:
+					_spinor_g0_f(gchi, chi);
+					break;
+				case 1:
+					_spinor_g1_f(gchi, chi);
+					break;
+				case 2:
+					_spinor_g2_f(gchi, chi);
+					break;
+				default:
+					_spinor_g3_f(gchi, chi);
+					break;
+				}
+				_spinor_add_assign_f(chi, gchi);
+				_spinor_mul_add_assign_f(out[n], -0.5, chi);
+			}
+		}
+	}
+}
+
+/* niter MR iterations on D_b e = r, starting from e = 0; r is overwritten by the residual */
+static void block_MR(SAP_par *sap, int b, suNf *u, suNf_spinor *r, suNf_spinor *e, suNf_spinor *q)
+{
+	const int n = sap->data->sb->bvol * 4 * NF;
+	double complex *rv = (double complex *)r;
+	double complex *ev = (double complex *)e;
+	double complex *qv = (double complex *)q;
+
+	for(int i = 0; i < n; i++)
+		ev[i] = 0.;
+
+	for(int it = 0; it < sap->niter; it++)
+	{
+		double qq = 0.;
+		double complex qr = 0., alpha;
+
+		block_D(sap, b, u, q, r);
+		for(int i = 0; i < n; i++)
+		{
+			qq += creal(qv[i]) * creal(qv[i]) + cimag(qv[i]) * cimag(qv[i]);
+			qr += conj(qv[i]) * rv[i];
+		}
+		if(qq == 0.)
+			break;
+		alpha = qr / qq;
+		for(int i = 0; i < n; i++)
+		{
+			ev[i] += alpha * rv[i];
+			rv[i] -= alpha * qv[i];
+		}
+	}
+}
+
+/*
+ * out = K in, with nu cycles of the Schwarz alternating procedure:
+ * for each colour the block systems D_b e_b = (in - D out)|_b are solved
+ * approximately and out += e.
+ * Returns the number of applications of D.
+ */
+int SAP_block_prec(SAP_par *sap, spinor_field *in, spinor_field *out)
+{
+	struct _SAP_data *d;
+	SAP_blocks *sb;
+	spinor_field *r, *q;
+	int mvm0;
+
+	if(sap->data == NULL)
+		SAP_update(sap);
+	d = sap->data;
+	sb = d->sb;
+	error(in->type != &glattice || out->type != &glattice, 1, "SAP_block_prec [SAP_precondition.c]",
+	      "Only glattice is supported");
+
+	r = &d->ws[0];
+	q = &d->ws[1];
+	mvm0 = d->mvm;
+
+	spinor_field_copy_f(r, in);
+	spinor_field_zero_f(out);
+
+	for(int cycle = 0; cycle < sap->nu; cycle++)
+	{
+		for(int col = 0; col < 2; col++)
+		{
+			_OMP_PRAGMA(_omp_parallel)
+			{
+				int tid = 0;
+#ifdef _OPENMP
+				tid = omp_get_thread_num();
+#endif
+				suNf *u = d->ub + 4 * sb->bvol * tid;
+				suNf_spinor *rb = d->wb + 3 * sb->bvol * tid;
+				suNf_spinor *eb = rb + sb->bvol;
+				suNf_spinor *qb = eb + sb->bvol;
+
+				_OMP_PRAGMA(_omp_for)
+				for(int kb = 0; kb < sb->ncblk[col]; kb++)
+				{
+					const int b = sb->cblk[col][kb];
+					const int *site = sb->site + b * sb->bvol;
+
+					for(int n = 0; n < sb->bvol; n++)
+					{
+						for(int mu = 0; mu < 4; mu++)
+							u[4 * n + mu] = *pu_gauge_f(site[n], mu);
+						rb[n] = *_FIELD_AT(r, site[n]);
+					}
+
+					block_MR(sap, b, u, rb, eb, qb);
+
+					for(int n = 0; n < sb->bvol; n++)
+					{
+						suNf_spinor *s = _FIELD_AT(out, site[n]);
+						_spinor_add_assign_f(*s, eb[n]);
+					}
+				}
+			}
+
+			/* new residual, not needed after the last colour */
+			if(cycle < sap->nu - 1 || col == 0)
+			{
+				sap_D(sap, q, out);
+				spinor_field_sub_f(r, in, q);
+			}
+		}
+	}
+
+	return d->mvm - mvm0;
+}
+
+static void sap_prec(spinor_field *out, spinor_field *in)
+{
+	SAP_block_prec(cur_sap, in, out);
+}
+
+/* for the even/odd preconditioned operator: the even part of K (in,0) */
+static void sap_prec_eo(spinor_field *out, spinor_field *in)
+{
+	struct _SAP_data *d = cur_sap->data;
+	spinor_field *r = &d->ws[2];
+	spinor_field *z = &d->ws[3];
+	spinor_field r_e, r_o, z_e;
+
+	r_e = *r;
+	r_e.type = &glat_even;
+	r_o = *r;
+	r_o.type = &glat_odd;
+	r_o.ptr = r->ptr + glat_odd.master_shift;
+	spinor_field_copy_f(&r_e, in);
+	spinor_field_zero_f(&r_o);
+
+	SAP_block_prec(cur_sap, r, z);
+
+	z_e = *z;
+	z_e.type = &glat_even;
+	spinor_field_copy_f(out, &z_e);
+}
+
+/*
+ * M out = in, M = D(mass) on glattice or the even/odd preconditioned
+ * D(mass) on glat_even; out is used as initial guess.
+ * The SAP_par is taken from par->add_par.
+ * Returns the number of applications of M.
+ */
+int SAP_GCR(mshift_par *par, spinor_operator M, spinor_field *in, spinor_field *out)
+{
+	SAP_par *sap = (SAP_par *)par->add_par;
+	GCR_par gpar;
+	int cgiter;
+
+	error(sap == NULL, 1, "SAP_GCR [SAP_precondition.c]", "The SAP parameters must be given in add_par");
+	error(par->n != 1 || par->shift[0] != 0., 1, "SAP_GCR [SAP_precondition.c]", "Only one vanishing shift is supported");
+	error(in->type != &glattice && in->type != &glat_even, 1, "SAP_GCR [SAP_precondition.c]",
+	      "Only glattice and glat_even are supported");
+
+	SAP_update(sap);
+	sap->data->mvm = 0;
+	cur_sap = sap;
+
+	gpar.err2 = par->err2;
+	gpar.max_iter = par->max_iter;
+	gpar.nkv = sap->gcr_nkv;
+	cgiter = GCR(&gpar, M, (in->type == &glattice) ? &sap_prec : &sap_prec_eo, in, out);
+
+	lprintf("INVERTER", 10, "SAP_GCR: MVM = %d (outer %d)\n", cgiter + sap->data->mvm, cgiter);
+
+	return cgiter;
+}
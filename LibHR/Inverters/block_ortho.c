@@ -0,0 +1,97 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *   
+* All rights reserved.                                                      * 
+\***************************************************************************/
+
+#include "inverters.h"
+#include <math.h>
+
+/*
+ * Orthonormalisation of a block of n vectors v_i, given their Gram matrix
+ * g[i*n+j] = <v_i,v_j> (row major, overwritten).
+ * Pivoted Cholesky factorisation: at each step the vector with the largest
+ * relative norm orthogonal to the ones already accepted is taken, and the
+ * remaining vectors are dropped when this relative squared norm is below
+ * tol. This removes (almost) linearly dependent vectors from a block.
+ * On return t[i*n+j] holds the coefficients of the orthonormal vectors
+ *   w_j = sum_i t[i*n+j] v_i ,  j < s
+ * and the number s <= n of orthonormal vectors is returned.
+ */
+int block_orthonormalize(int n, double complex *g, double tol, double complex *t)
+{
+  int i, j, k, p, s, piv[n];
+  double d0[n], best, ratio;
+  double complex l[n * n], u[n * n];
+
+  for (i = 0; i < n; ++i)
+  {
+    piv[i] = i;
+    d0[i] = creal(g[i * n + i]);
+  }
+  for (i = 0; i < n * n; ++i)
+  {
+    l[i] = 0.;
+    t[i] = 0.;
+  }
+
+  /* g[piv,piv] = l l^dagger, l[a*n+k] with a in piv[k..n-1] */
+  for (s = 0; s < n; ++s)
+  {
+    best = 0.;
+    p = -1;
+    for (k = s; k < n; ++k)
+    {
+      const int a = piv[k];
+      if (d0[a] <= 0.)
+        continue;
+      ratio = creal(g[a * n + a]) / d0[a];
+      if (ratio > best)
+      {
+        best = ratio;
+        p = k;
+      }
+    }
+    if (p < 0 || best < tol)
+      break;
+
+    k = piv[s];
+    piv[s] = piv[p];
+    piv[p] = k;
+
+    const int a = piv[s];
+    const double lss = sqrt(creal(g[a * n + a]));
+    l[a * n + s] = lss;
+    for (k = s + 1; k < n; ++k)
+    {
+      const int b = piv[k];
+      l[b * n + s] = g[b * n + a] / lss;
+    }
+    /* Schur complement */
+    for (k = s + 1; k < n; ++k)
+    {
+      const int b = piv[k];
+      for (j = s + 1; j < n; ++j)
+      {
+        const int c = piv[j];
+        g[b * n + c] -= l[b * n + s] * conj(l[c * n + s]);
+      }
+    }
+  }
+
+  /* v_piv = w u with u[k*n+j] = conj(l[piv[j]*n+k]) upper triangular,
+     then t = u^-1 on the rows of the accepted vectors */
+  for (j = 0; j < s; ++j)
+  {
+    for (i = j; i >= 0; --i)
+    {
+      double complex sum = (i == j) ? 1. : 0.;
+      for (k = i + 1; k <= j; ++k)
+        sum -= conj(l[piv[k] * n + i]) * u[k * n + j];
+      u[i * n + j] = sum / conj(l[piv[i] * n + i]);
+    }
+    for (i = 0; i <= j; ++i)
+      t[piv[i] * n + j] = u[i * n + j];
+  }
+
+  return s;
+}
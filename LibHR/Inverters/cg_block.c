@@ -0,0 +1,221 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *   
+* All rights reserved.                                                      * 
+\***************************************************************************/
+
+#include "inverters.h"
+#include "linear_algebra.h"
+#include "communications.h"
+#include "memory.h"
+#include "logger.h"
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+/* relative squared norm below which a search direction is dropped */
+#define BLOCK_DEFLATION_TOL 1.e-12
+
+/*
+ * Block CG for n right-hand sides sharing one Krylov space:
+ * (M-par->shift[0]) out[k] = in[k], k<n, with M hermitian and positive.
+ * out is used as initial guess.
+ *
+ * The s<=n search directions P are kept M-orthonormal, P^dag M P = 1:
+ * they are built from the residuals with a pivoted Cholesky factorisation
+ * (block_orthonormalize) which drops the directions that have become
+ * linearly dependent, so the block cannot break down.
+ * At each step M is applied once to the block of residuals, and all the
+ * scalar products are computed in a single sweep and a single global sum:
+ *   S = M R
+ *   [P Q R]^dag [R S] ,  Q = M P
+ *   beta = -Q^dag R
+ *   P' = (R + P beta) T ,  Q' = (S + Q beta) T ,  T from P'^dag Q' = 1
+ *   alpha = P'^dag R
+ *   X += P' alpha ,  R -= Q' alpha
+ */
+static int cg_block_core(short int *valid, mshift_par *par, spinor_operator_block M, spinor_field *in, spinor_field *out, int n)
+{
+  spinor_field *p, *q, *r, *sv, *z, *lhs;
+  double complex *g, *beta, *alpha, *zr, *zq, *t, *tmp;
+  double innorm2[n];
+  const double shift = par->shift[0];
+  int i, j, k, s, ns, cgiter;
+  unsigned short notconverged;
+
+  /* allocate spinors fields and the small matrices */
+  p = alloc_spinor_field_f(5 * n, in->type);
+  q = p + n;
+  r = q + n;
+  sv = r + n;
+  z = sv + n;
+  lhs = malloc(sizeof(spinor_field) * 3 * n);
+
+  g = malloc(sizeof(double complex) * (6 * n * n + 6 * n * n));
+  beta = g + 6 * n * n;
+  alpha = beta + n * n;
+  zr = alpha + n * n;
+  zq = zr + n * n;
+  t = zq + n * n;
+  tmp = t + n * n;
+
+  /* init recursion: R = in - M out */
+  cgiter = 0;
+  M(sv, out, n);
+  cgiter += n;
+  for (k = 0; k < n; ++k)
+  {
+    innorm2[k] = spinor_field_sqnorm_f(&in[k]);
+    spinor_field_mul_add_assign_f(&sv[k], -shift, &out[k]);
+    spinor_field_sub_f(&r[k], &in[k], &sv[k]);
+  }
+  s = 0;
+
+  do
+  {
+    M(sv, r, n);
+    cgiter += n;
+    if (shift != 0.)
+      for (k = 0; k < n; ++k)
+        spinor_field_mul_add_assign_f(&sv[k], -shift, &r[k]);
+
+    /* g = [P Q R]^dag [R S], ns = 2s+n rows of 2n columns */
+    ns = 2 * s + n;
+    for (i = 0; i < s; ++i)
+    {
+      lhs[i] = p[i];
+      lhs[s + i] = q[i];
+    }
+    for (i = 0; i < n; ++i)
+      lhs[2 * s + i] = r[i];
+    spinor_field_block_prod_local_f(g, lhs, ns, r, 2 * n);
+#ifdef WITH_MPI
+    global_sum((double *)g, 2 * ns * 2 * n);
+#endif
+#define _PR(i, j) g[(i) * 2 * n + (j)]
+#define _PS(i, j) g[(i) * 2 * n + n + (j)]
+#define _QR(i, j) g[(s + (i)) * 2 * n + (j)]
+#define _RR(i, j) g[(2 * s + (i)) * 2 * n + (j)]
+#define _RS(i, j) g[(2 * s + (i)) * 2 * n + n + (j)]
+
+    /* check convergence of vectors */
+    notconverged = 0;
+    for (k = 0; k < n; ++k)
+      if (creal(_RR(k, k)) > par->err2 * innorm2[k])
+        notconverged++;
+    if (!notconverged)
+      break;
+
+    /* beta = -Q^dag R, new directions Z = R + P beta, M Z = S + Q beta */
+    for (i = 0; i < s; ++i)
+      for (j = 0; j < n; ++j)
+        beta[i * n + j] = -_QR(i, j);
+    /* zr = Z^dag R = R^dag R + beta^dag P^dag R */
+    /* zq = Z^dag M Z = R^dag S + R^dag Q beta + beta^dag P^dag S + beta^dag P^dag Q beta */
+    for (i = 0; i < n; ++i)
+      for (j = 0; j < n; ++j)
+      {
+        double complex a = _RR(i, j), b = _RS(i, j);
+        for (k = 0; k < s; ++k)
+        {
+          a += conj(beta[k * n + i]) * _PR(k, j);
+          b += conj(_QR(k, i)) * beta[k * n + j] + conj(beta[k * n + i]) * _PS(k, j);
+        }
+        zr[i * n + j] = a;
+        zq[i * n + j] = b;
+      }
+    /* P^dag Q = 1 */
+    for (i = 0; i < n; ++i)
+      for (j = 0; j < n; ++j)
+        for (k = 0; k < s; ++k)
+          zq[i * n + j] += conj(beta[k * n + i]) * beta[k * n + j];
+#undef _PR
+#undef _PS
+#undef _QR
+#undef _RR
+#undef _RS
+
+    for (k = 0; k < n; ++k)
+    {
+      spinor_field_copy_f(&z[k], &r[k]);
+    }
+    spinor_field_block_mul_add_assign_f(z, n, p, s, beta);
+    spinor_field_block_mul_add_assign_f(sv, n, q, s, beta);
+
+    /* M-orthonormalise the new directions */
+    s = block_orthonormalize(n, zq, BLOCK_DEFLATION_TOL, t);
+    if (s == 0)
+      break;
+    for (i = 0; i < n; ++i)
+      for (j = 0; j < s; ++j)
+        tmp[i * s + j] = t[i * n + j];
+    spinor_field_block_mul_f(p, s, z, n, tmp);
+    spinor_field_block_mul_f(q, s, sv, n, tmp);
+
+    /* alpha = T^dag Z^dag R */
+    for (i = 0; i < s; ++i)
+      for (j = 0; j < n; ++j)
+      {
+        double complex a = 0.;
+        for (k = 0; k < n; ++k)
+          a += conj(t[k * n + i]) * zr[k * n + j];
+        alpha[i * n + j] = a;
+      }
+    spinor_field_block_mul_add_assign_f(out, n, p, s, alpha);
+    for (i = 0; i < s * n; ++i)
+      tmp[i] = -alpha[i];
+    spinor_field_block_mul_add_assign_f(r, n, q, s, tmp);
+  } while ((par->max_iter == 0 || cgiter < par->max_iter * n));
+
+  /* test results */
+  M(sv, out, n);
+  cgiter += n;
+  for (k = 0; k < n; ++k)
+  {
+    double norm;
+    spinor_field_mul_add_assign_f(&sv[k], -shift, &out[k]);
+    spinor_field_sub_assign_f(&sv[k], &in[k]);
+    norm = spinor_field_sqnorm_f(&sv[k]) / innorm2[k];
+    valid[k] = 1;
+    if (fabs(norm) > par->err2)
+    {
+      valid[k] = 0;
+      lprintf("INVERTER", 30, "CG_block failed on vect %d: err2 = %1.8e > %1.8e\n", k, norm, par->err2);
+    }
+    else
+    {
+      lprintf("INVERTER", 20, "CG_block inversion: err2 = %1.8e < %1.8e\n", norm, par->err2);
+    }
+  }
+
+  /* free memory */
+  free_spinor_field_f(p);
+  free(lhs);
+  free(g);
+
+  return cgiter;
+}
+
+int cg_block(mshift_par *par, spinor_operator_block M, spinor_field *in, spinor_field *out, int n)
+{
+  int cgiter, rep = 0;
+  short int valid[n];
+  int notconverged;
+
+  assert(par->n == 1);
+
+  cgiter = 0;
+  do
+  {
+    cgiter += cg_block_core(valid, par, M, in, out, n);
+    notconverged = 0;
+    for (int k = 0; k < n; ++k)
+      if (!valid[k])
+        notconverged++;
+    if (notconverged && (++rep) % 5 == 0)
+      lprintf("INVERTER", -10, "CG_block recursion = %d (precision too high?)\n", rep);
+  } while (notconverged);
+
+  lprintf("INVERTER", 10, "CG_block: MVM = %d (%d right-hand sides)\n", cgiter, n);
+
+  return cgiter;
+}
@@ -0,0 +1,209 @@
+/***************************************************************************\
+ * Copyright (c) 2008, Claudio Pica                                         *
+ * All rights reserved.                                                     *
+ \***************************************************************************/
+
+#include "inverters.h"
+#include "linear_algebra.h"
+#include <stdlib.h>
+#include <math.h>
+#include "global.h"
+#include "memory.h"
+#include "utils.h"
+#include "logger.h"
+#include "error.h"
+#include "communications.h"
+
+#define CG_HALF_DELTA 0.1      /* reliable update when |r| has dropped by this factor */
+#define CG_HALF_MAX_PREC 1.e-10 /* smallest relative err2 asked to the single precision level */
+#define CG_HALF_STAGNATE 3     /* reliable updates without progress before giving up */
+
+/* Re <p, (H-s) p> */
+static double half_pAp(spinor_field_half *p, spinor_field_half *Ap, float s)
+{
+  double pAp = 0.;
+  _TWO_SPINORS_FOR_SUM(p, Ap, pAp)
+  {
+    suNf_spinor_flt sp, sap;
+    double k;
+    _spinor_half2flt(sp, *_SPINOR_PTR(p));
+    _spinor_half2flt(sap, *_SPINOR_PTR(Ap));
+    _spinor_mul_add_assign_f(sap, -s, sp);
+    _spinor_prod_re_f(k, sp, sap);
+    pAp += k;
+  }
+  global_sum(&pAp, 1);
+  return pAp;
+}
+
+/* x += alpha p ,  r -= alpha (H-s) p ; returns |r|^2 */
+static double half_update(spinor_field_flt *x, spinor_field_flt *r, spinor_field_half *p, spinor_field_half *Ap, float alpha, float s)
+{
+  double rr = 0.;
+  _TWO_SPINORS_MATCHING(p, Ap);
+  _TWO_SPINORS_FOR_SUM(x, r, rr)
+  {
+    suNf_spinor_flt sp, sap;
+    double k;
+    _spinor_half2flt(sp, *_SPINOR_PTR(p));
+    _spinor_half2flt(sap, *_SPINOR_PTR(Ap));
+    _spinor_mul_add_assign_f(sap, -s, sp);
+    _spinor_mul_add_assign_f(*_SPINOR_PTR(x), alpha, sp);
+    _spinor_mul_add_assign_f(*_SPINOR_PTR(r), -alpha, sap);
+    _spinor_prod_re_f(k, *_SPINOR_PTR(r), *_SPINOR_PTR(r));
+    rr += k;
+  }
+  global_sum(&rr, 1);
+  return rr;
+}
+
+/* p = r + beta p */
+static void half_dir(spinor_field_half *p, spinor_field_flt *r, float beta)
+{
+  _TWO_SPINORS_FOR(p, r)
+  {
+    suNf_spinor_flt sp;
+    _spinor_half2flt(sp, *_SPINOR_PTR(p));
+    _spinor_mul_f(sp, beta, sp);
+    _spinor_add_assign_f(sp, *_SPINOR_PTR(r));
+    _spinor_flt2half(*_SPINOR_PTR(p), sp);
+  }
+}
+
+/*
+ * (F-s) x = b to relative err2, starting from x = 0.
+ * p and (H-s) p are half precision, x and r single precision;
+ * r is recomputed with F when it has dropped by CG_HALF_DELTA
+ * since the last recomputation.
+ * Returns the number of applications of H, those of F are added to fiter.
+ */
+static int cg_half_core(int *fiter, float s, spinor_operator_flt F, spinor_operator_half H, spinor_field_flt *b, spinor_field_flt *x, double err2, int max_iter)
+{
+  spinor_field_flt *r, *Fx;
+  spinor_field_half *p, *Ap;
+  double bnorm2, rnorm2, rnew2, rmax2, rtrue2;
+  double alpha, beta;
+  int hiter = 0, stall = 0;
+
+  r = alloc_spinor_field_f_flt(2, b->type);
+  Fx = r + 1;
+  p = alloc_spinor_field_f_half(2, b->type);
+  Ap = p + 1;
+
+  spinor_field_zero_f_flt(x);
+  spinor_field_copy_f_flt(r, b);
+  assign_s2sh(p, r);
+  bnorm2 = rnorm2 = rmax2 = rtrue2 = spinor_field_sqnorm_f_flt(b);
+
+  while (rnorm2 > err2 * bnorm2 && (max_iter == 0 || hiter < max_iter))
+  {
+    H(Ap, p);
+    ++hiter;
+    alpha = rnorm2 / half_pAp(p, Ap, s);
+    rnew2 = half_update(x, r, p, Ap, (float)alpha, s);
+
+    lprintf("INVERTER", 40, "cg_half iter %d res2 = %1.8e\n", hiter, rnew2 / bnorm2);
+
+    if (rnew2 < CG_HALF_DELTA * CG_HALF_DELTA * rmax2 || rnew2 < err2 * bnorm2)
+    {
+      /* reliable update */
+      F(Fx, x);
+      ++(*fiter);
+      spinor_field_mul_add_assign_f_flt(Fx, -s, x);
+      spinor_field_sub_f_flt(r, b, Fx);
+      rnew2 = spinor_field_sqnorm_f_flt(r);
+      lprintf("INVERTER", 30, "cg_half reliable update iter %d res2 = %1.8e\n", hiter, rnew2 / bnorm2);
+      if (rnew2 < rtrue2)
+      {
+        stall = 0;
+      }
+      else if (++stall >= CG_HALF_STAGNATE)
+      {
+        break;
+      }
+      rmax2 = rtrue2 = rnew2;
+    }
+
+    beta = rnew2 / rnorm2;
+    rnorm2 = rnew2;
+    half_dir(p, r, (float)beta);
+  }
+
+  free_spinor_field_f_flt(r);
+  free_spinor_field_f_half(p);
+
+  return hiter;
+}
+
+/* cg with half precision Krylov vectors, single precision reliable updates
+ * and double precision defect correction */
+int cg_half(mshift_par *par, spinor_operator M, spinor_operator_flt F, spinor_operator_half H, spinor_field *in, spinor_field *out)
+{
+  spinor_field *res, *tmp;
+  spinor_field_flt *b_flt, *x_flt;
+  double innorm2, rnorm2, oldnorm2, norm, err2;
+  int hiter = 0, fiter = 0, diter = 0;
+
+  error(par->n != 1, 1, "cg_half [cg_half.c]", "Only one shift is supported");
+  _TWO_SPINORS_MATCHING(in, out);
+
+  innorm2 = spinor_field_sqnorm_f(in);
+  if (innorm2 == 0.)
+  {
+    spinor_field_zero_f(out);
+    return 0;
+  }
+
+  res = alloc_spinor_field_f(2, in->type);
+  tmp = res + 1;
+  b_flt = alloc_spinor_field_f_flt(2, in->type);
+  x_flt = b_flt + 1;
+
+  oldnorm2 = -1.;
+  for (;;)
+  {
+    /* residual in double precision */
+    M(tmp, out);
+    ++diter;
+    spinor_field_mul_add_assign_f(tmp, -par->shift[0], out);
+    spinor_field_sub_f(res, in, tmp);
+    rnorm2 = spinor_field_sqnorm_f(res);
+    lprintf("INVERTER", 30, "cg_half defect correction %d res2 = %1.8e\n", diter, rnorm2 / innorm2);
+
+    if (rnorm2 < par->err2 * innorm2)
+      break;
+    if (par->max_iter != 0 && hiter >= par->max_iter)
+      break;
+    if (oldnorm2 > 0. && rnorm2 >= oldnorm2)
+      break;
+    oldnorm2 = rnorm2;
+
+    /* correction in lower precision */
+    norm = sqrt(rnorm2);
+    spinor_field_mul_f(res, 1. / norm, res);
+    assign_sd2s(b_flt, res);
+    err2 = 0.9 * par->err2 * innorm2 / rnorm2;
+    if (err2 < CG_HALF_MAX_PREC)
+      err2 = CG_HALF_MAX_PREC;
+    hiter += cg_half_core(&fiter, (float)par->shift[0], F, H, b_flt, x_flt, err2, (par->max_iter != 0) ? par->max_iter - hiter : 0);
+
+    assign_s2sd(tmp, x_flt);
+    spinor_field_mul_add_assign_f(out, norm, tmp);
+  }
+
+  if (rnorm2 > par->err2 * innorm2)
+  {
+    lprintf("INVERTER", 30, "cg_half failed: err2 = %1.8e > %1.8e\n", rnorm2 / innorm2, par->err2);
+  }
+  else
+  {
+    lprintf("INVERTER", 20, "cg_half inversion: err2 = %1.8e < %1.8e\n", rnorm2 / innorm2, par->err2);
+  }
+
+  free_spinor_field_f(res);
+  free_spinor_field_f_flt(b_flt);
+
+  lprintf("INVERTER", 10, "cg_half: MVM = %d (half) %d (single) %d (double)\n", hiter, fiter, diter);
+
+  return hiter + fiter + diter;
+}
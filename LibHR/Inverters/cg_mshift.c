@@ -87,21 +87,18 @@ static int cg_mshift_core(short int *sflags, mshift_par *par, spinor_operator M,
         spinor_field_mul_add_assign_f(&out[i],-omega*z3[i]/z2[i],&p[i]);
       }
     }
-    spinor_field_mul_add_assign_f(r,omega,Mk);
-    lambda=spinor_field_sqnorm_f(r);
+    lambda=spinor_field_mul_add_assign_sqnorm_f(r,omega,Mk);
     gamma=lambda/delta;
     delta=lambda;
 
-    spinor_field_mul_f(k,gamma,k);
-    spinor_field_add_assign_f(k,r);
+    spinor_field_xpay_f(k,gamma,r);
     notconverged=0; /* assume that all vectors have converged */
     for (i=0; i<(par->n); ++i) {
       /* check convergence of vectors */
       if(delta*z3[i]*z3[i]<par->err2*innorm2) sflags[i]=0; 
       if(sflags[i]){
         notconverged++;
-        spinor_field_mul_f(&p[i],gamma*z3[i]*z3[i]/(z2[i]*z2[i]),&p[i]);
-        spinor_field_mul_add_assign_f(&p[i],z3[i],r);
+        spinor_field_lc_f(&p[i],gamma*z3[i]*z3[i]/(z2[i]*z2[i]),&p[i],z3[i],r);
         z1[i]=z2[i];
         z2[i]=z3[i];
       }
@@ -191,5 +188,6 @@ int cg_mshift(mshift_par *par, spinor_operator M, spinor_field *in, spinor_field
   lprintf("TIMING",0,"cg_mshift %.6f s\n",1.*etime.tv_sec+1.e-6*etime.tv_usec);
   #endif
 
+  cost_cnt.iter += cgiter;
   return cgiter;
 }
@@ -85,21 +85,18 @@ static int cg_mshift_core(short int *sflags, mshift_par *par, spinor_operator M,
         spinor_field_mul_add_assign_f(&out[i],-omega*z3[i]/z2[i],&p[i]);
       }
     }
-    spinor_field_mul_add_assign_f(r,omega,Mk);
-    lambda=spinor_field_sqnorm_f(r);
+    lambda=spinor_field_mul_add_assign_sqnorm_f(r,omega,Mk);
     gamma=lambda/delta;
     delta=lambda;
 
-    spinor_field_mul_f(k,gamma,k);
-    spinor_field_add_assign_f(k,r);
+    spinor_field_xpay_f(k,gamma,r);
     notconverged=0; /* assume that all vectors have converged */
     for (i=0; i<(par->n); ++i) {
       /* check convergence of vectors */
       if(delta*z3[i]*z3[i]<par->err2*innorm2) sflags[i]=0; 
       if(sflags[i]){
         notconverged++;
-        spinor_field_mul_f(&p[i],gamma*z3[i]*z3[i]/(z2[i]*z2[i]),&p[i]);
-        spinor_field_mul_add_assign_f(&p[i],z3[i],r);
+        spinor_field_lc_f(&p[i],gamma*z3[i]*z3[i]/(z2[i]*z2[i]),&p[i],z3[i],r);
         z1[i]=z2[i];
         z2[i]=z3[i];
       }
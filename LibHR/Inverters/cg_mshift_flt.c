@@ -15,8 +15,10 @@
 #include <assert.h>
 
 /*
- * performs the multi-shifted CG inversion:
+ * single precision multi-shifted CG with zero initial guess:
  * out[i] = (M-(par->shift[i]))^-1 in
+ * a shift is dropped from the recursion (sflags[i]=0) as soon as it has
+ * converged, after that its solution and search vector are not updated.
  * returns the number of cg iterations done.
  */
 static int cg_mshift_flt_core(short int *sflags, mshift_par *par, spinor_operator_flt M, spinor_field_flt *in, spinor_field_flt *out)
@@ -52,28 +54,16 @@ static int cg_mshift_flt_core(short int *sflags, mshift_par *par, spinor_operato
   omega = 1.;
   gamma = 0.;
   innorm2 = spinor_field_sqnorm_f_flt(in);
-  if (par->n == 1)
-  { /* non multishift case */
-    /* use out[0] as initial guess */
-    M(Mk, &out[0]);
-    ++cgiter;
-    spinor_field_mul_add_assign_f_flt(Mk, ((float)(-par->shift[0])), &out[0]);
-    spinor_field_sub_f_flt(r, in, Mk);
-  }
-  else
-  { /* initial guess = 0 for multishift */
-    spinor_field_copy_f_flt(r, in);
-  }
+  spinor_field_copy_f_flt(r, in);
   spinor_field_copy_f_flt(k, r);
-  delta = spinor_field_sqnorm_f_flt(r);
+  delta = innorm2;
   for (i = 0; i < (par->n); ++i)
   {
     z1[i] = z2[i] = 1.;
     z3[i] = 0.;
     spinor_field_copy_f_flt(&p[i], r);
-    if (par->n != 1)
-      spinor_field_zero_f_flt(&out[i]);
-    /*    sflags[i]=1; */
+    spinor_field_zero_f_flt(&out[i]);
+    sflags[i] = 1;
   }
 
   /* cg recursion */
@@ -94,26 +84,28 @@ static int cg_mshift_flt_core(short int *sflags, mshift_par *par, spinor_operato
         spinor_field_mul_add_assign_f_flt(&out[i], ((float)(-omega * z3[i] / z2[i])), &p[i]);
       }
     }
-    spinor_field_mul_add_assign_f_flt(r, ((float)(omega)), Mk);
-    lambda = spinor_field_sqnorm_f_flt(r);
+    lambda = spinor_field_mul_add_assign_sqnorm_f_flt(r, ((float)(omega)), Mk);
     gamma = lambda / delta;
     delta = lambda;
 
-    spinor_field_mul_f_flt(k, ((float)(gamma)), k);
-    spinor_field_add_assign_f_flt(k, r);
+    spinor_field_xpay_f_flt(k, ((float)(gamma)), r);
     notconverged = 0; /* assume that all vectors have converged */
 
     for (i = 0; i < (par->n); ++i)
     {
-      if (delta * z3[i] * z3[i] > par->err2 * innorm2)
-        ++notconverged;
-      if (sflags[i])
+      if (!sflags[i])
+        continue;
+      /* drop the converged shifts */
+      if (delta * z3[i] * z3[i] < par->err2 * innorm2)
       {
-        spinor_field_mul_f_flt(&p[i], ((float)(gamma * z3[i] * z3[i] / (z2[i] * z2[i]))), &p[i]);
-        spinor_field_mul_add_assign_f_flt(&p[i], ((float)(z3[i])), r);
-        z1[i] = z2[i];
-        z2[i] = z3[i];
+        sflags[i] = 0;
+        lprintf("INVERTER", 20, "CG_mshift_flt: shift %d converged after %d iterations\n", i, cgiter + 1);
+        continue;
       }
+      ++notconverged;
+      spinor_field_lc_f_flt(&p[i], ((float)(gamma * z3[i] * z3[i] / (z2[i] * z2[i]))), &p[i], ((float)(z3[i])), r);
+      z1[i] = z2[i];
+      z2[i] = z3[i];
     }
 
     /* Uncomment this to print cg recursion parameters */
@@ -141,20 +133,24 @@ static int cg_mshift_flt_core(short int *sflags, mshift_par *par, spinor_operato
 
 /* cg mshift with single precision acceleration */
 /* results are still accurate to double precision! */
+/*
+ * All the shifts are first solved together in single precision, each one
+ * leaving the recursion when it has converged. Then each shift is refined
+ * separately by defect correction: the residual is computed in double
+ * precision and the correction is solved in single precision, until the
+ * relative residual is below par->err2.
+ */
 int cg_mshift_flt(mshift_par *par, spinor_operator M, spinor_operator_flt F, spinor_field *in, spinor_field *out)
 {
   int siter = 0, diter = 0;
   int i;
   mshift_par local_par = *par;
-  short int sflags[par->n]; /* this is used in the core routine to select which shifts to update */
-  short int loc_flags[par->n];
+  short int sflags[par->n];
   double norm[par->n];
-
   double innorm2;
-  int notconverged;
 
   spinor_field_flt *out_flt, *res_flt;
-  spinor_field *res, *res2, *tmp;
+  spinor_field *res, *tmp;
   /* check types */
   assert(par->n > 0);
   _TWO_SPINORS_MATCHING(in, &out[0]);
@@ -163,114 +159,68 @@ int cg_mshift_flt(mshift_par *par, spinor_operator M, spinor_operator_flt F, spi
   /* allocate memory for single-precision solutions and residual vectors */
   res_flt = alloc_spinor_field_f_flt(1 + par->n, in->type);
   out_flt = res_flt + 1;
-  res = alloc_spinor_field_f(3, in->type);
-  res2 = res + 1;
-  tmp = res2 + 1;
-
-  /* set all flags to 1
-   * set all out to zero execpt if par->n==1
-   */
-  for (i = 0; i < (par->n); ++i)
-  {
-    sflags[i] = 1;
-    if (par->n != 1)
-      spinor_field_zero_f(&out[i]);
-  }
+  res = alloc_spinor_field_f(2, in->type);
+  tmp = res + 1;
 
   /* compute input norm2 */
   innorm2 = spinor_field_sqnorm_f(in);
 
-  /* begin external loop */
-  do
+#define MAX_PREC 1.e-13
+  /* multishift solve in single precision */
+  if (local_par.err2 < MAX_PREC)
+    local_par.err2 = MAX_PREC;
+  assign_sd2s(res_flt, in);
+  siter += cg_mshift_flt_core(sflags, &local_par, F, res_flt, out_flt);
+  for (i = 0; i < par->n; ++i)
+    assign_s2sd(&out[i], &out_flt[i]);
+
+  /* refinement of each shift */
+  local_par.n = 1;
+  for (i = 0; i < par->n; ++i)
   {
-    int first = 1;
-    notconverged = 0;
+    int rep = 0;
+    double oldnorm = 0.;
 
-    for (i = 0; i < par->n; ++i)
+    local_par.shift = par->shift + i;
+    for (;;)
     {
-      if (sflags[i] != 0)
+      /* compute residual vector */
+      M(tmp, &out[i]);
+      ++diter;
+      spinor_field_sub_f(res, in, tmp);
+      spinor_field_mul_add_assign_f(res, par->shift[i], &out[i]);
+      norm[i] = spinor_field_sqnorm_f(res);
+      lprintf("CGDEBUG", 20, "norm %d = %e relerr=%e\n", i, norm[i], norm[i] / innorm2);
+      if (norm[i] < innorm2 * par->err2)
+        break;
+      if (rep > 0 && norm[i] > 0.5 * oldnorm)
       {
-        /* compute residual vector */
-
-        M(tmp, &out[i]);
-
-        ++diter;
-        spinor_field_sub_f(res2, in, tmp);
-        spinor_field_mul_add_assign_f(res2, par->shift[i], &out[i]);
-        /* test for convergence */
-        norm[i] = spinor_field_sqnorm_f(res2);
-        lprintf("CGDEBUG", 20, "norm %d = %e relerr=%e\n", i, norm[i], norm[i] / innorm2);
-        if (norm[i] < innorm2 * par->err2)
-        {
-          /* this shift has reached convergence */
-          sflags[i] = 0;
-          norm[i] /= innorm2;
-        }
-        else
-        {
-          /* this shift has not yet converged */
-          ++notconverged;
-          /* prepare input residual vector */
-          if (first)
-          {
-            /* we take the residual vector from the first non-converged shift */
-            first = 0;
-            local_par.err2 = norm[i] / innorm2;
-            norm[i] = sqrt(norm[i]);
-            spinor_field_mul_f(res, 1. / norm[i], res2); /* normalize input res vector */
-          }
-          else
-          {
-            /* take the scalar product of current residual vector with the 
-             * normalized first one as residual norm */
-            norm[i] = spinor_field_prod_im_f(res, res2);
-            lprintf("CGDEBUG", 20, "Im=%e check norm=%e\n", norm[i], spinor_field_sqnorm_f(res));
-            norm[i] = spinor_field_prod_re_f(res, res2);
-            /* norm[i]=sqrt(spinor_field_sqnorm_f(res2)); */
-          }
-        }
+        lprintf("INVERTER", -10, "CG_mshift_flt: no progress on shift %d, err2 = %1.8e (precision too high?)\n", i, norm[i] / innorm2);
+        break;
       }
-    }
+      oldnorm = norm[i];
 
-    if (notconverged)
-    {
-      /* Do single precision inversion */
-      assign_sd2s(res_flt, res);
-      local_par.err2 = par->err2 / local_par.err2 * 0.9;
-#define MAX_PREC 1.e-10
+      /* single precision solve for the correction */
+      local_par.err2 = par->err2 * innorm2 / norm[i] * 0.9;
       if (local_par.err2 < MAX_PREC)
         local_par.err2 = MAX_PREC;
-#undef MAX_PREC
-      /* local_par.err2=1.e-10; */
-      lprintf("CGDEBUG", 20, "err2 = %e\n", local_par.err2);
-      /* should not be needed since core do not modify flags */
-      for (i = 0; i < par->n; ++i)
-      {
-        loc_flags[i] = sflags[i]; /* set core flags */
-      }
-      siter += cg_mshift_flt_core(loc_flags, &local_par, F, res_flt, out_flt); /* save single precision iterations */
-      /* accumulate solution in double precision */
-      for (i = 0; i < par->n; ++i)
-      {
-        if (sflags[i] != 0)
-        {
-          assign_s2sd(res2, &out_flt[i]);
-          spinor_field_mul_add_assign_f(&out[i], norm[i], res2);
-        }
-      }
+      spinor_field_mul_f(res, 1. / sqrt(norm[i]), res);
+      assign_sd2s(res_flt, res);
+      siter += cg_mshift_flt_core(sflags + i, &local_par, F, res_flt, out_flt);
+      assign_s2sd(tmp, out_flt);
+      spinor_field_mul_add_assign_f(&out[i], sqrt(norm[i]), tmp);
+      ++rep;
     }
-
-  } while (notconverged);
-
-  for (i = 0; i < par->n; ++i)
-  {
-    lprintf("INVERTER", 0 * 20, "CG inversion: err2 = %1.8e < %1.8e\n", norm[i], par->err2);
+    norm[i] /= innorm2;
+    lprintf("INVERTER", 20, "CG inversion: err2 = %1.8e < %1.8e, %d refinements\n", norm[i], par->err2, rep);
   }
+#undef MAX_PREC
 
   free_spinor_field_f_flt(res_flt);
   free_spinor_field_f(res);
 
   lprintf("INVERTER", 10, "CG_mshift: MVM = %d (single) - %d (double)\n", siter, diter);
 
+  cost_cnt.iter += siter + diter;
   return siter + diter;
 }
@@ -0,0 +1,188 @@
+/***************************************************************************\
+ * Copyright (c) 2008, Claudio Pica                                         *
+ * All rights reserved.                                                     *
+ \***************************************************************************/
+
+#include "inverters.h"
+#include "linear_algebra.h"
+#include <stdlib.h>
+#include <math.h>
+#include "global.h"
+#include "memory.h"
+#include "logger.h"
+#include "error.h"
+#include "communications.h"
+
+#define CG_PIPELINED_MAX_RESTART 10
+
+/*
+ * One pass over the vectors of an iteration, with A = M - shift:
+ *   z = (n - shift w) + beta z ,  s = w + beta s ,  p = r + beta p
+ *   x += alpha p ,  r -= alpha s ,  w -= alpha z
+ * where n = M w. Returns in red the local parts of <r,r> and Re <w,r>
+ * of the updated vectors.
+ */
+static void pcg_update(spinor_field *x, spinor_field *r, spinor_field *w, spinor_field *p, spinor_field *s, spinor_field *z, spinor_field *n,
+                       double shift, double alpha, double beta, double *red)
+{
+  double rr = 0., wr = 0.;
+
+  _MASTER_FOR_SUM(x->type, ix, rr, wr)
+  {
+    suNf_spinor *sx = _FIELD_AT(x, ix);
+    suNf_spinor *sr = _FIELD_AT(r, ix);
+    suNf_spinor *sw = _FIELD_AT(w, ix);
+    suNf_spinor *sp = _FIELD_AT(p, ix);
+    suNf_spinor *ss = _FIELD_AT(s, ix);
+    suNf_spinor *sz = _FIELD_AT(z, ix);
+    suNf_spinor *sn = _FIELD_AT(n, ix);
+    double k;
+
+    _spinor_lc_f(*sz, beta, *sz, -shift, *sw);
+    _spinor_add_assign_f(*sz, *sn);
+    _spinor_lc_f(*ss, beta, *ss, 1., *sw);
+    _spinor_lc_f(*sp, beta, *sp, 1., *sr);
+    _spinor_mul_add_assign_f(*sx, alpha, *sp);
+    _spinor_mul_add_assign_f(*sr, -alpha, *ss);
+    _spinor_mul_add_assign_f(*sw, -alpha, *sz);
+
+    _spinor_prod_re_f(k, *sr, *sr);
+    rr += k;
+    _spinor_prod_re_f(k, *sw, *sr);
+    wr += k;
+  }
+
+  red[0] = rr;
+  red[1] = wr;
+}
+
+/* local parts of <r,r> and Re <w,r> */
+static void pcg_prods(spinor_field *r, spinor_field *w, double *red)
+{
+  double rr = 0., wr = 0.;
+
+  _TWO_SPINORS_FOR_SUM(r, w, rr, wr)
+  {
+    double k;
+    _spinor_prod_re_f(k, *_SPINOR_PTR(r), *_SPINOR_PTR(r));
+    rr += k;
+    _spinor_prod_re_f(k, *_SPINOR_PTR(w), *_SPINOR_PTR(r));
+    wr += k;
+  }
+
+  red[0] = rr;
+  red[1] = wr;
+}
+
+/*
+ * Pipelined CG (P. Ghysels and W. Vanroose, Parallel Computing 40 (2014) 224):
+ * the two scalar products of an iteration are summed over the processes with
+ * one non-blocking reduction, which is completed after the application of M
+ * to w. The recursively updated residual is checked at the end against the
+ * true residual, and the recursion is restarted if needed.
+ */
+int cg_pipelined(mshift_par *par, spinor_operator M, spinor_field *in, spinor_field *out)
+{
+  spinor_field *r, *w, *p, *s, *z, *n;
+  global_sum_request req;
+  double red[2];
+  double innorm2, rnorm2, gamma, delta, alpha, beta, oldgamma, oldalpha;
+  const double shift = par->shift[0];
+  int cgiter = 0, iter, restart, k;
+
+  error(par->n != 1, 1, "cg_pipelined [cg_pipelined.c]", "Only one shift is supported");
+  _TWO_SPINORS_MATCHING(in, out);
+
+  innorm2 = spinor_field_sqnorm_f(in);
+  if (innorm2 == 0.)
+  {
+    spinor_field_zero_f(out);
+    return 0;
+  }
+
+  r = alloc_spinor_field_f(6, in->type);
+  w = r + 1;
+  p = w + 1;
+  s = p + 1;
+  z = s + 1;
+  n = z + 1;
+
+  rnorm2 = innorm2;
+  iter = 0;
+  for (restart = 0; restart < CG_PIPELINED_MAX_RESTART; ++restart)
+  {
+    /* r = in - A out ,  w = A r */
+    M(w, out);
+    spinor_field_mul_add_assign_f(w, -shift, out);
+    spinor_field_sub_f(r, in, w);
+    M(w, r);
+    spinor_field_mul_add_assign_f(w, -shift, r);
+    cgiter += 2;
+    spinor_field_zero_f(p);
+    spinor_field_zero_f(s);
+    spinor_field_zero_f(z);
+
+    pcg_prods(r, w, red);
+    global_sum_start(red, 2, &req);
+
+    oldgamma = oldalpha = 1.;
+    for (k = 0;; ++k)
+    {
+      /* n = M w, overlapped with the reduction */
+      M(n, w);
+      ++cgiter;
+      global_sum_wait(&req);
+      gamma = red[0];
+      delta = red[1];
+
+      lprintf("INVERTER", 40, "cg_pipelined iter %d res2 = %1.8e\n", iter, gamma / innorm2);
+
+      if (gamma < par->err2 * innorm2)
+        break;
+      if (par->max_iter != 0 && iter >= par->max_iter)
+        break;
+
+      if (k == 0)
+      {
+        beta = 0.;
+        alpha = gamma / delta;
+      }
+      else
+      {
+        beta = gamma / oldgamma;
+        alpha = gamma / (delta - beta * gamma / oldalpha);
+      }
+
+      pcg_update(out, r, w, p, s, z, n, shift, alpha, beta, red);
+      global_sum_start(red, 2, &req);
+      oldgamma = gamma;
+      oldalpha = alpha;
+      ++iter;
+    }
+
+    /* true residual */
+    M(w, out);
+    ++cgiter;
+    spinor_field_mul_add_assign_f(w, -shift, out);
+    spinor_field_sub_f(r, in, w);
+    rnorm2 = spinor_field_sqnorm_f(r);
+    if (rnorm2 < par->err2 * innorm2 || (par->max_iter != 0 && iter >= par->max_iter))
+      break;
+    lprintf("INVERTER", 30, "cg_pipelined restart %d: err2 = %1.8e\n", restart + 1, rnorm2 / innorm2);
+  }
+
+  if (rnorm2 > par->err2 * innorm2)
+  {
+    lprintf("INVERTER", 30, "cg_pipelined failed: err2 = %1.8e > %1.8e\n", rnorm2 / innorm2, par->err2);
+  }
+  else
+  {
+    lprintf("INVERTER", 20, "cg_pipelined inversion: err2 = %1.8e < %1.8e\n", rnorm2 / innorm2, par->err2);
+  }
+
+  free_spinor_field_f(r);
+
+  lprintf("INVERTER", 10, "cg_pipelined: MVM = %d\n", cgiter);
+
+  return cgiter;
+}
@@ -3,6 +3,7 @@
 * All rights reserved.                                                      * 
 \***************************************************************************/
 
+#include "global.h"
 #include "inverters.h"
 #include "linear_algebra.h"
 #include "complex.h"
@@ -555,6 +556,7 @@ int g5QMR_mshift(mshift_par *par, spinor_operator M, spinor_field *in, spinor_fi
   free(valid);
   lprintf("INVERTER",10,"g5QMR_mshift: cgiter (mshift,tot) = %d ; %d\n",msiter,cgiter);
 
+  cost_cnt.iter += cgiter;
   return cgiter;
 }
 
@@ -0,0 +1,111 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *
+* All rights reserved.                                                      *
+\***************************************************************************/
+
+#include "inverters.h"
+#include "linear_algebra.h"
+#include "memory.h"
+#include "logger.h"
+#include <stdlib.h>
+#include <math.h>
+
+#define GCR_DEFAULT_NKV 16
+
+/*
+ * Flexible restarted GCR: M out = in, out is used as initial guess.
+ * The preconditioner prec may change from one application to the next
+ * (e.g. an inner iterative solver); if prec is NULL the residual is used.
+ * For each Krylov vector:
+ *   z = prec(r) ,  q = M z
+ *   q, z orthogonalised against the previous q's and normalised
+ *   a = <q,r> ,  out += a z ,  r -= a q
+ * At each restart the true residual is recomputed.
+ * Returns the number of applications of M.
+ */
+int GCR(GCR_par *par, spinor_operator M, spinor_operator prec, spinor_field *in, spinor_field *out)
+{
+  spinor_field *z, *q, *r;
+  double complex c;
+  double innorm2, rnorm2, norm;
+  const int nkv = (par->nkv > 0) ? par->nkv : GCR_DEFAULT_NKV;
+  int j, k, cgiter, notconverged;
+
+  innorm2 = spinor_field_sqnorm_f(in);
+  if (innorm2 == 0.)
+  {
+    spinor_field_zero_f(out);
+    return 0;
+  }
+
+  z = alloc_spinor_field_f(2 * nkv + 1, in->type);
+  q = z + nkv;
+  r = q + nkv;
+
+  cgiter = 0;
+  notconverged = 1;
+  while (notconverged)
+  {
+    /* true residual at each restart */
+    M(r, out);
+    ++cgiter;
+    spinor_field_sub_f(r, in, r);
+    rnorm2 = spinor_field_sqnorm_f(r);
+    if (rnorm2 < par->err2 * innorm2 || (par->max_iter != 0 && cgiter >= par->max_iter))
+      break;
+
+    for (k = 0; k < nkv; ++k)
+    {
+      if (prec != NULL)
+      {
+        prec(&z[k], r);
+      }
+      else
+      {
+        spinor_field_copy_f(&z[k], r);
+      }
+      M(&q[k], &z[k]);
+      ++cgiter;
+
+      for (j = 0; j < k; ++j)
+      {
+        c = -spinor_field_prod_f(&q[j], &q[k]);
+        spinor_field_mulc_add_assign_f(&q[k], c, &q[j]);
+        spinor_field_mulc_add_assign_f(&z[k], c, &z[j]);
+      }
+      norm = sqrt(spinor_field_sqnorm_f(&q[k]));
+      spinor_field_mul_f(&q[k], 1. / norm, &q[k]);
+      spinor_field_mul_f(&z[k], 1. / norm, &z[k]);
+
+      c = spinor_field_prod_f(&q[k], r);
+      spinor_field_mulc_add_assign_f(out, c, &z[k]);
+      spinor_field_mulc_add_assign_f(r, -c, &q[k]);
+      rnorm2 = spinor_field_sqnorm_f(r);
+
+      lprintf("INVERTER", 40, "GCR iter %d res2 = %1.8e\n", cgiter, rnorm2 / innorm2);
+
+      if (rnorm2 < par->err2 * innorm2)
+        break;
+      if (par->max_iter != 0 && cgiter >= par->max_iter)
+      {
+        notconverged = 0;
+        break;
+      }
+    }
+  }
+
+  if (rnorm2 > par->err2 * innorm2)
+  {
+    lprintf("INVERTER", 30, "GCR failed: err2 = %1.8e > %1.8e\n", rnorm2 / innorm2, par->err2);
+  }
+  else
+  {
+    lprintf("INVERTER", 20, "GCR inversion: err2 = %1.8e < %1.8e\n", rnorm2 / innorm2, par->err2);
+  }
+
+  free_spinor_field_f(z);
+
+  lprintf("INVERTER", 10, "GCR: MVM = %d\n", cgiter);
+
+  return cgiter;
+}
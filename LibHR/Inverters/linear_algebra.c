@@ -59,3 +59,88 @@ void _FUNC(spinor_field_copy)(_SPINOR_FIELD_TYPE *s1, _SPINOR_FIELD_TYPE *s2) {
 #undef _COMPLEX
 
 
+
+
+/* block operations, double precision */
+
+/* res[i*n2+j] = <s1[i],s2[j]> on the local lattice.
+ * The sum over processes is left to the caller, so that all the scalar
+ * products needed at one step of a block solver share one global_sum.
+ */
+void spinor_field_block_prod_local_f(double complex *res, spinor_field *s1, int n1, spinor_field *s2, int n2)
+{
+	geometry_descriptor *type = s1->type;
+
+	for (int k = 0; k < n1 * n2; k++)
+		res[k] = 0.;
+	if (n1 * n2 == 0)
+		return;
+
+	_OMP_PRAGMA(_omp_parallel)
+	{
+		double complex loc[n1 * n2];
+		for (int k = 0; k < n1 * n2; k++)
+			loc[k] = 0.;
+
+		for (int ip = 0; ip < type->local_master_pieces; ip++)
+		{
+			_OMP_PRAGMA(for nowait)
+			for (int ix = type->master_start[ip]; ix <= type->master_end[ip]; ix++)
+			{
+				for (int i = 0; i < n1; i++)
+				{
+					suNf_spinor *a = _FIELD_AT(&s1[i], ix);
+					for (int j = 0; j < n2; j++)
+					{
+						double complex z;
+						_spinor_prod_f(z, *a, *_FIELD_AT(&s2[j], ix));
+						loc[i * n2 + j] += z;
+					}
+				}
+			}
+		}
+
+		_OMP_PRAGMA(critical)
+		{
+			for (int k = 0; k < n1 * n2; k++)
+				res[k] += loc[k];
+		}
+	}
+}
+
+/* out[j] = (assign ? out[j] : 0) + sum_i c[i*n+j] in[i] */
+static void spinor_field_block_lc(spinor_field *out, int n, spinor_field *in, int m, double complex *c, int assign)
+{
+	_MASTER_FOR(out->type, ix)
+	{
+		for (int j = 0; j < n; j++)
+		{
+			suNf_spinor acc;
+			if (assign)
+			{
+				acc = *_FIELD_AT(&out[j], ix);
+			}
+			else
+			{
+				_spinor_zero_f(acc);
+			}
+			for (int i = 0; i < m; i++)
+			{
+				_spinor_mulc_add_assign_f(acc, c[i * n + j], *_FIELD_AT(&in[i], ix));
+			}
+			*_FIELD_AT(&out[j], ix) = acc;
+		}
+	}
+}
+
+/* out[j] += sum_i c[i*n+j] in[i], j<n, i<m. out and in must be different fields */
+void spinor_field_block_mul_add_assign_f(spinor_field *out, int n, spinor_field *in, int m, double complex *c)
+{
+	spinor_field_block_lc(out, n, in, m, c, 1);
+}
+
+/* out[j] = sum_i c[i*n+j] in[i], j<n, i<m. out and in must be different fields */
+void spinor_field_block_mul_f(spinor_field *out, int n, spinor_field *in, int m, double complex *c)
+{
+	spinor_field_block_lc(out, n, in, m, c, 0);
+}
@@ -0,0 +1,930 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *
+* All rights reserved.                                                      *
+\***************************************************************************/
+
+/*******************************************************************************
+ *
+ * File multigrid.c
+ *
+ * Adaptive aggregation multigrid for the Wilson(-clover) operator D(mass).
+ *
+ * Aggregates: blocks of block[0]x..xblock[3] sites of the local lattice.
+ * The coarse space on the block b is spanned by P_s w_k|b, where w_k (k<nvec)
+ * are the null-space vectors and P_s (s=0,1) the chiral projectors, so that
+ * the coarse operator Dc = R D P, R = P^dag, has 2*nvec degrees of freedom
+ * per block and only couples neighbouring blocks. It is stored as one self
+ * coupling and eight hopping matrices per block: the hopping matrices are
+ * computed from the links on the faces of the blocks, the self couplings
+ * (which contain the clover term) from applications of D to the blocks of
+ * one colour at a time. The coarse vectors have their own halo exchange of
+ * the faces of the blocks.
+ *
+ * Smoother: SAP on the same blocks (SAP_block_prec), coloured as a
+ * checkerboard. The block systems are solved approximately with a few MR
+ * iterations, block by block in parallel over the threads.
+ *
+ * Cycle: z = P Dc^-1 R r, followed by nu SAP cycles on r - D z.
+ * It preconditions a flexible GCR on D, or on the even/odd preconditioned
+ * operator by embedding the even residual into the full lattice.
+ *
+ * Setup: the w_k are obtained by inverse iteration from random vectors (or
+ * from the low modes of (g5 D)^2 computed with eva): a few SAP cycles on
+ * D w = 0 first, then setup_iter passes w <- (1 - K D) w with the current
+ * cycle K, the coarse operator being rebuilt after each pass.
+ * When the gauge field changes and reuse is set, the old w_k are refreshed
+ * with refresh_iter passes instead of repeating the whole setup.
+ *
+ *******************************************************************************/
+
+#include "global.h"
+#include "geometry.h"
+#include "inverters.h"
+#include "linear_algebra.h"
+#include "dirac.h"
+#include "update.h"
+#include "utils.h"
+#include "memory.h"
+#include "communications.h"
+#include "gamma_spinor.h"
+#include "error.h"
+#include "logger.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef WITH_MPI
+#include <mpi.h>
+#endif
+
+#define MG_NCOMP (4 * NF) /* complex components of a spinor */
+#define MG_HALF (2 * NF)  /* complex components of one chirality */
+#define MG_SETUP_SMOOTH 4 /* SAP cycles of the first setup pass */
+#define MG_COARSE_NKV 16  /* Krylov vectors of the coarse GCR */
+#define MG_EVA_KMAX 50    /* degree of the Chebyshev polynomials in eva */
+
+#define _MG_SITE(s, ix) ((double complex *)_FIELD_AT((s), (ix)))
+
+struct _mg_data
+{
+  SAP_blocks *sb;      /* the aggregates */
+  int nb, bvol, nc;    /* local blocks, sites per block, coarse dof per block */
+  int nbtot;           /* blocks of a coarse vector, halo included */
+  int *nbr;            /* nbr[8*b+2*mu]: block in direction +mu, nbr[8*b+2*mu+1]: in direction -mu */
+  int nface[4];        /* blocks on a face in direction mu */
+  int *face[4][2];     /* blocks on the lower [0] and upper [1] face */
+  int halo[4][2];      /* first halo block from the process in direction -mu [0] and +mu [1] */
+  spinor_field *w;     /* null-space vectors */
+  spinor_field *ws;    /* workspace */
+  double complex *Aself, *Ahop;
+  SAP_par sap;         /* smoother on the same blocks */
+  double complex *cv;  /* coarse vectors */
+  double complex *buf;
+  double fingerprint;  /* of the gauge field used for the setup */
+  double mass;         /* mass of the coarse operator */
+  int mvm;             /* applications of D */
+};
+
+static mg_par *cur_mg = NULL;
+
+static void mg_D(mg_par *mg, spinor_field *out, spinor_field *in)
+{
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+  Cphi(mg->mass, out, in);
+#else
+  Dphi(mg->mass, out, in);
+#endif
+  mg->data->mvm++;
+}
+
+/* (g5 D)^2, for eva */
+static void mg_H2(spinor_field *out, spinor_field *in)
+{
+  spinor_field *tmp = &cur_mg->data->ws[3];
+  mg_D(cur_mg, tmp, in);
+  spinor_field_g5_assign_f(tmp);
+  mg_D(cur_mg, out, tmp);
+  spinor_field_g5_assign_f(out);
+}
+
+/* phase of the hopping term in direction +mu, as in Dphi_ */
+static double complex hop_phase(int mu)
+{
+#ifdef BC_T_THETA
+  if (mu == 0)
+    return eitheta[0];
+#endif
+#ifdef BC_X_THETA
+  if (mu == 1)
+    return eitheta[1];
+#endif
+#ifdef BC_Y_THETA
+  if (mu == 2)
+    return eitheta[2];
+#endif
+#ifdef BC_Z_THETA
+  if (mu == 3)
+    return eitheta[3];
+#endif
+  return 1.;
+}
+
+/*******************************************************************************
+ * Blocks
+ *******************************************************************************/
+
+static int block_index(struct _mg_data *d, int *bc)
+{
+  return ((bc[0] * d->sb->nbl[1] + bc[1]) * d->sb->nbl[2] + bc[2]) * d->sb->nbl[3] + bc[3];
+}
+
+static void block_coords(struct _mg_data *d, int b, int *bc)
+{
+  for (int mu = 3; mu >= 0; mu--)
+  {
+    bc[mu] = b % d->sb->nbl[mu];
+    b /= d->sb->nbl[mu];
+  }
+}
+
+static void mg_init_blocks(mg_par *mg)
+{
+  struct _mg_data *d = mg->data;
+  const int np[4] = {NP_T, NP_X, NP_Y, NP_Z};
+  int bc[4], k[2];
+
+  d->sb = init_SAP_blocks(mg->block);
+  d->nb = d->sb->nb;
+  d->bvol = d->sb->bvol;
+  d->nc = 2 * mg->nvec;
+
+  /* neighbours, faces and halo blocks */
+  d->nbr = malloc(sizeof(int) * 8 * d->nb);
+  d->nbtot = d->nb;
+  for (int mu = 0; mu < 4; mu++)
+  {
+    d->nface[mu] = d->nb / d->sb->nbl[mu];
+    d->face[mu][0] = malloc(sizeof(int) * 2 * d->nface[mu]);
+    d->face[mu][1] = d->face[mu][0] + d->nface[mu];
+    if (np[mu] > 1)
+    {
+      d->halo[mu][0] = d->nbtot;
+      d->halo[mu][1] = d->nbtot + d->nface[mu];
+      d->nbtot += 2 * d->nface[mu];
+    }
+    else
+    {
+      d->halo[mu][0] = d->halo[mu][1] = -1;
+    }
+
+    /* the faces are ordered by block index, the same on all processes */
+    k[0] = k[1] = 0;
+    for (int b = 0; b < d->nb; b++)
+    {
+      block_coords(d, b, bc);
+      /* direction +mu */
+      if (bc[mu] < d->sb->nbl[mu] - 1)
+      {
+        bc[mu]++;
+        d->nbr[8 * b + 2 * mu] = block_index(d, bc);
+        bc[mu]--;
+      }
+      else
+      {
+        d->face[mu][1][k[1]] = b;
+        if (np[mu] > 1)
+        {
+          d->nbr[8 * b + 2 * mu] = d->halo[mu][1] + k[1];
+        }
+        else
+        {
+          bc[mu] = 0;
+          d->nbr[8 * b + 2 * mu] = block_index(d, bc);
+          bc[mu] = d->sb->nbl[mu] - 1;
+        }
+        k[1]++;
+      }
+      /* direction -mu */
+      if (bc[mu] > 0)
+      {
+        bc[mu]--;
+        d->nbr[8 * b + 2 * mu + 1] = block_index(d, bc);
+        bc[mu]++;
+      }
+      else
+      {
+        d->face[mu][0][k[0]] = b;
+        if (np[mu] > 1)
+        {
+          d->nbr[8 * b + 2 * mu + 1] = d->halo[mu][0] + k[0];
+        }
+        else
+        {
+          bc[mu] = d->sb->nbl[mu] - 1;
+          d->nbr[8 * b + 2 * mu + 1] = block_index(d, bc);
+          bc[mu] = 0;
+        }
+        k[0]++;
+      }
+    }
+  }
+}
+
+static void mg_alloc(mg_par *mg)
+{
+  struct _mg_data *d;
+  int maxface = 1;
+
+  error(mg->nvec < 1, 1, "mg_alloc [multigrid.c]", "At least one null-space vector is needed");
+
+  d = malloc(sizeof(*d));
+  error(d == NULL, 1, "mg_alloc [multigrid.c]", "Cannot allocate memory");
+  mg->data = d;
+  mg_init_blocks(mg);
+
+  for (int mu = 0; mu < 4; mu++)
+    if (d->nface[mu] > maxface)
+      maxface = d->nface[mu];
+
+  d->Aself = malloc(sizeof(double complex) * 9 * d->nb * d->nc * d->nc);
+  d->Ahop = d->Aself + d->nb * d->nc * d->nc;
+  d->cv = malloc(sizeof(double complex) * (2 * MG_COARSE_NKV + 2) * d->nbtot * d->nc);
+  d->buf = malloc(sizeof(double complex) * maxface * d->nc);
+  error(d->Aself == NULL || d->cv == NULL || d->buf == NULL, 1, "mg_alloc [multigrid.c]",
+        "Cannot allocate memory");
+
+  SAP_init(&d->sap, mg->mass);
+  for (int mu = 0; mu < 4; mu++)
+    d->sap.block[mu] = mg->block[mu];
+
+  d->w = alloc_spinor_field_f(mg->nvec, &glattice);
+  d->ws = alloc_spinor_field_f(6, &glattice);
+  d->fingerprint = 0.;
+  d->mass = mg->mass;
+  d->mvm = 0;
+}
+
+/* <f1,f2> on the block b, for the chirality s (s=-1: both) */
+static double complex block_prod(struct _mg_data *d, int b, int s, spinor_field *f1, spinor_field *f2)
+{
+  const int a0 = (s == 1) ? MG_HALF : 0;
+  const int a1 = (s == 0) ? MG_HALF : MG_NCOMP;
+  double complex res = 0.;
+
+  for (int n = 0; n < d->bvol; n++)
+  {
+    const int ix = d->sb->site[b * d->bvol + n];
+    double complex *p1 = _MG_SITE(f1, ix);
+    double complex *p2 = _MG_SITE(f2, ix);
+    for (int a = a0; a < a1; a++)
+      res += conj(p1[a]) * p2[a];
+  }
+
+  return res;
+}
+
+/* f1 += c f2 on the block b, for the chirality s (s=-1: both) */
+static void block_mulc_add_assign(struct _mg_data *d, int b, int s, spinor_field *f1, double complex c, spinor_field *f2)
+{
+  const int a0 = (s == 1) ? MG_HALF : 0;
+  const int a1 = (s == 0) ? MG_HALF : MG_NCOMP;
+
+  for (int n = 0; n < d->bvol; n++)
+  {
+    const int ix = d->sb->site[b * d->bvol + n];
+    double complex *p1 = _MG_SITE(f1, ix);
+    double complex *p2 = _MG_SITE(f2, ix);
+    for (int a = a0; a < a1; a++)
+      p1[a] += c * p2[a];
+  }
+}
+
+static void block_mul(struct _mg_data *d, int b, int s, spinor_field *f, double r)
+{
+  const int a0 = (s == 1) ? MG_HALF : 0;
+  const int a1 = (s == 0) ? MG_HALF : MG_NCOMP;
+
+  for (int n = 0; n < d->bvol; n++)
+  {
+    double complex *p = _MG_SITE(f, d->sb->site[b * d->bvol + n]);
+    for (int a = a0; a < a1; a++)
+      p[a] *= r;
+  }
+}
+
+/* Gram-Schmidt of the null-space vectors on each block and chirality, two passes */
+static void mg_orthonormalize(mg_par *mg)
+{
+  struct _mg_data *d = mg->data;
+  spinor_field *w = d->w;
+
+  _OMP_PRAGMA(_omp_parallel)
+  _OMP_PRAGMA(_omp_for)
+  for (int b = 0; b < d->nb; b++)
+  {
+    for (int s = 0; s < 2; s++)
+    {
+      for (int k = 0; k < mg->nvec; k++)
+      {
+        for (int pass = 0; pass < 2; pass++)
+        {
+          for (int j = 0; j < k; j++)
+          {
+            double complex c = block_prod(d, b, s, &w[j], &w[k]);
+            block_mulc_add_assign(d, b, s, &w[k], -c, &w[j]);
+          }
+        }
+        block_mul(d, b, s, &w[k], 1. / sqrt(creal(block_prod(d, b, s, &w[k], &w[k]))));
+      }
+    }
+  }
+}
+
+/* rc = R f */
+static void mg_restrict(mg_par *mg, double complex *rc, spinor_field *f)
+{
+  struct _mg_data *d = mg->data;
+
+  _OMP_PRAGMA(_omp_parallel)
+  _OMP_PRAGMA(_omp_for)
+  for (int b = 0; b < d->nb; b++)
+  {
+    for (int s = 0; s < 2; s++)
+      for (int k = 0; k < mg->nvec; k++)
+        rc[b * d->nc + s * mg->nvec + k] = block_prod(d, b, s, &d->w[k], f);
+  }
+}
+
+/* f = P xc */
+static void mg_prolong(mg_par *mg, spinor_field *f, double complex *xc)
+{
+  struct _mg_data *d = mg->data;
+
+  _OMP_PRAGMA(_omp_parallel)
+  _OMP_PRAGMA(_omp_for)
+  for (int b = 0; b < d->nb; b++)
+  {
+    for (int n = 0; n < d->bvol; n++)
+    {
+      const int ix = d->sb->site[b * d->bvol + n];
+      double complex *pf = _MG_SITE(f, ix);
+      for (int a = 0; a < MG_NCOMP; a++)
+        pf[a] = 0.;
+      for (int k = 0; k < mg->nvec; k++)
+      {
+        double complex *pw = _MG_SITE(&d->w[k], ix);
+        const double complex c0 = xc[b * d->nc + k];
+        const double complex c1 = xc[b * d->nc + mg->nvec + k];
+        for (int a = 0; a < MG_HALF; a++)
+        {
+          pf[a] += c0 * pw[a];
+          pf[MG_HALF + a] += c1 * pw[MG_HALF + a];
+        }
+      }
+    }
+  }
+}
+
+/*******************************************************************************
+ * Coarse operator
+ *******************************************************************************/
+
+/* adds to A the coupling of the site ix of a block to the neighbouring block in direction +mu (up=1) or -mu (up=0) */
+static void hop_site(mg_par *mg, double complex *A, int ix, int mu, int up)
+{
+  struct _mg_data *d = mg->data;
+  const int nvec = mg->nvec;
+  const int iy = up ? iup(ix, mu) : idn(ix, mu);
+  const suNf *U = up ? pu_gauge_f(ix, mu) : pu_gauge_f(iy, mu);
+  const double complex ph = up ? hop_phase(mu) : conj(hop_phase(mu));
+  const double sign = up ? -1. : 1.; /* (1 - g_mu) for +mu, (1 + g_mu) for -mu */
+  suNf_spinor psi, u, g;
+  double complex *pp = (double complex *)&psi;
+  double complex *hv = (double complex *)&u;
+  double complex *gv = (double complex *)&g;
+
+  for (int j = 0; j < nvec; j++)
+  {
+    for (int sp = 0; sp < 2; sp++)
+    {
+      psi = *_FIELD_AT(&d->w[j], iy);
+      for (int a = 0; a < MG_HALF; a++)
+        pp[(1 - sp) * MG_HALF + a] = 0.;
+
+      for (int a = 0; a < 4; a++)
+      {
+        if (up)
+        {
+          _suNf_multiply(u.c[a], *U, psi.c[a]);
+        }
+        else
+        {
+          _suNf_inverse_multiply(u.c[a], *U, psi.c[a]);
+        }
+      }
+
+      switch (mu)
+      {
+      case 0:
+        _spinor_g0_f(g, u);
+        break;
+      case 1:
+        _spinor_g1_f(g, u);
+        break;
+      case 2:
+        _spinor_g2_f(g, u);
+        break;
+      default:
+        _spinor_g3_f(g, u);
+        break;
+      }
+
+      for (int a = 0; a < MG_NCOMP; a++)
+        hv[a] = -0.5 * ph * (hv[a] + sign * gv[a]);
+
+      for (int i = 0; i < nvec; i++)
+      {
+        double complex *pw = _MG_SITE(&d->w[i], ix);
+        for (int s = 0; s < 2; s++)
+        {
+          double complex c = 0.;
+          for (int a = s * MG_HALF; a < (s + 1) * MG_HALF; a++)
+            c += conj(pw[a]) * hv[a];
+          A[(s * nvec + i) * d->nc + sp * nvec + j] += c;
+        }
+      }
+    }
+  }
+}
+
+static void mg_build_coarse(mg_par *mg)
+{
+  struct _mg_data *d = mg->data;
+  const int nvec = mg->nvec;
+  const int nc2 = d->nc * d->nc;
+  const int *bs = mg->block;
+  const int st[4] = {bs[1] * bs[2] * bs[3], bs[2] * bs[3], bs[3], 1};
+  spinor_field *v = &d->ws[4];
+  spinor_field *dv = &d->ws[5];
+
+  /* hopping terms from the links on the faces of the blocks */
+  for (int k = 0; k < nvec; k++)
+  {
+    start_sf_sendrecv(&d->w[k]);
+    complete_sf_sendrecv(&d->w[k]);
+  }
+  memset(d->Ahop, 0, sizeof(double complex) * 8 * d->nb * nc2);
+
+  _OMP_PRAGMA(_omp_parallel)
+  _OMP_PRAGMA(_omp_for)
+  for (int b = 0; b < d->nb; b++)
+  {
+    for (int n = 0; n < d->bvol; n++)
+    {
+      const int ix = d->sb->site[b * d->bvol + n];
+      for (int mu = 0; mu < 4; mu++)
+      {
+        const int cn = (n / st[mu]) % bs[mu];
+        if (cn == bs[mu] - 1)
+          hop_site(mg, d->Ahop + (8 * b + 2 * mu) * nc2, ix, mu, 1);
+        if (cn == 0)
+          hop_site(mg, d->Ahop + (8 * b + 2 * mu + 1) * nc2, ix, mu, 0);
+      }
+    }
+  }
+
+  /* self couplings: the neighbours of a block have the opposite colour,
+     so D applied to P_s w_j on the blocks of one colour gives the self
+     couplings of these blocks */
+  for (int col = 0; col < 2; col++)
+  {
+    for (int sp = 0; sp < 2; sp++)
+    {
+      for (int j = 0; j < nvec; j++)
+      {
+        spinor_field_zero_f(v);
+
+        _OMP_PRAGMA(_omp_parallel)
+        _OMP_PRAGMA(_omp_for)
+        for (int kb = 0; kb < d->sb->ncblk[col]; kb++)
+        {
+          const int b = d->sb->cblk[col][kb];
+          for (int n = 0; n < d->bvol; n++)
+          {
+            const int ix = d->sb->site[b * d->bvol + n];
+            double complex *pv = _MG_SITE(v, ix);
+            double complex *pw = _MG_SITE(&d->w[j], ix);
+            for (int a = sp * MG_HALF; a < (sp + 1) * MG_HALF; a++)
+              pv[a] = pw[a];
+          }
+        }
+
+        mg_D(mg, dv, v);
+
+        _OMP_PRAGMA(_omp_parallel)
+        _OMP_PRAGMA(_omp_for)
+        for (int kb = 0; kb < d->sb->ncblk[col]; kb++)
+        {
+          const int b = d->sb->cblk[col][kb];
+          for (int s = 0; s < 2; s++)
+            for (int i = 0; i < nvec; i++)
+              d->Aself[b * nc2 + (s * nvec + i) * d->nc + sp * nvec + j] = block_prod(d, b, s, &d->w[i], dv);
+        }
+      }
+    }
+  }
+
+  d->mass = mg->mass;
+}
+
+/* halo of a coarse vector: the faces of the blocks go to the neighbouring processes */
+static void coarse_sendrecv(struct _mg_data *d, double complex *v)
+{
+#ifdef WITH_MPI
+  const int np[4] = {NP_T, NP_X, NP_Y, NP_Z};
+  MPI_Status status;
+  int mpiret;
+
+  for (int mu = 0; mu < 4; mu++)
+  {
+    if (np[mu] == 1)
+      continue;
+    const int n = 2 * d->nface[mu] * d->nc;
+    for (int dir = 0; dir < 2; dir++)
+    {
+      const int to = dir ? proc_up(CID, mu) : proc_dn(CID, mu);
+      const int from = dir ? proc_dn(CID, mu) : proc_up(CID, mu);
+      for (int k = 0; k < d->nface[mu]; k++)
+        memcpy(d->buf + k * d->nc, v + d->face[mu][dir][k] * d->nc, sizeof(double complex) * d->nc);
+      mpiret = MPI_Sendrecv(d->buf, n, MPI_DOUBLE, to, 2 * mu + dir,
+                            v + d->halo[mu][1 - dir] * d->nc, n, MPI_DOUBLE, from, 2 * mu + dir,
+                            cart_comm, &status);
+      error(mpiret != MPI_SUCCESS, 1, "coarse_sendrecv [multigrid.c]", "MPI_Sendrecv failed");
+    }
+  }
+#endif
+}
+
+/* out = Dc in; the halo of in is filled */
+static void coarse_apply(struct _mg_data *d, double complex *out, double complex *in)
+{
+  const int nc = d->nc;
+  const int nc2 = nc * nc;
+
+  coarse_sendrecv(d, in);
+
+  _OMP_PRAGMA(_omp_parallel)
+  _OMP_PRAGMA(_omp_for)
+  for (int b = 0; b < d->nb; b++)
+  {
+    double complex *y = out + b * nc;
+    for (int i = 0; i < nc; i++)
+    {
+      const double complex *A = d->Aself + b * nc2 + i * nc;
+      const double complex *x = in + b * nc;
+      double complex c = 0.;
+      for (int j = 0; j < nc; j++)
+        c += A[j] * x[j];
+      for (int k = 0; k < 8; k++)
+      {
+        A = d->Ahop + (8 * b + k) * nc2 + i * nc;
+        x = in + d->nbr[8 * b + k] * nc;
+        for (int j = 0; j < nc; j++)
+          c += A[j] * x[j];
+      }
+      y[i] = c;
+    }
+  }
+}
+
+static double complex coarse_prod(struct _mg_data *d, double complex *a, double complex *b)
+{
+  const int n = d->nb * d->nc;
+  double res[2], re = 0., im = 0.;
+
+  _OMP_PRAGMA(_omp_parallel)
+  _OMP_PRAGMA(_omp_for _omp_sum(re, im))
+  for (int i = 0; i < n; i++)
+  {
+    double complex c = conj(a[i]) * b[i];
+    re += creal(c);
+    im += cimag(c);
+  }
+  res[0] = re;
+  res[1] = im;
+  global_sum(res, 2);
+
+  return res[0] + I * res[1];
+}
+
+/* y += c x */
+static void coarse_mulc_add_assign(struct _mg_data *d, double complex *y, double complex c, double complex *x)
+{
+  const int n = d->nb * d->nc;
+
+  _OMP_PRAGMA(_omp_parallel)
+  _OMP_PRAGMA(_omp_for)
+  for (int i = 0; i < n; i++)
+    y[i] += c * x[i];
+}
+
+/* x = Dc^-1 r with restarted GCR from x = 0; r is overwritten with the residual */
+static int coarse_solve(mg_par *mg, double complex *x, double complex *r)
+{
+  struct _mg_data *d = mg->data;
+  const int n = d->nb * d->nc;
+  const int stride = d->nbtot * d->nc;
+  double complex *z = d->cv + 2 * stride;
+  double complex *q = z + MG_COARSE_NKV * stride;
+  double complex c;
+  double rnorm2, innorm2, norm;
+  int iter = 0;
+
+  memset(x, 0, sizeof(double complex) * n);
+  innorm2 = creal(coarse_prod(d, r, r));
+  if (innorm2 == 0.)
+    return 0;
+
+  while (1)
+  {
+    for (int k = 0; k < MG_COARSE_NKV; k++)
+    {
+      double complex *zk = z + k * stride;
+      double complex *qk = q + k * stride;
+      memcpy(zk, r, sizeof(double complex) * n);
+      coarse_apply(d, qk, zk);
+      ++iter;
+
+      for (int j = 0; j < k; j++)
+      {
+        c = -coarse_prod(d, q + j * stride, qk);
+        coarse_mulc_add_assign(d, qk, c, q + j * stride);
+        coarse_mulc_add_assign(d, zk, c, z + j * stride);
+      }
+      norm = 1. / sqrt(creal(coarse_prod(d, qk, qk)));
+      coarse_mulc_add_assign(d, qk, norm - 1., qk);
+      coarse_mulc_add_assign(d, zk, norm - 1., zk);
+
+      c = coarse_prod(d, qk, r);
+      coarse_mulc_add_assign(d, x, c, zk);
+      coarse_mulc_add_assign(d, r, -c, qk);
+      rnorm2 = creal(coarse_prod(d, r, r));
+
+      if (rnorm2 < mg->coarse_err2 * innorm2 || (mg->coarse_max_iter != 0 && iter >= mg->coarse_max_iter))
+      {
+        lprintf("MG", 50, "Coarse GCR: iter = %d, res2 = %1.8e\n", iter, rnorm2 / innorm2);
+        return iter;
+      }
+    }
+  }
+}
+
+/*******************************************************************************
+ * Smoother and cycle
+ *******************************************************************************/
+
+/* ncycle SAP cycles on D x = r: x += e, r -= D e */
+static void mg_sap(mg_par *mg, spinor_field *x, spinor_field *r, int ncycle)
+{
+  struct _mg_data *d = mg->data;
+  spinor_field *e = &d->ws[0];
+  spinor_field *q = &d->ws[1];
+
+  d->sap.nu = ncycle;
+  d->mvm += SAP_block_prec(&d->sap, r, e);
+  spinor_field_add_assign_f(x, e);
+  mg_D(mg, q, e);
+  spinor_field_sub_assign_f(r, q);
+}
+
+/* the smoother follows the mass and the gauge field */
+static void mg_sap_update(mg_par *mg)
+{
+  struct _mg_data *d = mg->data;
+
+  d->sap.mass = mg->mass;
+  d->sap.niter = mg->sap_iter;
+  SAP_update(&d->sap);
+}
+
+/* z = K r */
+static void mg_cycle(mg_par *mg, spinor_field *z, spinor_field *r)
+{
+  struct _mg_data *d = mg->data;
+  spinor_field *t = &d->ws[3];
+  double complex *xc = d->cv;
+  double complex *rc = d->cv + d->nbtot * d->nc;
+
+  mg_restrict(mg, rc, r);
+  coarse_solve(mg, xc, rc);
+  mg_prolong(mg, z, xc);
+
+  if (mg->nu > 0)
+  {
+    mg_D(mg, t, z);
+    spinor_field_sub_f(t, r, t);
+    mg_sap(mg, z, t, mg->nu);
+  }
+}
+
+static void mg_prec(spinor_field *out, spinor_field *in)
+{
+  mg_cycle(cur_mg, out, in);
+}
+
+/* for the even/odd preconditioned operator: the even part of K (in,0) */
+static void mg_prec_eo(spinor_field *out, spinor_field *in)
+{
+  struct _mg_data *d = cur_mg->data;
+  spinor_field *r = &d->ws[4];
+  spinor_field *z = &d->ws[5];
+  spinor_field r_e, r_o, z_e;
+
+  r_e = *r;
+  r_e.type = &glat_even;
+  r_o = *r;
+  r_o.type = &glat_odd;
+  r_o.ptr = r->ptr + glat_odd.master_shift;
+  spinor_field_copy_f(&r_e, in);
+  spinor_field_zero_f(&r_o);
+
+  mg_cycle(cur_mg, z, r);
+
+  z_e = *z;
+  z_e.type = &glat_even;
+  spinor_field_copy_f(out, &z_e);
+}
+
+/*******************************************************************************
+ * Setup
+ *******************************************************************************/
+
+/* w <- (1 - K D) w, with K = SAP (smooth=1) or the cycle, then a new coarse operator */
+static void mg_setup_pass(mg_par *mg, int smooth)
+{
+  struct _mg_data *d = mg->data;
+  spinor_field *t = &d->ws[4];
+  spinor_field *e = &d->ws[5];
+
+  for (int k = 0; k < mg->nvec; k++)
+  {
+    mg_D(mg, t, &d->w[k]);
+    if (smooth)
+    {
+      spinor_field_zero_f(e);
+      mg_sap(mg, e, t, MG_SETUP_SMOOTH);
+    }
+    else
+    {
+      mg_cycle(mg, e, t);
+    }
+    spinor_field_sub_assign_f(&d->w[k], e);
+  }
+
+  mg_orthonormalize(mg);
+  mg_build_coarse(mg);
+}
+
+void mg_init(mg_par *mg, double mass)
+{
+  mg->mass = mass;
+  for (int mu = 0; mu < 4; mu++)
+    mg->block[mu] = 4;
+  mg->nvec = 8;
+  mg->setup_iter = 3;
+  mg->setup_eva = 0;
+  mg->reuse = 0;
+  mg->refresh_iter = 1;
+  mg->nu = 2;
+  mg->sap_iter = 4;
+  mg->coarse_err2 = 1.e-2;
+  mg->coarse_max_iter = 100;
+  mg->gcr_nkv = 16;
+  mg->data = NULL;
+}
+
+void mg_free(mg_par *mg)
+{
+  struct _mg_data *d = mg->data;
+
+  if (d == NULL)
+    return;
+
+  free_spinor_field_f(d->w);
+  free_spinor_field_f(d->ws);
+  free(d->Aself);
+  free(d->cv);
+  free(d->buf);
+  SAP_free(&d->sap);
+  free_SAP_blocks(d->sb);
+  free(d->nbr);
+  for (int mu = 0; mu < 4; mu++)
+    free(d->face[mu][0]);
+  free(d);
+  mg->data = NULL;
+}
+
+void mg_setup(mg_par *mg)
+{
+  struct _mg_data *d;
+  int status;
+
+  if (mg->data == NULL)
+    mg_alloc(mg);
+  d = mg->data;
+  d->mvm = 0;
+  cur_mg = mg;
+  mg_sap_update(mg);
+
+  if (mg->setup_eva > 0)
+  {
+    double ubnd;
+    double *ev = malloc(sizeof(double) * mg->nvec);
+    max_H(&mg_H2, &glattice, &ubnd);
+    eva(mg->nvec, mg->nvec, 0, MG_EVA_KMAX, mg->setup_eva, 1.1 * ubnd, 1.e-3, 1.e-1,
+        &mg_H2, d->w, ev, &status);
+    free(ev);
+  }
+  else
+  {
+    for (int k = 0; k < mg->nvec; k++)
+      gaussian_spinor_field(&d->w[k]);
+  }
+
+  mg_setup_pass(mg, 1);
+  for (int k = 0; k < mg->setup_iter; k++)
+    mg_setup_pass(mg, 0);
+  d->fingerprint = gauge_fingerprint();
+
+  lprintf("MG", 10, "Setup: %d null vectors, blocks %dx%dx%dx%d, coarse dimension %d, MVM = %d\n",
+          mg->nvec, mg->block[0], mg->block[1], mg->block[2], mg->block[3], d->nc * d->nb, d->mvm);
+}
+
+/* brings the null space and the coarse operator up to date with the gauge field and the mass */
+void mg_update(mg_par *mg)
+{
+  struct _mg_data *d = mg->data;
+  double fp;
+
+  if (d == NULL)
+  {
+    mg_setup(mg);
+    return;
+  }
+
+  fp = gauge_fingerprint();
+  if (fp != d->fingerprint || mg->mass != d->mass)
+    mg_sap_update(mg);
+
+  if (fp != d->fingerprint)
+  {
+    if (mg->reuse)
+    {
+      d->mvm = 0;
+      mg_build_coarse(mg);
+      for (int k = 0; k < mg->refresh_iter; k++)
+        mg_setup_pass(mg, 0);
+      d->fingerprint = fp;
+      lprintf("MG", 10, "Null space refreshed, MVM = %d\n", d->mvm);
+    }
+    else
+    {
+      mg_setup(mg);
+    }
+  }
+  else if (mg->mass != d->mass)
+  {
+    mg_build_coarse(mg);
+  }
+}
+
+/*
+ * M out = in, M = D(mass) on glattice or the even/odd preconditioned
+ * D(mass) on glat_even; out is used as initial guess.
+ * The mg_par is taken from par->add_par.
+ * Returns the number of applications of M.
+ */
+int mg_solve(mshift_par *par, spinor_operator M, spinor_field *in, spinor_field *out)
+{
+  mg_par *mg = (mg_par *)par->add_par;
+  GCR_par gpar;
+  int cgiter;
+
+  error(mg == NULL, 1, "mg_solve [multigrid.c]", "The multigrid parameters must be given in add_par");
+  error(par->n != 1 || par->shift[0] != 0., 1, "mg_solve [multigrid.c]", "Only one vanishing shift is supported");
+  error(in->type != &glattice && in->type != &glat_even, 1, "mg_solve [multigrid.c]",
+        "Only glattice and glat_even are supported");
+
+  mg_update(mg);
+  mg->data->mvm = 0;
+  cur_mg = mg;
+
+  gpar.err2 = par->err2;
+  gpar.max_iter = par->max_iter;
+  gpar.nkv = mg->gcr_nkv;
+  cgiter = GCR(&gpar, M, (in->type == &glattice) ? &mg_prec : &mg_prec_eo, in, out);
+
+  lprintf("INVERTER", 10, "mg_solve: MVM = %d (outer %d)\n", cgiter + mg->data->mvm, cgiter);
+
+  cost_cnt.iter += cgiter;
+  return cgiter;
+}
@@ -13,6 +13,7 @@
 
 #include <stdlib.h>
 #include "memory.h"
+#include "hr_omp.h"
 
 #ifdef AMALLOC_MEASURE
 
@@ -125,12 +126,16 @@ void *amalloc(size_t size, int p)
    addr = (char *)(((unsigned long)(true_addr + shift)) & (~mask));
    (*new).addr = addr;
    (*new).true_addr = true_addr;
-   (*new).next = first;
-   first = new;
+
+   _OMP_PRAGMA(critical(amalloc))
+   {
+      (*new).next = first;
+      first = new;
 
 #ifdef AMALLOC_MEASURE
-   insert((void *)addr, size);
+      insert((void *)addr, size);
 #endif
+   }
 
    return ((void *)(addr));
 }
@@ -139,26 +144,32 @@ void afree(void *addr)
 {
    struct addr_t *p, *q;
 
+   _OMP_PRAGMA(critical(amalloc))
+   {
 #ifdef AMALLOC_MEASURE
-   remove(addr);
+      remove(addr);
 #endif
 
-   q = NULL;
+      q = NULL;
 
-   for (p = first; p != NULL; p = (*p).next)
-   {
-      if ((*p).addr == addr)
+      for (p = first; p != NULL; p = (*p).next)
       {
-         if (q != NULL)
-            (*q).next = (*p).next;
-         else
-            first = (*p).next;
-
-         free((*p).true_addr);
-         free(p);
-         return;
+         if ((*p).addr == addr)
+         {
+            if (q != NULL)
+               (*q).next = (*p).next;
+            else
+               first = (*p).next;
+            break;
+         }
+
+         q = p;
       }
+   }
 
-      q = p;
+   if (p != NULL)
+   {
+      free((*p).true_addr);
+      free(p);
    }
 }
@@ -12,6 +12,7 @@
 *******************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include "suN.h"
 #include "error.h"
 #include "memory.h"
@@ -97,7 +98,7 @@
         if (u != NULL)                   \
         {                                \
             if (u->ptr != NULL)          \
-                afree(u->ptr);           \
+                pool_free(u->ptr);       \
             _FREE_GPU_CODE;              \
             _FREE_MPI_CODE;              \
             afree(u);                    \
@@ -118,7 +119,7 @@
                                                                                     \
         if (alloc_mem_t & CPU_MEM)                                                  \
         {                                                                           \
-            f->ptr = amalloc(_size * type->gsize_gauge * sizeof(*(f->ptr)), ALIGN); \
+            f->ptr = pool_alloc(type, _size * sizeof(*(f->ptr)), type->gsize_gauge, 1); \
             error((f->ptr) == NULL, 1, "alloc_" #_name " [" __FILE__ "]",           \
                   "Could not allocate memory space for field (data)");              \
         }                                                                           \
@@ -149,6 +150,7 @@ _DECLARE_MEMORY_FUNC(gfield_flt, suNg_field_flt, 4);
 
 _DECLARE_MEMORY_FUNC(gfield_f, suNf_field, 4);
 _DECLARE_MEMORY_FUNC(gfield_f_flt, suNf_field_flt, 4);
+_DECLARE_MEMORY_FUNC(gfield_f_half, suNf_field_half, 4);
 _DECLARE_MEMORY_FUNC(scalar_field, suNg_scalar_field, 1);
 
 _DECLARE_MEMORY_FUNC(avfield, suNg_av_field, 4);
@@ -163,4 +165,41 @@ _DECLARE_MEMORY_FUNC(clover_force, suNffull_field, 6);
 _DECLARE_MEMORY_FUNC(clover_term, suNfc_field, 4);
 _DECLARE_MEMORY_FUNC(clover_force, suNf_field, 6);
 #endif
+
+#ifdef WITH_SIMD_LAYOUT
+/* Site-blocked copies of the represented gauge field:
+ * 8 links per site, SIMD_VLEN sites per block.
+ * The memory is cleared so that unused lanes stay finite.
+ */
+#define _DECLARE_SIMD_ALLOC_FUNC(_name, _type)                                            \
+    _type *alloc_##_name(geometry_descriptor *type)                                     \
+    {                                                                                   \
+        _type *f;                                                                       \
+        size_t nblocks = (type->gsize_gauge + SIMD_VLEN - 1) / SIMD_VLEN;               \
+                                                                                        \
+        f = amalloc(sizeof(*f), ALIGN);                                                 \
+        error(f == NULL, 1, "alloc_" #_name " [" __FILE__ "]",                          \
+              "Could not allocate memory space for field (structure)");                 \
+        f->type = type;                                                                 \
+                                                                                        \
+        f->ptr = pool_alloc(type, 8 * sizeof(*(f->ptr)), nblocks, 1);                   \
+        error((f->ptr) == NULL, 1, "alloc_" #_name " [" __FILE__ "]",                   \
+              "Could not allocate memory space for field (data)");                      \
+        memset(f->ptr, 0, 8 * nblocks * sizeof(*(f->ptr)));                             \
+                                                                                        \
+        _ALLOC_GPU_CODE(_name, 8);                                                      \
+                                                                                        \
+        _ALLOC_MPI_CODE(_name);                                                         \
+                                                                                        \
+        return f;                                                                       \
+    }
+
+_DECLARE_FREE_FUNC(gfield_f_simd, suNf_field_simd);
+_DECLARE_SIMD_ALLOC_FUNC(gfield_f_simd, suNf_field_simd);
+_DECLARE_FREE_FUNC(gfield_f_simd_flt, suNf_field_simd_flt);
+_DECLARE_SIMD_ALLOC_FUNC(gfield_f_simd_flt, suNf_field_simd_flt);
+
+#undef _DECLARE_SIMD_ALLOC_FUNC
+#endif /* WITH_SIMD_LAYOUT */
+
 #undef _DECLARE_MEMORY_FUNC
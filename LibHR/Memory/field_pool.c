@@ -0,0 +1,221 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *
+* All rights reserved.                                                      *
+\***************************************************************************/
+
+/*******************************************************************************
+ *
+ * File field_pool.c
+ *
+ * Pool of the data buffers of the fields.
+ * The buffers released by free_* are kept, for each geometry type and size,
+ * and handed out again by the next alloc_* with the same type and size.
+ * New buffers are first touched with the same static OpenMP schedule used
+ * by the loops over the sites, so that the pages are placed on the NUMA
+ * node of the thread working on them.
+ *
+ *******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "memory.h"
+#include "geometry.h"
+#include "global.h"
+#include "error.h"
+#include "logger.h"
+#include "hr_omp.h"
+
+typedef struct _pool_buffer
+{
+   void *addr;
+   int in_use;
+   struct _pool_buffer *next;
+} pool_buffer;
+
+typedef struct _pool_class
+{
+   geometry_descriptor *type;
+   size_t size;
+   int nbuf;     /* buffers allocated */
+   int nused;    /* buffers in use */
+   int max_used; /* high-water mark of nused */
+   pool_buffer *buf;
+   struct _pool_class *next;
+} pool_class;
+
+static pool_class *classes = NULL;
+static size_t bytes_used = 0, max_bytes_used = 0, bytes_alloc = 0;
+static unsigned long nrecycled = 0;
+
+static pool_class *find_class(geometry_descriptor *type, size_t size)
+{
+   pool_class *c;
+   for (c = classes; c != NULL; c = c->next)
+      if (c->type == type && c->size == size)
+         return c;
+
+   c = malloc(sizeof(*c));
+   error(c == NULL, 1, "find_class [field_pool.c]", "Could not allocate memory space for the pool");
+   c->type = type;
+   c->size = size;
+   c->nbuf = c->nused = c->max_used = 0;
+   c->buf = NULL;
+   c->next = classes;
+   classes = c;
+   return c;
+}
+
+/* first touch of n fields of nsites sites of site_size bytes */
+static void first_touch(char *addr, geometry_descriptor *type, size_t site_size, size_t nsites, unsigned int n)
+{
+#ifdef _OPENMP
+   for (unsigned int k = 0; k < n; ++k)
+   {
+      char *base = addr + k * nsites * site_size;
+      _MASTER_FOR(type, ix)
+      {
+         size_t is = ix - type->master_shift;
+         if (is < nsites)
+            memset(base + is * site_size, 0, site_size);
+      }
+   }
+#endif
+}
+
+/*
+ * Buffer for n fields of nsites sites of site_size bytes on the geometry type.
+ */
+void *pool_alloc(geometry_descriptor *type, size_t site_size, size_t nsites, unsigned int n)
+{
+   const size_t size = n * nsites * site_size;
+   pool_buffer *b = NULL;
+   int fresh = 0;
+
+   if (size == 0)
+      return NULL;
+
+   _OMP_PRAGMA(critical(field_pool))
+   {
+      pool_class *c = find_class(type, size);
+
+      for (b = c->buf; b != NULL; b = b->next)
+         if (!b->in_use)
+            break;
+
+      if (b == NULL)
+      {
+         b = malloc(sizeof(*b));
+         error(b == NULL, 1, "pool_alloc [field_pool.c]", "Could not allocate memory space for the pool");
+         b->addr = amalloc(size, ALIGN);
+         error(b->addr == NULL, 1, "pool_alloc [field_pool.c]", "Could not allocate memory space for field (data)");
+         b->next = c->buf;
+         c->buf = b;
+         c->nbuf++;
+         bytes_alloc += size;
+         fresh = 1;
+      }
+      else
+      {
+         nrecycled++;
+      }
+
+      b->in_use = 1;
+      c->nused++;
+      if (c->nused > c->max_used)
+         c->max_used = c->nused;
+      bytes_used += size;
+      if (bytes_used > max_bytes_used)
+         max_bytes_used = bytes_used;
+   }
+
+   if (fresh)
+      first_touch(b->addr, type, site_size, nsites, n);
+
+   return b->addr;
+}
+
+/* the buffer goes back to the pool */
+void pool_free(void *addr)
+{
+   int found = 0;
+
+   if (addr == NULL)
+      return;
+
+   _OMP_PRAGMA(critical(field_pool))
+   {
+      for (pool_class *c = classes; c != NULL && !found; c = c->next)
+         for (pool_buffer *b = c->buf; b != NULL; b = b->next)
+            if (b->addr == addr && b->in_use)
+            {
+               b->in_use = 0;
+               c->nused--;
+               bytes_used -= c->size;
+               found = 1;
+               break;
+            }
+   }
+
+   error(!found, 1, "pool_free [field_pool.c]", "The buffer does not belong to the pool");
+}
+
+/* give back the unused buffers to the system */
+void pool_release(void)
+{
+   _OMP_PRAGMA(critical(field_pool))
+   {
+      pool_class **pc = &classes;
+      while (*pc != NULL)
+      {
+         pool_class *c = *pc;
+         pool_buffer **pb = &(c->buf);
+         while (*pb != NULL)
+         {
+            pool_buffer *b = *pb;
+            if (b->in_use)
+            {
+               pb = &(b->next);
+               continue;
+            }
+            *pb = b->next;
+            afree(b->addr);
+            free(b);
+            c->nbuf--;
+            bytes_alloc -= c->size;
+         }
+         if (c->nbuf == 0)
+         {
+            *pc = c->next;
+            free(c);
+         }
+         else
+         {
+            pc = &(c->next);
+         }
+      }
+   }
+}
+
+static const char *type_name(geometry_descriptor *type)
+{
+   if (type == &glattice)
+      return "glattice";
+   if (type == &glat_even)
+      return "glat_even";
+   if (type == &glat_odd)
+      return "glat_odd";
+   return "other";
+}
+
+/* high-water marks of the pool */
+void pool_report(void)
+{
+   if (classes == NULL)
+      return;
+
+   lprintf("MEMORY", 0, "Field pool: %.3f Mb in use at most, %.3f Mb allocated, %lu buffers recycled\n",
+           max_bytes_used / 1048576., bytes_alloc / 1048576., nrecycled);
+   for (pool_class *c = classes; c != NULL; c = c->next)
+      lprintf("MEMORY", 10, "Field pool: %s, %.3f Mb buffers: %d allocated, %d in use, %d in use at most\n",
+              type_name(c->type), c->size / 1048576., c->nbuf, c->nused, c->max_used);
+}
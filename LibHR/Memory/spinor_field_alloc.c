@@ -66,7 +66,7 @@ for (int i=1; i<n; ++i) f[i].gpu_ptr=f[i-1].gpu_ptr+type->gsize_spinor*_size;\
 #define _DECLARE_FREE_FUNC(_name,_type)\
 void free_##_name(_type *u){ \
 if (u!=NULL) { \
-if (u->ptr!=NULL) afree(u->ptr);\
+if (u->ptr!=NULL) pool_free(u->ptr);\
 _FREE_GPU_CODE;\
 _FREE_MPI_CODE;\
 afree(u);\
@@ -85,7 +85,7 @@ error(f==NULL,1,"alloc_" #_name " [" __FILE__ "]",\
 for (int i=0; i<n; ++i) f[i].type=type;\
 \
 if(alloc_mem_t & CPU_MEM) {\
-f->ptr=amalloc(n*_size*type->gsize_spinor*sizeof(*(f->ptr)),ALIGN);\
+f->ptr=pool_alloc(type,_size*sizeof(*(f->ptr)),type->gsize_spinor,n);\
 for(int i=1; i<n; ++i) f[i].ptr=f[i-1].ptr+type->gsize_spinor*_size;\
 } else { for (int i=0; i<n; ++i) f[i].ptr=NULL; }	      \
 \
@@ -113,6 +113,7 @@ _DECLARE_ALLOC_FUNC(_name,_type,_size)
 
 _DECLARE_MEMORY_FUNC(spinor_field_f, spinor_field, 1);
 _DECLARE_MEMORY_FUNC(spinor_field_f_flt, spinor_field_flt, 1);
+_DECLARE_MEMORY_FUNC(spinor_field_f_half, spinor_field_half, 1);
 
 _DECLARE_MEMORY_FUNC(sfield, scalar_field, 1);
 
@@ -40,11 +40,27 @@ static void D_pre(spinor_field *out, spinor_field *in)
 #endif
 }
 
+static void D_full(spinor_field *out, spinor_field *in)
+{
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+  Cphi(hmass_pre, out, in);
+#else
+  Dphi(hmass_pre, out, in);
+#endif
+}
+
 static void H_pre(spinor_field *out, spinor_field *in)
 {
   g5Dphi_eopre(hmass_pre, out, in);
 }
 
+#if !defined(WITH_CLOVER) && !defined(WITH_EXPCLOVER)
+static void H_pre_block(spinor_field *out, spinor_field *in, int n)
+{
+  g5Dphi_eopre_block(hmass_pre, out, in, n);
+}
+#endif
+
 static void H2_pre(spinor_field *out, spinor_field *in)
 {
   g5Dphi_eopre_sq(hmass_pre, out, in);
@@ -73,6 +89,7 @@ static spinor_field *QMR_resdn;
 static spinor_field *resd;
 static spinor_field *tmp;
 static spinor_field *tmp_odd;
+static mg_par *mg = NULL;
 // EVA parameters
 double *eva_val;
 static spinor_field *eva_vec;
@@ -146,10 +163,39 @@ void init_propagator_eo(int nm, double *m, double acc)
 #endif
 }
 
+/* Use the multigrid solver on the full lattice in calc_propagator,
+   with nvec null-space vectors and blocks of size block[4].
+   To be called after init_propagator_eo.
+*/
+void init_propagator_mg(int nvec, int *block)
+{
+  error(init == 0, 1, "calc_prop.c", "propagator not initialized!");
+
+  if (mg == NULL)
+  {
+    mg = malloc(sizeof(*mg));
+    mg_init(mg, mass[0]);
+  }
+  mg->nvec = nvec;
+  for (int mu = 0; mu < 4; mu++)
+  {
+    mg->block[mu] = block[mu];
+  }
+  lprintf("CALC_PROPAGATOR", 10, "Multigrid solver with %d null vectors, blocks %dx%dx%dx%d\n",
+          nvec, block[0], block[1], block[2], block[3]);
+}
+
 void free_propagator_eo()
 {
   error(init == 0, 1, "calc_prop.c", "propagator not initialized!");
 
+  if (mg != NULL)
+  {
+    mg_free(mg);
+    free(mg);
+    mg = NULL;
+  }
+
   free_spinor_field_f(tmp);
   free_spinor_field_f(resd);
 
@@ -182,7 +228,7 @@ psi = D^{-1} eta
 
 static void calc_propagator_eo_core(spinor_field *psi, spinor_field *eta, int solver)
 {
-  spinor_field qprop_mask;
+  spinor_field qprop_mask, *qprop_odd;
   int i, cgiter = 0;
   error(init == 0, 1, "calc_prop.c", "z2semwall method not initialized!");
 
@@ -229,23 +275,28 @@ static void calc_propagator_eo_core(spinor_field *psi, spinor_field *eta, int so
     cgiter += g5QMR_mshift(&QMR_par, &D_pre, tmp, resd);
   }
 
+  /* compute solution, the odd part for all masses at once */
+  qprop_odd = malloc(sizeof(spinor_field) * QMR_par.n);
   for (i = 0; i < QMR_par.n; ++i)
   {
 #ifdef GAUSSIAN_NOISE
     spinor_field_sub_assign_f(&resd[i], &QMR_resdn[i]);
 #endif
-    /* compute solution */
     qprop_mask = psi[i];
     qprop_mask.type = &glat_even;
     spinor_field_mul_f(&qprop_mask, (4. + mass[i]), &resd[i]);
-    qprop_mask.type = &glat_odd;
-    qprop_mask.ptr = psi[i].ptr + glat_odd.master_shift;
-    spinor_field_zero_f(&qprop_mask);
-    Dphi_(&qprop_mask, &resd[i]);
-    spinor_field_minus_f(&qprop_mask, &qprop_mask);
+    qprop_odd[i] = psi[i];
+    qprop_odd[i].type = &glat_odd;
+    qprop_odd[i].ptr = psi[i].ptr + glat_odd.master_shift;
+  }
+  Dphi_block_(qprop_odd, resd, QMR_par.n);
+  for (i = 0; i < QMR_par.n; ++i)
+  {
+    spinor_field_minus_f(&qprop_odd[i], &qprop_odd[i]);
     if (i & 1)
       ++cgiter; /* count only half of calls. works because the number of sources is even */
   }
+  free(qprop_odd);
   start_sf_sendrecv(psi);
   complete_sf_sendrecv(psi);
   lprintf("CALC_PROP", 10, "QMR_eo MVM = %d\n", cgiter);
@@ -354,6 +405,152 @@ static void calc_propagator_core(spinor_field *psi, spinor_field *eta, int solve
   start_sf_sendrecv(psi);
   complete_sf_sendrecv(psi);
 }
+
+#if !defined(WITH_CLOVER) && !defined(WITH_EXPCLOVER)
+/* calc_propagator for the ndilute sources and all the masses.
+   For each mass the ndilute sources are inverted together with the block
+   MINRES solver on g5 D_pre. The hopping terms of the source construction
+   and of the reconstruction of the odd part of the solution are applied
+   to all the fields at once:
+     eta_even' = eta_even - D_eo D_oo^-1 eta_odd
+     psi_odd = D_oo^-1 (eta_odd - D_oe psi_even)
+*/
+static void calc_propagator_block(spinor_field *psi, spinor_field *eta, int ndilute)
+{
+  spinor_field *eta_odd, *psi_even, *psi_odd, *deta, *tmpb, *resdb;
+  spinor_field qprop_mask;
+  MINRES_par mpar;
+  int beta, i, k, n_masses, cgiter;
+
+  error(init == 0, 1, "calc_prop.c", "calc_propagator_block method not initialized!");
+
+  n_masses = QMR_par.n;
+  eta_odd = malloc(sizeof(spinor_field) * (ndilute + 2 * ndilute * n_masses));
+  psi_even = eta_odd + ndilute;
+  psi_odd = psi_even + ndilute * n_masses;
+  deta = alloc_spinor_field_f(3 * ndilute, &glat_even);
+  tmpb = deta + ndilute;
+  resdb = tmpb + ndilute;
+
+  /* D_eo eta_odd, the factor D_oo^-1 depends on the mass */
+  for (beta = 0; beta < ndilute; ++beta)
+  {
+    eta_odd[beta] = eta[beta];
+    eta_odd[beta].type = &glat_odd;
+    eta_odd[beta].ptr = eta[beta].ptr + glat_odd.master_shift;
+  }
+  Dphi_block_(deta, eta_odd, ndilute);
+
+  /* the ndilute sources are solved together, one mass at a time */
+  mpar.err2 = QMR_par.err2;
+  mpar.max_iter = QMR_par.max_iter;
+  for (i = 0; i < n_masses; ++i)
+  {
+    lprintf("CALC_PROPAGATOR", 10, "n masses=%d, mass = %g\n", n_masses, mass[i]);
+    hmass_pre = mass[i];
+
+    for (beta = 0; beta < ndilute; ++beta)
+    {
+      k = beta * n_masses + i;
+      qprop_mask = eta[beta];
+      qprop_mask.type = &glat_even;
+      spinor_field_lc_f(&tmpb[beta], 1., &qprop_mask, -1. / (4. + mass[i]), &deta[beta]);
+#ifdef GAUSSIAN_NOISE
+      spinor_field_add_assign_f(&tmpb[beta], QMR_noise);
+#endif
+      spinor_field_g5_assign_f(&tmpb[beta]);
+
+      //if the solution vector is empty use zero guess
+      if (spinor_field_sqnorm_f(&psi[k]) < 1e-28)
+      {
+        spinor_field_zero_f(&resdb[beta]);
+      }
+      else
+      {
+        psi[k].type = &glat_even;
+        spinor_field_mul_f(&resdb[beta], 1 / (4. + mass[i]), &psi[k]);
+        psi[k].type = &glattice;
+      }
+    }
+
+    cgiter = MINRES_block(&mpar, &H_pre_block, tmpb, resdb, ndilute);
+
+    for (beta = 0; beta < ndilute; ++beta)
+    {
+      k = beta * n_masses + i;
+#ifdef GAUSSIAN_NOISE
+      spinor_field_sub_assign_f(&resdb[beta], QMR_resdn);
+#endif
+      /* psi_even = D_ee*resd_e */
+      psi_even[k] = psi[k];
+      psi_even[k].type = &glat_even;
+      spinor_field_mul_f(&psi_even[k], (4. + mass[i]), &resdb[beta]);
+      psi_odd[k] = psi[k];
+      psi_odd[k].type = &glat_odd;
+      psi_odd[k].ptr = psi[k].ptr + glat_odd.master_shift;
+    }
+
+    cgiter += ndilute; /* One whole call per source */
+    lprintf("CALC_PROP_CORE", 10, "MINRES_block MVM = %d\n", cgiter);
+  }
+  hmass_pre = mass[0];
+
+  Dphi_block_(psi_odd, psi_even, ndilute * n_masses);
+  for (beta = 0; beta < ndilute; ++beta)
+  {
+    for (i = 0; i < n_masses; ++i)
+    {
+      k = beta * n_masses + i;
+      spinor_field_sub_f(&psi_odd[k], &eta_odd[beta], &psi_odd[k]);
+      spinor_field_mul_f(&psi_odd[k], 1. / (4. + mass[i]), &psi_odd[k]);
+      start_sf_sendrecv(&psi[k]);
+      complete_sf_sendrecv(&psi[k]);
+    }
+  }
+
+  free_spinor_field_f(deta);
+  free(eta_odd);
+}
+#endif
+
+/* psi = D^{-1} eta on the full lattice with the multigrid solver,
+   for the ndilute sources and all the masses */
+static void calc_propagator_mg(spinor_field *psi, spinor_field *eta, int ndilute)
+{
+  mshift_par mpar;
+  double loc_tmp;
+  int beta, i, k, cgiter;
+
+  mpar.err2 = QMR_par.err2;
+  mpar.max_iter = QMR_par.max_iter;
+  mpar.n = 1;
+  mpar.shift = &loc_tmp;
+  mpar.shift[0] = 0;
+  mpar.add_par = mg;
+
+  for (i = 0; i < QMR_par.n; ++i)
+  {
+    lprintf("CALC_PROPAGATOR", 10, "n masses=%d, mass = %g\n", QMR_par.n, mass[i]);
+    hmass_pre = mass[i];
+    mg->mass = mass[i];
+    for (beta = 0; beta < ndilute; ++beta)
+    {
+      k = beta * QMR_par.n + i;
+      error(eta[beta].type != &glattice, 1, "calc_prop.c", "The multigrid solver needs sources on the full lattice");
+      //if the solution vector is empty use zero guess
+      if (spinor_field_sqnorm_f(&psi[k]) < 1e-28)
+      {
+        spinor_field_zero_f(&psi[k]);
+      }
+      cgiter = mg_solve(&mpar, &D_full, &eta[beta], &psi[k]);
+      lprintf("CALC_PROP_CORE", 10, "MG MVM = %d\n", cgiter);
+      start_sf_sendrecv(&psi[k]);
+      complete_sf_sendrecv(&psi[k]);
+    }
+  }
+  hmass_pre = mass[0];
+}
+
 #if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
 
 static void calc_propagator_clover(spinor_field *dptr, spinor_field *sptr)
@@ -425,6 +622,14 @@ static void calc_propagator_clover(spinor_field *dptr, spinor_field *sptr)
 
 void calc_propagator(spinor_field *psi, spinor_field *eta, int ndilute)
 {
+  if (mg != NULL)
+  {
+    calc_propagator_mg(psi, eta, ndilute);
+    return;
+  }
+#if !defined(WITH_CLOVER) && !defined(WITH_EXPCLOVER)
+  calc_propagator_block(psi, eta, ndilute);
+#else
   int beta, i, n_masses;
   double *m;
   m = mass;
@@ -436,17 +641,14 @@ void calc_propagator(spinor_field *psi, spinor_field *eta, int ndilute)
     {
       lprintf("CALC_PROPAGATOR", 10, "n masses=%d, mass = %g\n", n_masses, mass[0]);
       hmass_pre = mass[0];
-#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
       calc_propagator_clover(&psi[beta * n_masses + i], &eta[beta]);
-#else
-      calc_propagator_core(&psi[beta * n_masses + i], &eta[beta], _g5QMR);
-#endif
       mass++;
     }
     mass = m;
   }
   QMR_par.n = n_masses;
   hmass_pre = mass[0];
+#endif
 }
 
 void calc_propagator_eo(spinor_field *psi, spinor_field *eta, int ndilute)
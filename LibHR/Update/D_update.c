@@ -4,6 +4,7 @@
 #include "memory.h"
 #include "global.h"
 #include "logger.h"
+#include "error.h"
 
 static double static_mass=0.;
 static double static_mu=0.;
@@ -78,6 +79,16 @@ void H_flt(spinor_field_flt *out, spinor_field_flt *in){
 #endif
 }
 
+void H2_flt(spinor_field_flt *out, spinor_field_flt *in){
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+  error(1, 1, "H2_flt [D_update.c]", "Single precision clover operator not available");
+#elif defined(UPDATE_EO)
+  g5Dphi_eopre_sq_flt(static_mass, out, in);
+#else
+  g5Dphi_sq_flt(static_mass, out, in);
+#endif
+}
+
 void D(spinor_field *out, spinor_field *in){
 #ifdef UPDATE_EO
 #if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
@@ -41,6 +41,8 @@ static spinor_field *gtmp = NULL;
 static spinor_field *etmp = NULL;
 static spinor_field *otmp = NULL;
 static spinor_field *otmp2 = NULL;
+static spinor_field *otmp_block = NULL;
+static int n_otmp_block = 0;
 
 static void free_mem()
 {
@@ -64,6 +66,12 @@ static void free_mem()
     free_spinor_field_f(otmp2);
     otmp2 = NULL;
   }
+  if (otmp_block != NULL)
+  {
+    free_spinor_field_f(otmp_block);
+    otmp_block = NULL;
+    n_otmp_block = 0;
+  }
   init_dirac = 1;
 }
 
@@ -167,6 +175,203 @@ unsigned long int getMVM()
 
 #endif
 
+/*
+ * Hopping term on the site ix
+ */
+static inline void Dphi_site(spinor_field *out, spinor_field *in, int ix)
+{
+  int iy;
+  suNf *up, *um;
+  suNf_vector psi, chi, psi2, chi2;
+  suNf_spinor *r, *sp, *sm;
+#if defined(BC_T_THETA) || defined(BC_X_THETA) || defined(BC_Y_THETA) || defined(BC_Z_THETA)
+  suNf_vector vtmp;
+#endif
+
+  r = _FIELD_AT(out, ix);
+
+  /******************************* direction +0 *********************************/
+
+  iy = iup(ix, 0);
+  sp = _FIELD_AT(in, iy);
+  up = pu_gauge_f(ix, 0);
+
+  _vector_add_f(psi, (*sp).c[0], (*sp).c[2]);
+  _vector_add_f(psi2, (*sp).c[1], (*sp).c[3]);
+  _suNf_theta_T_multiply(chi, (*up), psi);
+  _suNf_theta_T_multiply(chi2, (*up), psi2);
+
+  (*r).c[0] = chi;
+  (*r).c[2] = chi;
+  (*r).c[1] = chi2;
+  (*r).c[3] = chi2;
+
+  /******************************* direction -0 *********************************/
+
+  iy = idn(ix, 0);
+  sm = _FIELD_AT(in, iy);
+  um = pu_gauge_f(iy, 0);
+
+  _vector_sub_f(psi, (*sm).c[0], (*sm).c[2]);
+  _vector_sub_f(psi2, (*sm).c[1], (*sm).c[3]);
+  _suNf_theta_T_inverse_multiply(chi, (*um), psi);
+  _suNf_theta_T_inverse_multiply(chi2, (*um), psi2);
+
+  _vector_add_assign_f((*r).c[0], chi);
+  _vector_sub_assign_f((*r).c[2], chi);
+  _vector_add_assign_f((*r).c[1], chi2);
+  _vector_sub_assign_f((*r).c[3], chi2);
+
+  /******************************* direction +1 *********************************/
+
+  iy = iup(ix, 1);
+  sp = _FIELD_AT(in, iy);
+  up = pu_gauge_f(ix, 1);
+
+  _vector_i_add_f(psi, (*sp).c[0], (*sp).c[3]);
+  _vector_i_add_f(psi2, (*sp).c[1], (*sp).c[2]);
+  _suNf_theta_X_multiply(chi, (*up), psi);
+  _suNf_theta_X_multiply(chi2, (*up), psi2);
+
+  _vector_add_assign_f((*r).c[0], chi);
+  _vector_i_sub_assign_f((*r).c[3], chi);
+  _vector_add_assign_f((*r).c[1], chi2);
+  _vector_i_sub_assign_f((*r).c[2], chi2);
+
+  /******************************* direction -1 *********************************/
+
+  iy = idn(ix, 1);
+  sm = _FIELD_AT(in, iy);
+  um = pu_gauge_f(iy, 1);
+
+  _vector_i_sub_f(psi, (*sm).c[0], (*sm).c[3]);
+  _vector_i_sub_f(psi2, (*sm).c[1], (*sm).c[2]);
+  _suNf_theta_X_inverse_multiply(chi, (*um), psi);
+  _suNf_theta_X_inverse_multiply(chi2, (*um), psi2);
+
+  _vector_add_assign_f((*r).c[0], chi);
+  _vector_i_add_assign_f((*r).c[3], chi);
+  _vector_add_assign_f((*r).c[1], chi2);
+  _vector_i_add_assign_f((*r).c[2], chi2);
+
+  /******************************* direction +2 *********************************/
+
+  iy = iup(ix, 2);
+  sp = _FIELD_AT(in, iy);
+  up = pu_gauge_f(ix, 2);
+
+  _vector_add_f(psi, (*sp).c[0], (*sp).c[3]);
+  _vector_sub_f(psi2, (*sp).c[1], (*sp).c[2]);
+  _suNf_theta_Y_multiply(chi, (*up), psi);
+  _suNf_theta_Y_multiply(chi2, (*up), psi2);
+
+  _vector_add_assign_f((*r).c[0], chi);
+  _vector_add_assign_f((*r).c[3], chi);
+  _vector_add_assign_f((*r).c[1], chi2);
+  _vector_sub_assign_f((*r).c[2], chi2);
+
+  /******************************* direction -2 *********************************/
+
+  iy = idn(ix, 2);
+  sm = _FIELD_AT(in, iy);
+  um = pu_gauge_f(iy, 2);
+
+  _vector_sub_f(psi, (*sm).c[0], (*sm).c[3]);
+  _vector_add_f(psi2, (*sm).c[1], (*sm).c[2]);
+  _suNf_theta_Y_inverse_multiply(chi, (*um), psi);
+  _suNf_theta_Y_inverse_multiply(chi2, (*um), psi2);
+
+  _vector_add_assign_f((*r).c[0], chi);
+  _vector_sub_assign_f((*r).c[3], chi);
+  _vector_add_assign_f((*r).c[1], chi2);
+  _vector_add_assign_f((*r).c[2], chi2);
+
+  /******************************* direction +3 *********************************/
+
+  iy = iup(ix, 3);
+  sp = _FIELD_AT(in, iy);
+  up = pu_gauge_f(ix, 3);
+
+  _vector_i_add_f(psi, (*sp).c[0], (*sp).c[2]);
+  _vector_i_sub_f(psi2, (*sp).c[1], (*sp).c[3]);
+  _suNf_theta_Z_multiply(chi, (*up), psi);
+  _suNf_theta_Z_multiply(chi2, (*up), psi2);
+
+  _vector_add_assign_f((*r).c[0], chi);
+  _vector_i_sub_assign_f((*r).c[2], chi);
+  _vector_add_assign_f((*r).c[1], chi2);
+  _vector_i_add_assign_f((*r).c[3], chi2);
+
+  /******************************* direction -3 *********************************/
+
+  iy = idn(ix, 3);
+  sm = _FIELD_AT(in, iy);
+  um = pu_gauge_f(iy, 3);
+
+  _vector_i_sub_f(psi, (*sm).c[0], (*sm).c[2]);
+  _vector_i_add_f(psi2, (*sm).c[1], (*sm).c[3]);
+  _suNf_theta_Z_inverse_multiply(chi, (*um), psi);
+  _suNf_theta_Z_inverse_multiply(chi2, (*um), psi2);
+
+  _vector_add_assign_f((*r).c[0], chi);
+  _vector_i_add_assign_f((*r).c[2], chi);
+  _vector_add_assign_f((*r).c[1], chi2);
+  _vector_i_sub_assign_f((*r).c[3], chi2);
+
+  /******************************** end of loop *********************************/
+
+  _spinor_mul_f(*r, -0.5, *r);
+}
+
+#ifdef WITH_COMM_OVERLAP
+/*
+ * Dphi_ with the halo exchange overlapped to the computation:
+ * the master thread drives the communications while the other threads
+ * work on the inner sites; each boundary piece is computed as soon as
+ * the faces it needs have arrived.
+ */
+static void Dphi_overlap(spinor_field *out, spinor_field *in)
+{
+  sf_overlap *ov;
+
+  start_sf_sendrecv(in);
+  ov = sf_overlap_start(out->type, in->type, in->comm_req);
+
+  _OMP_PRAGMA(_omp_parallel)
+  {
+    int ninner = 0;
+#ifdef _OPENMP
+    if (omp_get_thread_num() == 0 && omp_get_num_threads() > 1)
+      sf_overlap_progress(ov);
+#endif
+    for (int ip = 0; ip < out->type->inner_master_pieces; ip++)
+    {
+      _OMP_PRAGMA(for schedule(dynamic, 64) nowait)
+      for (int ix = out->type->master_start[ip]; ix <= out->type->master_end[ip]; ix++)
+      {
+        Dphi_site(out, in, ix);
+        ninner++;
+      }
+    }
+    if (ninner > 0)
+      sf_overlap_inner_done(ov);
+
+    for (int k = 0; k < ov->npieces; k++)
+    {
+      const int ip = sf_overlap_next_piece(ov, k);
+      _OMP_PRAGMA(for schedule(dynamic, 64) nowait)
+      for (int ix = out->type->master_start[ip]; ix <= out->type->master_end[ip]; ix++)
+      {
+        Dphi_site(out, in, ix);
+      }
+    }
+  }
+
+  complete_sf_sendrecv(in);
+  sf_overlap_end(ov);
+}
+#endif
+
 /*
  * This function defines the massless Dirac operator
  * It can act on spinors defined on the whole lattice 
@@ -185,8 +390,30 @@ void Dphi_(spinor_field *out, spinor_field *in)
 #endif
 
   ++MVMcounter; /* count matrix calls */
+  ++cost_cnt.mvm;
   if (out->type == &glattice)
+  {
     ++MVMcounter;
+    ++cost_cnt.mvm;
+  }
+
+#ifdef WITH_SIMD_LAYOUT
+  /* use the site-blocked kernel once the blocked links are available */
+  if (u_gauge_f_simd != NULL)
+  {
+    Dphi_simd_(out, in);
+    return;
+  }
+#endif
+#ifdef WITH_PROJECTED_HALO
+  /* exchange only the spin-projected half-spinors */
+  Dphi_proj_(out, in);
+  return;
+#endif
+#ifdef WITH_COMM_OVERLAP
+  Dphi_overlap(out, in);
+  return;
+#endif
 
   /************************ loop over all lattice sites *************************/
   /* start communication of input spinor field */
@@ -209,149 +436,78 @@ void Dphi_(spinor_field *out, spinor_field *in)
 #endif
     _SITE_FOR(out->type, ixp, ix)
     {
+      Dphi_site(out, in, ix);
+    } /* SITE_FOR */
+  }   /* PIECE FOR */
+}
 
-      int iy;
-      suNf *up, *um;
-      suNf_vector psi, chi, psi2, chi2;
-      suNf_spinor *r, *sp, *sm;
-#if defined(BC_T_THETA) || defined(BC_X_THETA) || defined(BC_Y_THETA) || defined(BC_Z_THETA)
-      suNf_vector vtmp;
+/*
+ * Massless Dirac operator applied to a block of n spinor fields,
+ * out[k] = Dphi_ in[k].
+ * The halo of the n fields is exchanged with one message per buffer and
+ * the n fields are updated in the same loop over sites, so that the links
+ * are loaded once for the whole block.
+ */
+void Dphi_block_(spinor_field *out, spinor_field *in, int n)
+{
+  error((in == NULL) || (out == NULL), 1, "Dphi_block_ [Dphi.c]",
+        "Attempt to access unallocated memory space");
+#ifdef CHECK_SPINOR_MATCHING
+  for (int k = 0; k < n; k++)
+  {
+    error(out[k].type != out->type || in[k].type != in->type, 1, "Dphi_block_ [Dphi.c]",
+          "All the spinors in a block must be defined on the same lattice");
+    for (int j = 0; j < n; j++)
+      error(out[k].ptr == in[j].ptr, 1, "Dphi_block_ [Dphi.c]",
+            "Input and output fields must be different");
+  }
+  error(out->type == &glat_even && in->type == &glat_even, 1, "Dphi_block_ [Dphi.c]", "Spinors don't match! (1)");
+  error(out->type == &glat_odd && in->type == &glat_odd, 1, "Dphi_block_ [Dphi.c]", "Spinors don't match! (2)");
 #endif
 
-      r = _FIELD_AT(out, ix);
-
-      /******************************* direction +0 *********************************/
-
-      iy = iup(ix, 0);
-      sp = _FIELD_AT(in, iy);
-      up = pu_gauge_f(ix, 0);
-
-      _vector_add_f(psi, (*sp).c[0], (*sp).c[2]);
-      _vector_add_f(psi2, (*sp).c[1], (*sp).c[3]);
-      _suNf_theta_T_multiply(chi, (*up), psi);
-      _suNf_theta_T_multiply(chi2, (*up), psi2);
-
-      (*r).c[0] = chi;
-      (*r).c[2] = chi;
-      (*r).c[1] = chi2;
-      (*r).c[3] = chi2;
-
-      /******************************* direction -0 *********************************/
-
-      iy = idn(ix, 0);
-      sm = _FIELD_AT(in, iy);
-      um = pu_gauge_f(iy, 0);
-
-      _vector_sub_f(psi, (*sm).c[0], (*sm).c[2]);
-      _vector_sub_f(psi2, (*sm).c[1], (*sm).c[3]);
-      _suNf_theta_T_inverse_multiply(chi, (*um), psi);
-      _suNf_theta_T_inverse_multiply(chi2, (*um), psi2);
-
-      _vector_add_assign_f((*r).c[0], chi);
-      _vector_sub_assign_f((*r).c[2], chi);
-      _vector_add_assign_f((*r).c[1], chi2);
-      _vector_sub_assign_f((*r).c[3], chi2);
-
-      /******************************* direction +1 *********************************/
-
-      iy = iup(ix, 1);
-      sp = _FIELD_AT(in, iy);
-      up = pu_gauge_f(ix, 1);
-
-      _vector_i_add_f(psi, (*sp).c[0], (*sp).c[3]);
-      _vector_i_add_f(psi2, (*sp).c[1], (*sp).c[2]);
-      _suNf_theta_X_multiply(chi, (*up), psi);
-      _suNf_theta_X_multiply(chi2, (*up), psi2);
-
-      _vector_add_assign_f((*r).c[0], chi);
-      _vector_i_sub_assign_f((*r).c[3], chi);
-      _vector_add_assign_f((*r).c[1], chi2);
-      _vector_i_sub_assign_f((*r).c[2], chi2);
-
-      /******************************* direction -1 *********************************/
-
-      iy = idn(ix, 1);
-      sm = _FIELD_AT(in, iy);
-      um = pu_gauge_f(iy, 1);
-
-      _vector_i_sub_f(psi, (*sm).c[0], (*sm).c[3]);
-      _vector_i_sub_f(psi2, (*sm).c[1], (*sm).c[2]);
-      _suNf_theta_X_inverse_multiply(chi, (*um), psi);
-      _suNf_theta_X_inverse_multiply(chi2, (*um), psi2);
-
-      _vector_add_assign_f((*r).c[0], chi);
-      _vector_i_add_assign_f((*r).c[3], chi);
-      _vector_add_assign_f((*r).c[1], chi2);
-      _vector_i_add_assign_f((*r).c[2], chi2);
-
-      /******************************* direction +2 *********************************/
-
-      iy = iup(ix, 2);
-      sp = _FIELD_AT(in, iy);
-      up = pu_gauge_f(ix, 2);
-
-      _vector_add_f(psi, (*sp).c[0], (*sp).c[3]);
-      _vector_sub_f(psi2, (*sp).c[1], (*sp).c[2]);
-      _suNf_theta_Y_multiply(chi, (*up), psi);
-      _suNf_theta_Y_multiply(chi2, (*up), psi2);
-
-      _vector_add_assign_f((*r).c[0], chi);
-      _vector_add_assign_f((*r).c[3], chi);
-      _vector_add_assign_f((*r).c[1], chi2);
-      _vector_sub_assign_f((*r).c[2], chi2);
-
-      /******************************* direction -2 *********************************/
-
-      iy = idn(ix, 2);
-      sm = _FIELD_AT(in, iy);
-      um = pu_gauge_f(iy, 2);
-
-      _vector_sub_f(psi, (*sm).c[0], (*sm).c[3]);
-      _vector_add_f(psi2, (*sm).c[1], (*sm).c[2]);
-      _suNf_theta_Y_inverse_multiply(chi, (*um), psi);
-      _suNf_theta_Y_inverse_multiply(chi2, (*um), psi2);
-
-      _vector_add_assign_f((*r).c[0], chi);
-      _vector_sub_assign_f((*r).c[3], chi);
-      _vector_add_assign_f((*r).c[1], chi2);
-      _vector_add_assign_f((*r).c[2], chi2);
-
-      /******************************* direction +3 *********************************/
-
-      iy = iup(ix, 3);
-      sp = _FIELD_AT(in, iy);
-      up = pu_gauge_f(ix, 3);
-
-      _vector_i_add_f(psi, (*sp).c[0], (*sp).c[2]);
-      _vector_i_sub_f(psi2, (*sp).c[1], (*sp).c[3]);
-      _suNf_theta_Z_multiply(chi, (*up), psi);
-      _suNf_theta_Z_multiply(chi2, (*up), psi2);
-
-      _vector_add_assign_f((*r).c[0], chi);
-      _vector_i_sub_assign_f((*r).c[2], chi);
-      _vector_add_assign_f((*r).c[1], chi2);
-      _vector_i_add_assign_f((*r).c[3], chi2);
-
-      /******************************* direction -3 *********************************/
-
-      iy = idn(ix, 3);
-      sm = _FIELD_AT(in, iy);
-      um = pu_gauge_f(iy, 3);
-
-      _vector_i_sub_f(psi, (*sm).c[0], (*sm).c[2]);
-      _vector_i_add_f(psi2, (*sm).c[1], (*sm).c[3]);
-      _suNf_theta_Z_inverse_multiply(chi, (*um), psi);
-      _suNf_theta_Z_inverse_multiply(chi2, (*um), psi2);
-
-      _vector_add_assign_f((*r).c[0], chi);
-      _vector_i_add_assign_f((*r).c[2], chi);
-      _vector_add_assign_f((*r).c[1], chi2);
-      _vector_i_sub_assign_f((*r).c[3], chi2);
-
-      /******************************** end of loop *********************************/
+#if defined(WITH_SIMD_LAYOUT) || defined(WITH_PROJECTED_HALO)
+  /* these kernels have their own halo exchange */
+#ifdef WITH_SIMD_LAYOUT
+  if (u_gauge_f_simd != NULL)
+#endif
+  {
+    for (int k = 0; k < n; k++)
+      Dphi_(&out[k], &in[k]);
+    return;
+  }
+#endif
 
-      _spinor_mul_f(*r, -0.5, *r);
+  MVMcounter += n; /* count matrix calls */
+  cost_cnt.mvm += n;
+  if (out->type == &glattice)
+  {
+    MVMcounter += n;
+    cost_cnt.mvm += n;
+  }
 
+  /************************ loop over all lattice sites *************************/
+  /* start communication of the input spinor fields */
+  _OMP_PRAGMA(master)
+  {
+    start_sf_sendrecv_block(in, n);
+  }
+  _PIECE_FOR(out->type, ixp)
+  {
+#ifdef WITH_MPI
+    if (ixp == out->type->inner_master_pieces)
+    {
+      /* wait for the spinors to be transfered */
+      _OMP_PRAGMA(master)
+      {
+        complete_sf_sendrecv_block(in, n);
+      }
+      _OMP_PRAGMA(barrier)
+    }
+#endif
+    _SITE_FOR(out->type, ixp, ix)
+    {
+      for (int k = 0; k < n; k++)
+        Dphi_site(&out[k], &in[k], ix);
     } /* SITE_FOR */
   }   /* PIECE FOR */
 }
@@ -980,6 +1136,86 @@ void g5Dphi_eopre_sq(double m0, spinor_field *out, spinor_field *in)
   g5Dphi_eopre(m0, out, etmp);
 }
 
+/* out = D_EO D_OE in for a block of n spinor fields on the even lattice */
+static void Dphi_eopre_block_hop(spinor_field *out, spinor_field *in, int n)
+{
+  /* alloc memory for the temporary block */
+  if (n > n_otmp_block)
+  {
+    if (otmp_block != NULL)
+      free_spinor_field_f(otmp_block);
+    otmp_block = alloc_spinor_field_f(n, &glat_odd);
+    n_otmp_block = n;
+    if (init_dirac)
+    {
+      init_Dirac();
+    }
+  }
+
+  for (int k = 0; k < n; k++)
+    apply_BCs_on_spinor_field(&in[k]);
+
+  Dphi_block_(otmp_block, in, n);
+  for (int k = 0; k < n; k++)
+    apply_BCs_on_spinor_field(&otmp_block[k]);
+  Dphi_block_(out, otmp_block, n);
+}
+
+/* Dphi_eopre applied to a block of n spinor fields on the even lattice */
+void Dphi_eopre_block(double m0, spinor_field *out, spinor_field *in, int n)
+{
+  double rho;
+
+  error((in == NULL) || (out == NULL), 1, "Dphi_eopre_block [Dphi.c]",
+        "Attempt to access unallocated memory space");
+
+#ifdef CHECK_SPINOR_MATCHING
+  for (int k = 0; k < n; k++)
+    error(out[k].type != &glat_even || in[k].type != &glat_even, 1, "Dphi_eopre_block " __FILE__, "Spinors are not defined on even lattice!");
+#endif /* CHECK_SPINOR_MATCHING */
+
+  Dphi_eopre_block_hop(out, in, n);
+
+  rho = 4.0 + m0;
+
+  rho *= -rho; /* this minus sign is taken into account below */
+
+  for (int k = 0; k < n; k++)
+  {
+    spinor_field_mul_add_assign_f(&out[k], rho, &in[k]);
+    spinor_field_minus_f(&out[k], &out[k]);
+    apply_BCs_on_spinor_field(&out[k]);
+  }
+}
+
+/* g5Dphi_eopre applied to a block of n spinor fields on the even lattice */
+void g5Dphi_eopre_block(double m0, spinor_field *out, spinor_field *in, int n)
+{
+  double rho;
+
+  error((in == NULL) || (out == NULL), 1, "g5Dphi_eopre_block [Dphi.c]",
+        "Attempt to access unallocated memory space");
+
+#ifdef CHECK_SPINOR_MATCHING
+  for (int k = 0; k < n; k++)
+    error(out[k].type != &glat_even || in[k].type != &glat_even, 1, "g5Dphi_eopre_block " __FILE__, "Spinors are not defined on even lattice!");
+#endif /* CHECK_SPINOR_MATCHING */
+
+  Dphi_eopre_block_hop(out, in, n);
+
+  rho = 4.0 + m0;
+
+  rho *= -rho; /* this minus sign is taken into account below */
+
+  for (int k = 0; k < n; k++)
+  {
+    spinor_field_mul_add_assign_f(&out[k], rho, &in[k]);
+    spinor_field_minus_f(&out[k], &out[k]);
+    spinor_field_g5_assign_f(&out[k]);
+    apply_BCs_on_spinor_field(&out[k]);
+  }
+}
+
 /* g5Dhi ^2 */
 void g5Dphi_sq(double m0, spinor_field *out, spinor_field *in)
 {
@@ -1077,17 +1313,16 @@ static void Cphi_(double mass, spinor_field *dptr, spinor_field *sptr, int assig
   // Correct mass term
   mass = (4. + mass);
 
-  suNf_vector v1, v2;
-  suNf_spinor *out, *in, tmp;
-#if defined(GAUGE_SPN) && defined(REPR_FUNDAMENTAL)
-  suNffull *s0, *s1, *s2, *s3;
-#else
-  suNfc *s0, *s1, *s2, *s3;
-#endif
-
   // Loop over local sites
   _MASTER_FOR(dptr->type, ix)
   {
+    suNf_vector v1, v2;
+    suNf_spinor *out, *in, tmp;
+#if defined(GAUGE_SPN) && defined(REPR_FUNDAMENTAL)
+    suNffull *s0, *s1, *s2, *s3;
+#else
+    suNfc *s0, *s1, *s2, *s3;
+#endif
 
     // Field pointers
     out = _FIELD_AT(dptr, ix);
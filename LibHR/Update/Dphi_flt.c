@@ -152,6 +152,163 @@ _vector_mulc_star_f((r),eitheta_flt[3],vtmp)
 #endif
 
 
+/*
+ * hopping term at one site: r = -1/2 sum_mu [ (1-g_mu) u[2mu] s[2mu] + (1+g_mu) u[2mu+1]^dag s[2mu+1] ]
+ * s[2mu], s[2mu+1] are the spinors at x+mu and x-mu,
+ * u[2mu], u[2mu+1] the links U(x,mu) and U(x-mu,mu)
+ */
+static inline void Dphi_flt_site(suNf_spinor_flt *r, suNf_spinor_flt *const *s, suNf_flt *const *u) __attribute__((always_inline));
+static inline void Dphi_flt_site(suNf_spinor_flt *r, suNf_spinor_flt *const *s, suNf_flt *const *u)
+{
+   suNf_flt *up,*um;
+   suNf_vector_flt psi,chi;
+   suNf_spinor_flt *sp,*sm;
+#if defined(BC_T_THETA) || defined(BC_X_THETA) || defined(BC_Y_THETA) || defined(BC_Z_THETA)
+   suNf_vector_flt vtmp;
+#endif
+
+/******************************* direction +0 *********************************/
+   
+   sp=s[0];
+   up=u[0];
+   
+   _vector_add_f(psi,(*sp).c[0],(*sp).c[2]);
+   _suNf_theta_T_multiply(chi,(*up),psi);
+   
+   (*r).c[0]=chi;
+   (*r).c[2]=chi;
+   
+   _vector_add_f(psi,(*sp).c[1],(*sp).c[3]);
+   _suNf_theta_T_multiply(chi,(*up),psi);
+   
+   (*r).c[1]=chi;
+   (*r).c[3]=chi;
+   
+/******************************* direction -0 *********************************/
+   
+   sm=s[1];
+   um=u[1];
+   
+   _vector_sub_f(psi,(*sm).c[0],(*sm).c[2]);
+   _suNf_theta_T_inverse_multiply(chi,(*um),psi);
+   
+   _vector_add_assign_f((*r).c[0],chi);
+   _vector_sub_assign_f((*r).c[2],chi);
+   
+   _vector_sub_f(psi,(*sm).c[1],(*sm).c[3]);
+   _suNf_theta_T_inverse_multiply(chi,(*um),psi);
+   
+   _vector_add_assign_f((*r).c[1],chi);
+   _vector_sub_assign_f((*r).c[3],chi);
+   
+/******************************* direction +1 *********************************/
+   
+   sp=s[2];
+   up=u[2];
+   
+   _vector_i_add_f(psi,(*sp).c[0],(*sp).c[3]);
+   _suNf_theta_X_multiply(chi,(*up),psi);
+   
+   _vector_add_assign_f((*r).c[0],chi);
+   _vector_i_sub_assign_f((*r).c[3],chi);
+   
+   _vector_i_add_f(psi,(*sp).c[1],(*sp).c[2]);
+   _suNf_theta_X_multiply(chi,(*up),psi);
+   
+   _vector_add_assign_f((*r).c[1],chi);
+   _vector_i_sub_assign_f((*r).c[2],chi);
+   
+/******************************* direction -1 *********************************/
+   
+   sm=s[3];
+   um=u[3];
+   
+   _vector_i_sub_f(psi,(*sm).c[0],(*sm).c[3]);
+   _suNf_theta_X_inverse_multiply(chi,(*um),psi);
+   
+   _vector_add_assign_f((*r).c[0],chi);
+   _vector_i_add_assign_f((*r).c[3],chi);
+   
+   _vector_i_sub_f(psi,(*sm).c[1],(*sm).c[2]);
+   _suNf_theta_X_inverse_multiply(chi,(*um),psi);
+   
+   _vector_add_assign_f((*r).c[1],chi);
+   _vector_i_add_assign_f((*r).c[2],chi);
+   
+/******************************* direction +2 *********************************/
+   
+   sp=s[4];
+   up=u[4];
+   
+   _vector_add_f(psi,(*sp).c[0],(*sp).c[3]);
+   _suNf_theta_Y_multiply(chi,(*up),psi);
+   
+   _vector_add_assign_f((*r).c[0],chi);
+   _vector_add_assign_f((*r).c[3],chi);
+   
+   _vector_sub_f(psi,(*sp).c[1],(*sp).c[2]);
+   _suNf_theta_Y_multiply(chi,(*up),psi);
+   
+   _vector_add_assign_f((*r).c[1],chi);
+   _vector_sub_assign_f((*r).c[2],chi);
+   
+/******************************* direction -2 *********************************/
+   
+   sm=s[5];
+   um=u[5];
+   
+   _vector_sub_f(psi,(*sm).c[0],(*sm).c[3]);
+   _suNf_theta_Y_inverse_multiply(chi,(*um),psi);
+   
+   _vector_add_assign_f((*r).c[0],chi);
+   _vector_sub_assign_f((*r).c[3],chi);
+   
+   _vector_add_f(psi,(*sm).c[1],(*sm).c[2]);
+   _suNf_theta_Y_inverse_multiply(chi,(*um),psi);
+   
+   _vector_add_assign_f((*r).c[1],chi);
+   _vector_add_assign_f((*r).c[2],chi);
+
+/******************************* direction +3 *********************************/
+
+   sp=s[6];
+   up=u[6];
+   
+   _vector_i_add_f(psi,(*sp).c[0],(*sp).c[2]);
+   _suNf_theta_Z_multiply(chi,(*up),psi);
+   
+   _vector_add_assign_f((*r).c[0],chi);
+   _vector_i_sub_assign_f((*r).c[2],chi);
+   
+   _vector_i_sub_f(psi,(*sp).c[1],(*sp).c[3]);
+   _suNf_theta_Z_multiply(chi,(*up),psi);
+   
+   _vector_add_assign_f((*r).c[1],chi);
+   _vector_i_add_assign_f((*r).c[3],chi);
+   
+/******************************* direction -3 *********************************/
+   
+   sm=s[7];
+   um=u[7];
+   
+   _vector_i_sub_f(psi,(*sm).c[0],(*sm).c[2]);
+   _suNf_theta_Z_inverse_multiply(chi,(*um),psi);
+   
+   _vector_add_assign_f((*r).c[0],chi);
+   _vector_i_add_assign_f((*r).c[2],chi);
+   
+   _vector_i_add_f(psi,(*sm).c[1],(*sm).c[3]);
+   _suNf_theta_Z_inverse_multiply(chi,(*um),psi);
+   
+   _vector_add_assign_f((*r).c[1],chi);
+   _vector_i_sub_assign_f((*r).c[3],chi);
+   
+/******************************** end of loop *********************************/
+
+   _spinor_mul_f(*r,-0.5f,*r);
+}
+
+
 /*
  * NOTE :
  * here we are making the assumption that the geometry is such that
@@ -183,6 +340,15 @@ void Dphi_flt_(spinor_field_flt *out, spinor_field_flt *in)
 
     ++MVMcounter; /* count matrix call */
    if(out->type==&glattice) ++MVMcounter;
+   cost_cnt.mvm_flt += (out->type==&glattice) ? 2 : 1;
+
+#ifdef WITH_SIMD_LAYOUT
+   /* use the site-blocked kernel once the blocked links are available */
+   if(u_gauge_f_simd_flt!=NULL) {
+     Dphi_flt_simd_(out,in);
+     return;
+   }
+#endif
  
 /************************ loop over all lattice sites *************************/
    /* start communication of input spinor field */
@@ -197,163 +363,18 @@ void Dphi_flt_(spinor_field_flt *out, spinor_field_flt *in)
      }
      _SITE_FOR(out->type,ixp,ix) {
 
-       int iy;
-       suNf_flt *up,*um;
-       suNf_vector_flt psi,chi;
-       suNf_spinor_flt *r=0,*sp,*sm;
-#if defined(BC_T_THETA) || defined(BC_X_THETA) || defined(BC_Y_THETA) || defined(BC_Z_THETA)
-       suNf_vector_flt vtmp;
-#endif
-       
-       r=_FIELD_AT(out,ix);
- 
-/******************************* direction +0 *********************************/
-       
-       iy=iup(ix,0);
-       sp=_FIELD_AT(in,iy);
-       up=pu_gauge_f_flt(ix,0);
-       
-       _vector_add_f(psi,(*sp).c[0],(*sp).c[2]);
-       _suNf_theta_T_multiply(chi,(*up),psi);
-       
-       (*r).c[0]=chi;
-       (*r).c[2]=chi;
-       
-       _vector_add_f(psi,(*sp).c[1],(*sp).c[3]);
-       _suNf_theta_T_multiply(chi,(*up),psi);
-       
-       (*r).c[1]=chi;
-       (*r).c[3]=chi;
-       
-/******************************* direction -0 *********************************/
-       
-       iy=idn(ix,0);
-       sm=_FIELD_AT(in,iy);
-       um=pu_gauge_f_flt(iy,0);
-       
-       _vector_sub_f(psi,(*sm).c[0],(*sm).c[2]);
-       _suNf_theta_T_inverse_multiply(chi,(*um),psi);
-       
-       _vector_add_assign_f((*r).c[0],chi);
-       _vector_sub_assign_f((*r).c[2],chi);
-       
-       _vector_sub_f(psi,(*sm).c[1],(*sm).c[3]);
-       _suNf_theta_T_inverse_multiply(chi,(*um),psi);
-       
-       _vector_add_assign_f((*r).c[1],chi);
-       _vector_sub_assign_f((*r).c[3],chi);
-       
-/******************************* direction +1 *********************************/
-       
-       iy=iup(ix,1);
-       sp=_FIELD_AT(in,iy);
-       up=pu_gauge_f_flt(ix,1);
-       
-       _vector_i_add_f(psi,(*sp).c[0],(*sp).c[3]);
-       _suNf_theta_X_multiply(chi,(*up),psi);
-       
-       _vector_add_assign_f((*r).c[0],chi);
-       _vector_i_sub_assign_f((*r).c[3],chi);
-       
-       _vector_i_add_f(psi,(*sp).c[1],(*sp).c[2]);
-       _suNf_theta_X_multiply(chi,(*up),psi);
-       
-       _vector_add_assign_f((*r).c[1],chi);
-       _vector_i_sub_assign_f((*r).c[2],chi);
-       
-/******************************* direction -1 *********************************/
-       
-       iy=idn(ix,1);
-       sm=_FIELD_AT(in,iy);
-       um=pu_gauge_f_flt(iy,1);
-       
-       _vector_i_sub_f(psi,(*sm).c[0],(*sm).c[3]);
-       _suNf_theta_X_inverse_multiply(chi,(*um),psi);
-       
-       _vector_add_assign_f((*r).c[0],chi);
-       _vector_i_add_assign_f((*r).c[3],chi);
-       
-       _vector_i_sub_f(psi,(*sm).c[1],(*sm).c[2]);
-       _suNf_theta_X_inverse_multiply(chi,(*um),psi);
-       
-       _vector_add_assign_f((*r).c[1],chi);
-       _vector_i_add_assign_f((*r).c[2],chi);
-       
-/******************************* direction +2 *********************************/
-       
-       iy=iup(ix,2);
-       sp=_FIELD_AT(in,iy);
-       up=pu_gauge_f_flt(ix,2);
-       
-       _vector_add_f(psi,(*sp).c[0],(*sp).c[3]);
-       _suNf_theta_Y_multiply(chi,(*up),psi);
-       
-       _vector_add_assign_f((*r).c[0],chi);
-       _vector_add_assign_f((*r).c[3],chi);
-       
-       _vector_sub_f(psi,(*sp).c[1],(*sp).c[2]);
-       _suNf_theta_Y_multiply(chi,(*up),psi);
-       
-       _vector_add_assign_f((*r).c[1],chi);
-       _vector_sub_assign_f((*r).c[2],chi);
-       
-/******************************* direction -2 *********************************/
-       
-       iy=idn(ix,2);
-       sm=_FIELD_AT(in,iy);
-       um=pu_gauge_f_flt(iy,2);
-       
-       _vector_sub_f(psi,(*sm).c[0],(*sm).c[3]);
-       _suNf_theta_Y_inverse_multiply(chi,(*um),psi);
-       
-       _vector_add_assign_f((*r).c[0],chi);
-       _vector_sub_assign_f((*r).c[3],chi);
-       
-       _vector_add_f(psi,(*sm).c[1],(*sm).c[2]);
-       _suNf_theta_Y_inverse_multiply(chi,(*um),psi);
-       
-       _vector_add_assign_f((*r).c[1],chi);
-       _vector_add_assign_f((*r).c[2],chi);
+       suNf_spinor_flt *s[8];
+       suNf_flt *u[8];
 
-/******************************* direction +3 *********************************/
-
-       iy=iup(ix,3);
-       sp=_FIELD_AT(in,iy);
-       up=pu_gauge_f_flt(ix,3);
-       
-       _vector_i_add_f(psi,(*sp).c[0],(*sp).c[2]);
-       _suNf_theta_Z_multiply(chi,(*up),psi);
-       
-       _vector_add_assign_f((*r).c[0],chi);
-       _vector_i_sub_assign_f((*r).c[2],chi);
-       
-       _vector_i_sub_f(psi,(*sp).c[1],(*sp).c[3]);
-       _suNf_theta_Z_multiply(chi,(*up),psi);
-       
-       _vector_add_assign_f((*r).c[1],chi);
-       _vector_i_add_assign_f((*r).c[3],chi);
-       
-/******************************* direction -3 *********************************/
-       
-       iy=idn(ix,3);
-       sm=_FIELD_AT(in,iy);
-       um=pu_gauge_f_flt(iy,3);
-       
-       _vector_i_sub_f(psi,(*sm).c[0],(*sm).c[2]);
-       _suNf_theta_Z_inverse_multiply(chi,(*um),psi);
-       
-       _vector_add_assign_f((*r).c[0],chi);
-       _vector_i_add_assign_f((*r).c[2],chi);
-       
-       _vector_i_add_f(psi,(*sm).c[1],(*sm).c[3]);
-       _suNf_theta_Z_inverse_multiply(chi,(*um),psi);
-       
-       _vector_add_assign_f((*r).c[1],chi);
-       _vector_i_sub_assign_f((*r).c[3],chi);
-       
-/******************************** end of loop *********************************/
+       for (int mu=0; mu<4; mu++) {
+         const int iy=idn(ix,mu);
+         s[2*mu]=_FIELD_AT(in,iup(ix,mu));
+         s[2*mu+1]=_FIELD_AT(in,iy);
+         u[2*mu]=pu_gauge_f_flt(ix,mu);
+         u[2*mu+1]=pu_gauge_f_flt(iy,mu);
+       }
 
-       _spinor_mul_f(*r,-0.5f,*r);
+       Dphi_flt_site(_FIELD_AT(out,ix),s,u);
      } /* SITE_FOR */
    } /* PIECE FOR */
 }
@@ -582,12 +603,160 @@ void g5Dphi_sq_flt(double m0, spinor_field_flt *out, spinor_field_flt *in) {
 }
 
 
+/*
+ * Half precision: spinors and links are stored as 16-bit fixed point
+ * (spinor_field.h) and converted to single precision at each site,
+ * where the hopping term is computed by Dphi_flt_site.
+ * The boundary conditions on the spinors are not applied: these operators
+ * are meant for inner solves which are corrected in higher precision.
+ */
+
+static int init_half=1;
+static spinor_field_half *gtmp_half=NULL;
+static spinor_field_half *etmp_half=NULL;
+static spinor_field_half *otmp_half=NULL;
+
+static void free_mem_half() {
+    if (gtmp_half!=NULL) { free_spinor_field_f_half(gtmp_half); gtmp_half=NULL; }
+    if (etmp_half!=NULL) { free_spinor_field_f_half(etmp_half); etmp_half=NULL; }
+    if (otmp_half!=NULL) { free_spinor_field_f_half(otmp_half); otmp_half=NULL; }
+    init_half=1;
+}
 
+static void init_Dirac_half() {
+    if (init_half) {
+        gtmp_half=alloc_spinor_field_f_half(1,&glattice);
+        etmp_half=alloc_spinor_field_f_half(1,&glat_even);
+        otmp_half=alloc_spinor_field_f_half(1,&glat_odd);
+        atexit(&free_mem_half);
+        init_half=0;
+    }
+}
+
+/* out = [g5] ( b Dphi_(in) + a diag ), diag may be NULL */
+static void Dphi_half_gen(spinor_field_half *out, spinor_field_half *in, spinor_field_half *diag, float a, float b, int g5)
+{
+   error((in==NULL)||(out==NULL),1,"Dphi_half_ [Dphi_flt.c]",
+         "Attempt to access unallocated memory space");
 
+   error(in==out,1,"Dphi_half_ [Dphi_flt.c]",
+         "Input and output fields must be different");
 
+   error(u_gauge_f_half==NULL,1,"Dphi_half_ [Dphi_flt.c]",
+         "Half precision gauge field not initialized (assign_ud2u_f_half)");
 
+#ifdef CHECK_SPINOR_MATCHING
+   error(out->type==&glat_even && in->type!=&glat_odd,1,"Dphi_half_ [Dphi_flt.c]", "Spinors don't match!");
+   error(out->type==&glat_odd && in->type!=&glat_even,1,"Dphi_half_ [Dphi_flt.c]", "Spinors don't match!");
+   error(out->type==&glattice && in->type!=&glattice,1,"Dphi_half_ [Dphi_flt.c]", "Spinors don't match!");
+   error(diag!=NULL && diag->type!=out->type,1,"Dphi_half_ [Dphi_flt.c]", "Spinors don't match!");
+#endif /* CHECK_SPINOR_MATCHING */
 
+#if defined(BC_T_THETA) || defined(BC_X_THETA) || defined(BC_Y_THETA) || defined(BC_Z_THETA)
+    eitheta_flt[0]=(hr_complex_flt)eitheta[0];
+    eitheta_flt[1]=(hr_complex_flt)eitheta[1];
+    eitheta_flt[2]=(hr_complex_flt)eitheta[2];
+    eitheta_flt[3]=(hr_complex_flt)eitheta[3];
+#endif
 
+   ++MVMcounter; /* count matrix call */
+   if(out->type==&glattice) ++MVMcounter;
+   cost_cnt.mvm_flt += (out->type==&glattice) ? 2 : 1;
 
+   start_sf_sendrecv_half(in);
 
+   _PIECE_FOR(out->type,ixp) {
+     if(ixp==out->type->inner_master_pieces) {
+       _OMP_PRAGMA( master )
+       complete_sf_sendrecv_half(in);
+       _OMP_PRAGMA( barrier )
+     }
+     _SITE_FOR(out->type,ixp,ix) {
 
+       suNf_spinor_flt sf[8], r, *s[8];
+       suNf_flt uf[8], *u[8];
+
+       for (int mu=0; mu<4; mu++) {
+         const int iy=idn(ix,mu);
+         _spinor_half2flt(sf[2*mu],*_FIELD_AT(in,iup(ix,mu)));
+         _spinor_half2flt(sf[2*mu+1],*_FIELD_AT(in,iy));
+         _suNf_half2flt(uf[2*mu],*pu_gauge_f_half(ix,mu));
+         _suNf_half2flt(uf[2*mu+1],*pu_gauge_f_half(iy,mu));
+         s[2*mu]=&sf[2*mu];
+         s[2*mu+1]=&sf[2*mu+1];
+         u[2*mu]=&uf[2*mu];
+         u[2*mu+1]=&uf[2*mu+1];
+       }
+
+       Dphi_flt_site(&r,s,u);
+
+       if (b!=1.f) {
+         _spinor_mul_f(r,b,r);
+       }
+       if (diag!=NULL) {
+         suNf_spinor_flt d;
+         _spinor_half2flt(d,*_FIELD_AT(diag,ix));
+         _spinor_mul_add_assign_f(r,a,d);
+       }
+       if (g5) {
+         _spinor_g5_assign_f(r);
+       }
+       _spinor_flt2half(*_FIELD_AT(out,ix),r);
+     } /* SITE_FOR */
+   } /* PIECE FOR */
+}
+
+void Dphi_half_(spinor_field_half *out, spinor_field_half *in)
+{
+   Dphi_half_gen(out,in,NULL,0.f,1.f,0);
+}
+
+void Dphi_half(double m0, spinor_field_half *out, spinor_field_half *in)
+{
+#ifdef CHECK_SPINOR_MATCHING
+   error(out->type!=&glattice || in->type!=&glattice,1,"Dphi_half [Dphi_flt.c]", "Spinors are not defined on all the lattice!");
+#endif /* CHECK_SPINOR_MATCHING */
+
+   Dphi_half_gen(out,in,in,4.f+(float)(m0),1.f,0);
+}
+
+void g5Dphi_half(double m0, spinor_field_half *out, spinor_field_half *in)
+{
+#ifdef CHECK_SPINOR_MATCHING
+   error(out->type!=&glattice || in->type!=&glattice,1,"g5Dphi_half [Dphi_flt.c]", "Spinors are not defined on all the lattice!");
+#endif /* CHECK_SPINOR_MATCHING */
+
+   Dphi_half_gen(out,in,in,4.f+(float)(m0),1.f,1);
+}
+
+void g5Dphi_sq_half(double m0, spinor_field_half *out, spinor_field_half *in)
+{
+  if (init_half) init_Dirac_half();
+
+  g5Dphi_half(m0, gtmp_half, in);
+  g5Dphi_half(m0, out, gtmp_half);
+}
+
+/* g5 ( (4+m0)^2 in - D_EO D_OE in ) on the even lattice */
+void g5Dphi_eopre_half(double m0, spinor_field_half *out, spinor_field_half *in)
+{
+  float rho;
+
+#ifdef CHECK_SPINOR_MATCHING
+  error(out->type!=&glat_even || in->type!=&glat_even,1,"g5Dphi_eopre_half " __FILE__, "Spinors are not defined on even lattice!");
+#endif /* CHECK_SPINOR_MATCHING */
+
+  if (init_half) init_Dirac_half();
+
+  rho=4.f+(float)(m0);
+  Dphi_half_(otmp_half, in);
+  Dphi_half_gen(out,otmp_half,in,rho*rho,-1.f,1);
+}
+
+void g5Dphi_eopre_sq_half(double m0, spinor_field_half *out, spinor_field_half *in)
+{
+  if (init_half) init_Dirac_half();
+
+  g5Dphi_eopre_half(m0, etmp_half, in);
+  g5Dphi_eopre_half(m0, out, etmp_half);
+}
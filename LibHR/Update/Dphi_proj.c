@@ -0,0 +1,242 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *
+* All rights reserved.                                                      *
+\***************************************************************************/
+
+/*******************************************************************************
+*
+* File Dphi_proj.c
+*
+* Massless Wilson-Dirac operator with the spin-projected halo exchange
+* (see Geometry/communications_proj.c).
+* Enabled with -DWITH_PROJECTED_HALO, in which case Dphi_ uses it.
+*
+* Neighbours on other processes are not stored in the halo of the input
+* field: their half-spinors, already multiplied by U^dagger for the
+* backward directions, are read from the receive buffer and reconstructed
+* on the fly.
+*
+*******************************************************************************/
+
+#include "suN.h"
+#include "global.h"
+#include "error.h"
+#include "dirac.h"
+#include "spinor_field.h"
+#include "geometry.h"
+#include "communications.h"
+
+#ifdef WITH_PROJECTED_HALO
+
+/* reconstruction of the lower components, r += conj(projection) c */
+#define _hrecon_add(r, c) _vector_add_assign_f(r, c)
+#define _hrecon_sub(r, c) _vector_sub_assign_f(r, c)
+#define _hrecon_i_add(r, c) _vector_i_sub_assign_f(r, c)
+#define _hrecon_i_sub(r, c) _vector_i_add_assign_f(r, c)
+
+/* theta boundary conditions: c *= e^{i theta_mu} or e^{-i theta_mu} */
+#define _theta_mul(c, mu)            \
+  _vector_mulc_f(vtmp, eitheta[mu], c); \
+  (c) = vtmp
+
+#define _theta_mul_star(c, mu)            \
+  _vector_mulc_star_f(vtmp, eitheta[mu], c); \
+  (c) = vtmp
+
+#ifdef BC_T_THETA
+#define _THETA_T_MUL(c) _theta_mul(c, 0)
+#define _THETA_T_MUL_STAR(c) _theta_mul_star(c, 0)
+#else
+#define _THETA_T_MUL(c)
+#define _THETA_T_MUL_STAR(c)
+#endif
+
+#ifdef BC_X_THETA
+#define _THETA_X_MUL(c) _theta_mul(c, 1)
+#define _THETA_X_MUL_STAR(c) _theta_mul_star(c, 1)
+#else
+#define _THETA_X_MUL(c)
+#define _THETA_X_MUL_STAR(c)
+#endif
+
+#ifdef BC_Y_THETA
+#define _THETA_Y_MUL(c) _theta_mul(c, 2)
+#define _THETA_Y_MUL_STAR(c) _theta_mul_star(c, 2)
+#else
+#define _THETA_Y_MUL(c)
+#define _THETA_Y_MUL_STAR(c)
+#endif
+
+#ifdef BC_Z_THETA
+#define _THETA_Z_MUL(c) _theta_mul(c, 3)
+#define _THETA_Z_MUL_STAR(c) _theta_mul_star(c, 3)
+#else
+#define _THETA_Z_MUL(c)
+#define _THETA_Z_MUL_STAR(c)
+#endif
+
+/* forward hop: r += (1 - gamma_mu) U(x,mu) psi(x+mu) */
+#define _PROJ_HOP_UP(_mu, _p, _opA, _q, _opB, _theta)          \
+  iy = iup(ix, _mu);                                           \
+  up = pu_gauge_f(ix, _mu);                                    \
+  if (slot[iy] < 0)                                            \
+  {                                                            \
+    sp = _FIELD_AT(in, iy);                                    \
+    _vector_##_opA##_f(psi, (*sp).c[0], (*sp).c[_p]);          \
+    _vector_##_opB##_f(psi2, (*sp).c[1], (*sp).c[_q]);         \
+  }                                                            \
+  else                                                         \
+  {                                                            \
+    psi = hbuf[slot[iy]].c[0];                                 \
+    psi2 = hbuf[slot[iy]].c[1];                                \
+  }                                                            \
+  _suNf_multiply(chi, (*up), psi);                             \
+  _suNf_multiply(chi2, (*up), psi2);                           \
+  _theta(chi);                                                 \
+  _theta(chi2);                                                \
+  _vector_add_assign_f((*r).c[0], chi);                        \
+  _vector_add_assign_f((*r).c[1], chi2);                       \
+  _hrecon_##_opA((*r).c[_p], chi);                             \
+  _hrecon_##_opB((*r).c[_q], chi2)
+
+/* backward hop: r += (1 + gamma_mu) U^dagger(x-mu,mu) psi(x-mu) */
+#define _PROJ_HOP_DN(_mu, _p, _opA, _q, _opB, _theta)          \
+  iy = idn(ix, _mu);                                           \
+  if (slot[iy] < 0)                                            \
+  {                                                            \
+    sm = _FIELD_AT(in, iy);                                    \
+    um = pu_gauge_f(iy, _mu);                                  \
+    _vector_##_opA##_f(psi, (*sm).c[0], (*sm).c[_p]);          \
+    _vector_##_opB##_f(psi2, (*sm).c[1], (*sm).c[_q]);         \
+    _suNf_inverse_multiply(chi, (*um), psi);                   \
+    _suNf_inverse_multiply(chi2, (*um), psi2);                 \
+  }                                                            \
+  else                                                         \
+  {                                                            \
+    chi = hbuf[slot[iy]].c[0];                                 \
+    chi2 = hbuf[slot[iy]].c[1];                                \
+  }                                                            \
+  _theta(chi);                                                 \
+  _theta(chi2);                                                \
+  _vector_add_assign_f((*r).c[0], chi);                        \
+  _vector_add_assign_f((*r).c[1], chi2);                       \
+  _hrecon_##_opA((*r).c[_p], chi);                             \
+  _hrecon_##_opB((*r).c[_q], chi2)
+
+static inline void Dphi_proj_site(spinor_field *out, spinor_field *in, int ix,
+                                  int *slot, suNf_hspinor *hbuf)
+{
+  int iy;
+  suNf *up, *um;
+  suNf_vector psi, chi, psi2, chi2;
+  suNf_spinor *r, *sp, *sm;
+#if defined(BC_T_THETA) || defined(BC_X_THETA) || defined(BC_Y_THETA) || defined(BC_Z_THETA)
+  suNf_vector vtmp;
+#endif
+
+  r = _FIELD_AT(out, ix);
+  _spinor_zero_f(*r);
+
+  _PROJ_HOP_UP(0, 2, add, 3, add, _THETA_T_MUL);
+  _PROJ_HOP_DN(0, 2, sub, 3, sub, _THETA_T_MUL_STAR);
+  _PROJ_HOP_UP(1, 3, i_add, 2, i_add, _THETA_X_MUL);
+  _PROJ_HOP_DN(1, 3, i_sub, 2, i_sub, _THETA_X_MUL_STAR);
+  _PROJ_HOP_UP(2, 3, add, 2, sub, _THETA_Y_MUL);
+  _PROJ_HOP_DN(2, 3, sub, 2, add, _THETA_Y_MUL_STAR);
+  _PROJ_HOP_UP(3, 2, i_add, 3, i_sub, _THETA_Z_MUL);
+  _PROJ_HOP_DN(3, 2, i_sub, 3, i_add, _THETA_Z_MUL_STAR);
+
+  _spinor_mul_f(*r, -0.5, *r);
+}
+
+#ifdef WITH_COMM_OVERLAP
+/* boundary pieces are computed as soon as their faces have arrived,
+ * see Dphi_overlap in Dphi.c */
+static void Dphi_proj_overlap(spinor_field *out, spinor_field *in, int *slot, suNf_hspinor *hbuf)
+{
+  sf_overlap *ov;
+
+  start_sf_sendrecv_proj(in);
+  ov = sf_overlap_start(out->type, in->type, in->comm_req);
+
+  _OMP_PRAGMA(_omp_parallel)
+  {
+    int ninner = 0;
+#ifdef _OPENMP
+    if (omp_get_thread_num() == 0 && omp_get_num_threads() > 1)
+      sf_overlap_progress(ov);
+#endif
+    for (int ip = 0; ip < out->type->inner_master_pieces; ip++)
+    {
+      _OMP_PRAGMA(for schedule(dynamic, 64) nowait)
+      for (int ix = out->type->master_start[ip]; ix <= out->type->master_end[ip]; ix++)
+      {
+        Dphi_proj_site(out, in, ix, slot, hbuf);
+        ninner++;
+      }
+    }
+    if (ninner > 0)
+      sf_overlap_inner_done(ov);
+
+    for (int k = 0; k < ov->npieces; k++)
+    {
+      const int ip = sf_overlap_next_piece(ov, k);
+      _OMP_PRAGMA(for schedule(dynamic, 64) nowait)
+      for (int ix = out->type->master_start[ip]; ix <= out->type->master_end[ip]; ix++)
+      {
+        Dphi_proj_site(out, in, ix, slot, hbuf);
+      }
+    }
+  }
+
+  complete_sf_sendrecv_proj(in);
+  sf_overlap_end(ov);
+}
+#endif
+
+void Dphi_proj_(spinor_field *out, spinor_field *in)
+{
+  int *slot;
+  suNf_hspinor *hbuf;
+
+#ifdef CHECK_SPINOR_MATCHING
+  error((in == NULL) || (out == NULL), 1, "Dphi_proj_ [Dphi_proj.c]",
+        "Attempt to access unallocated memory space");
+  error(in == out, 1, "Dphi_proj_ [Dphi_proj.c]",
+        "Input and output fields must be different");
+  error(out->type == &glat_even && in->type == &glat_even, 1, "Dphi_proj_ [Dphi_proj.c]", "Spinors don't match! (1)");
+  error(out->type == &glat_odd && in->type == &glat_odd, 1, "Dphi_proj_ [Dphi_proj.c]", "Spinors don't match! (2)");
+#endif
+
+  sf_proj_halo(in->type, &slot, &hbuf);
+
+#ifdef WITH_COMM_OVERLAP
+  Dphi_proj_overlap(out, in, slot, hbuf);
+  return;
+#endif
+
+  /* start communication of input spinor field */
+  _OMP_PRAGMA(master)
+  {
+    start_sf_sendrecv_proj(in);
+  }
+
+  _PIECE_FOR(out->type, ixp)
+  {
+    if (ixp == out->type->inner_master_pieces)
+    {
+      /* wait for the half-spinors to be transfered */
+      _OMP_PRAGMA(master)
+      {
+        complete_sf_sendrecv_proj(in);
+      }
+      _OMP_PRAGMA(barrier)
+    }
+    _SITE_FOR(out->type, ixp, ix)
+    {
+      Dphi_proj_site(out, in, ix, slot, hbuf);
+    } /* SITE_FOR */
+  }   /* PIECE FOR */
+}
+
+#endif /* WITH_PROJECTED_HALO */
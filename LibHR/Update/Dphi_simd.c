@@ -0,0 +1,231 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *
+* All rights reserved.                                                      *
+\***************************************************************************/
+
+/*******************************************************************************
+*
+* File Dphi_simd.c
+*
+* Action of the massless Wilson-Dirac operator using the site-blocked
+* (AoSoA) copy of the represented gauge field.
+* Enabled with -DWITH_SIMD_LAYOUT; SIMD_VLEN sets the number of sites per
+* block (4 for AVX2 double precision, 8 for AVX-512).
+*
+* The spinor fields keep the standard layout, so the linear algebra,
+* the inverters and the I/O are unchanged: neighbours are gathered into
+* lane-innermost half-spinors and the result is scattered back.
+*
+*******************************************************************************/
+
+#include "suN.h"
+#include "global.h"
+#include "error.h"
+#include "dirac.h"
+#include "spinor_field.h"
+#include "geometry.h"
+#include "communications.h"
+
+#ifdef WITH_SIMD_LAYOUT
+
+/* loop over the site blocks covering the piece [start,end] */
+#define _SIMD_BLOCK_FOR(start, end, ib) \
+  _OMP_PRAGMA(_omp_parallel)            \
+  _OMP_PRAGMA(_omp_for nowait)          \
+  for (int ib = (start) / SIMD_VLEN; ib <= (end) / SIMD_VLEN; ib++)
+
+/* half-spinor projections h = a OP b */
+#define _hproj_add(hr, hi, ar, ai, br, bi) \
+  (hr) = (ar) + (br);                      \
+  (hi) = (ai) + (bi)
+#define _hproj_sub(hr, hi, ar, ai, br, bi) \
+  (hr) = (ar) - (br);                      \
+  (hi) = (ai) - (bi)
+#define _hproj_iadd(hr, hi, ar, ai, br, bi) \
+  (hr) = (ar) - (bi);                       \
+  (hi) = (ai) + (br)
+#define _hproj_isub(hr, hi, ar, ai, br, bi) \
+  (hr) = (ar) + (bi);                       \
+  (hi) = (ai) - (br)
+
+/* reconstruction of the lower components matching the projections above */
+#define _hrecon_add(rr, ri, cr, ci) \
+  (rr) += (cr);                     \
+  (ri) += (ci)
+#define _hrecon_sub(rr, ri, cr, ci) \
+  (rr) -= (cr);                     \
+  (ri) -= (ci)
+#define _hrecon_iadd(rr, ri, cr, ci) \
+  (rr) += (ci);                      \
+  (ri) -= (cr)
+#define _hrecon_isub(rr, ri, cr, ci) \
+  (rr) -= (ci);                      \
+  (ri) += (cr)
+
+/* c = u*h and c = u^dagger*h on the two half-spinor components */
+#if defined(REPR_ADJOINT) || defined(GAUGE_SON)
+
+#define _simd_multiply(cr, ci, u, hr, hi)                      \
+  for (int k = 0; k < 2; k++)                                  \
+    for (int a = 0; a < NF; a++)                               \
+    {                                                          \
+      for (int l = 0; l < SIMD_VLEN; l++)                      \
+      {                                                        \
+        cr[k][a][l] = 0.;                                      \
+        ci[k][a][l] = 0.;                                      \
+      }                                                        \
+      for (int b = 0; b < NF; b++)                             \
+        for (int l = 0; l < SIMD_VLEN; l++)                    \
+        {                                                      \
+          cr[k][a][l] += (u)->re[a * NF + b][l] * hr[k][b][l]; \
+          ci[k][a][l] += (u)->re[a * NF + b][l] * hi[k][b][l]; \
+        }                                                      \
+    }
+
+#define _simd_inverse_multiply(cr, ci, u, hr, hi)              \
+  for (int k = 0; k < 2; k++)                                  \
+    for (int a = 0; a < NF; a++)                               \
+    {                                                          \
+      for (int l = 0; l < SIMD_VLEN; l++)                      \
+      {                                                        \
+        cr[k][a][l] = 0.;                                      \
+        ci[k][a][l] = 0.;                                      \
+      }                                                        \
+      for (int b = 0; b < NF; b++)                             \
+        for (int l = 0; l < SIMD_VLEN; l++)                    \
+        {                                                      \
+          cr[k][a][l] += (u)->re[b * NF + a][l] * hr[k][b][l]; \
+          ci[k][a][l] += (u)->re[b * NF + a][l] * hi[k][b][l]; \
+        }                                                      \
+    }
+
+#else
+
+#define _simd_multiply(cr, ci, u, hr, hi)                                                            \
+  for (int k = 0; k < 2; k++)                                                                        \
+    for (int a = 0; a < NF; a++)                                                                     \
+    {                                                                                                \
+      for (int l = 0; l < SIMD_VLEN; l++)                                                            \
+      {                                                                                              \
+        cr[k][a][l] = 0.;                                                                            \
+        ci[k][a][l] = 0.;                                                                            \
+      }                                                                                              \
+      for (int b = 0; b < NF; b++)                                                                   \
+        for (int l = 0; l < SIMD_VLEN; l++)                                                          \
+        {                                                                                            \
+          cr[k][a][l] += (u)->re[a * NF + b][l] * hr[k][b][l] - (u)->im[a * NF + b][l] * hi[k][b][l]; \
+          ci[k][a][l] += (u)->re[a * NF + b][l] * hi[k][b][l] + (u)->im[a * NF + b][l] * hr[k][b][l]; \
+        }                                                                                            \
+    }
+
+#define _simd_inverse_multiply(cr, ci, u, hr, hi)                                                    \
+  for (int k = 0; k < 2; k++)                                                                        \
+    for (int a = 0; a < NF; a++)                                                                     \
+    {                                                                                                \
+      for (int l = 0; l < SIMD_VLEN; l++)                                                            \
+      {                                                                                              \
+        cr[k][a][l] = 0.;                                                                            \
+        ci[k][a][l] = 0.;                                                                            \
+      }                                                                                              \
+      for (int b = 0; b < NF; b++)                                                                   \
+        for (int l = 0; l < SIMD_VLEN; l++)                                                          \
+        {                                                                                            \
+          cr[k][a][l] += (u)->re[b * NF + a][l] * hr[k][b][l] + (u)->im[b * NF + a][l] * hi[k][b][l]; \
+          ci[k][a][l] += (u)->re[b * NF + a][l] * hi[k][b][l] - (u)->im[b * NF + a][l] * hr[k][b][l]; \
+        }                                                                                            \
+    }
+
+#endif
+
+/* theta boundary conditions: c *= e^{i theta_mu} or e^{-i theta_mu} */
+#define _simd_theta_mul(_mu)                                                 \
+  for (int k = 0; k < 2; k++)                                               \
+    for (int a = 0; a < NF; a++)                                            \
+      for (int l = 0; l < SIMD_VLEN; l++)                                   \
+      {                                                                     \
+        const _REAL tr = cre[k][a][l] * th_re[_mu] - cim[k][a][l] * th_im[_mu]; \
+        cim[k][a][l] = cre[k][a][l] * th_im[_mu] + cim[k][a][l] * th_re[_mu];   \
+        cre[k][a][l] = tr;                                                  \
+      }
+
+#define _simd_theta_mul_star(_mu)                                            \
+  for (int k = 0; k < 2; k++)                                               \
+    for (int a = 0; a < NF; a++)                                            \
+      for (int l = 0; l < SIMD_VLEN; l++)                                   \
+      {                                                                     \
+        const _REAL tr = cre[k][a][l] * th_re[_mu] + cim[k][a][l] * th_im[_mu]; \
+        cim[k][a][l] = cim[k][a][l] * th_re[_mu] - cre[k][a][l] * th_im[_mu];   \
+        cre[k][a][l] = tr;                                                  \
+      }
+
+#ifdef BC_T_THETA
+#define _THETA_T_MUL(_mu) _simd_theta_mul(_mu)
+#define _THETA_T_MUL_STAR(_mu) _simd_theta_mul_star(_mu)
+#else
+#define _THETA_T_MUL(_mu)
+#define _THETA_T_MUL_STAR(_mu)
+#endif
+
+#ifdef BC_X_THETA
+#define _THETA_X_MUL(_mu) _simd_theta_mul(_mu)
+#define _THETA_X_MUL_STAR(_mu) _simd_theta_mul_star(_mu)
+#else
+#define _THETA_X_MUL(_mu)
+#define _THETA_X_MUL_STAR(_mu)
+#endif
+
+#ifdef BC_Y_THETA
+#define _THETA_Y_MUL(_mu) _simd_theta_mul(_mu)
+#define _THETA_Y_MUL_STAR(_mu) _simd_theta_mul_star(_mu)
+#else
+#define _THETA_Y_MUL(_mu)
+#define _THETA_Y_MUL_STAR(_mu)
+#endif
+
+#ifdef BC_Z_THETA
+#define _THETA_Z_MUL(_mu) _simd_theta_mul(_mu)
+#define _THETA_Z_MUL_STAR(_mu) _simd_theta_mul_star(_mu)
+#else
+#define _THETA_Z_MUL(_mu)
+#define _THETA_Z_MUL_STAR(_mu)
+#endif
+
+#define _THETA(mu) eitheta[mu]
+
+/* double precision */
+
+#define _SPINOR_FIELD_TYPE spinor_field
+#define _REAL double
+#define _FUNC(a) a##_simd_
+#define _GAUGE_SIMD u_gauge_f_simd
+#define _START_SENDRECV start_sf_sendrecv
+#define _COMPLETE_SENDRECV complete_sf_sendrecv
+
+#include "TMPL/Dphi_simd.c.sdtmpl"
+
+#undef _SPINOR_FIELD_TYPE
+#undef _REAL
+#undef _FUNC
+#undef _GAUGE_SIMD
+#undef _START_SENDRECV
+#undef _COMPLETE_SENDRECV
+
+/* single precision */
+
+#define _SPINOR_FIELD_TYPE spinor_field_flt
+#define _REAL float
+#define _FUNC(a) a##_flt_simd_
+#define _GAUGE_SIMD u_gauge_f_simd_flt
+#define _START_SENDRECV start_sf_sendrecv_flt
+#define _COMPLETE_SENDRECV complete_sf_sendrecv_flt
+
+#include "TMPL/Dphi_simd.c.sdtmpl"
+
+#undef _SPINOR_FIELD_TYPE
+#undef _REAL
+#undef _FUNC
+#undef _GAUGE_SIMD
+#undef _START_SENDRECV
+#undef _COMPLETE_SENDRECV
+
+#endif /* WITH_SIMD_LAYOUT */
@@ -58,7 +58,7 @@ void init_force_hmc()
 
 void force_hmc(double dt, void *vpar)
 {
-	int n_iters = 0;
+	int n_iters = 0, iter;
 	force_hmc_par *par = (force_hmc_par *)vpar;
 	suNg_av_field *force = *par->momenta;
 	spinor_field *pf = par->pf;
@@ -75,6 +75,18 @@ void force_hmc(double dt, void *vpar)
 	mpar.n = 1;
 	mpar.shift = &tmp;
 	mpar.shift[0] = 0;
+	mpar.add_par = NULL;
+	inverter_ptr inv = &g5QMR_mshift;
+	if (par->mg != NULL)
+	{
+		mpar.add_par = par->mg;
+		inv = &mg_solve;
+	}
+	else if (par->defl != NULL)
+	{
+		mpar.add_par = par->defl;
+		inv = &defl_solve;
+	}
 
 #ifndef UPDATE_EO
 
@@ -83,7 +95,10 @@ void force_hmc(double dt, void *vpar)
 		/* X = H^{-1} pf = D^{-1} g5 pf */
 		spinor_field_zero_f(Xs);
 		spinor_field_g5_assign_f(pf);
-		n_iters += g5QMR_mshift(&mpar, &D, pf, Xs);
+		mre_guess(&par->mpar, 0, Xs, &D, pf);
+		iter = inv(&mpar, &D, pf, Xs);
+		mre_store(&par->mpar, 0, Xs, iter);
+		n_iters += iter;
 		spinor_field_g5_assign_f(pf);
 
 		if (par->hasenbusch == 0)
@@ -109,7 +124,10 @@ void force_hmc(double dt, void *vpar)
 		}
 
 		spinor_field_zero_f(Ys);
-		n_iters += g5QMR_mshift(&mpar, &D, eta, Ys);
+		mre_guess(&par->mpar, 1, Ys, &D, eta);
+		iter = inv(&mpar, &D, eta, Ys);
+		mre_store(&par->mpar, 1, Ys, iter);
+		n_iters += iter;
 	}
 	else
 	{
@@ -125,8 +143,9 @@ void force_hmc(double dt, void *vpar)
 		/* X_o = D_{oe} X_e = D_{oe} H^{-1} pf */
 		spinor_field_g5_assign_f(pf);
 		mre_guess(&par->mpar, 0, Xs, &D, pf);
-		n_iters += g5QMR_mshift(&mpar, &D, pf, Xs);
-		mre_store(&par->mpar, 0, Xs);
+		iter = inv(&mpar, &D, pf, Xs);
+		mre_store(&par->mpar, 0, Xs, iter);
+		n_iters += iter;
 		spinor_field_g5_assign_f(pf);
 
 		/* Y_e = H^{-1} ( g5 pf + b X_e ) */
@@ -143,8 +162,9 @@ void force_hmc(double dt, void *vpar)
 
 		spinor_field_g5_assign_f(eta);
 		mre_guess(&par->mpar, 1, Ys, &D, eta);
-		n_iters += g5QMR_mshift(&mpar, &D, eta, Ys);
-		mre_store(&par->mpar, 1, Ys);
+		iter = inv(&mpar, &D, eta, Ys);
+		mre_store(&par->mpar, 1, Ys, iter);
+		n_iters += iter;
 		spinor_field_g5_assign_f(eta);
 
 		if (par->hasenbusch == 2)
@@ -157,8 +177,9 @@ void force_hmc(double dt, void *vpar)
 	{
 		/* Ye = 1/(QpQm+mu^2) \phi */
 		mre_guess(&par->mpar, 0, Ys, QpQm_tm_alt, pf);
-		n_iters += 2 * cg_mshift(&mpar, QpQm_tm_alt, pf, Ys);
-		mre_store(&par->mpar, 0, Ys);
+		iter = cg_mshift(&mpar, QpQm_tm_alt, pf, Ys);
+		mre_store(&par->mpar, 0, Ys, iter);
+		n_iters += 2 * iter;
 		Qtm_m_alt(Xs, Ys);
 
 		if (par->hasenbusch == 2)
@@ -141,6 +141,7 @@ void force_hmc_ff(double dt, void *vpar){
 #else
     double mass = par->mass;
     spinor_field *pf = par->pf;
+    int iter;
 
     /*    g5QMR_fltacc_par mpar;
     mpar.err2 = par->inv_err2;
@@ -184,8 +185,9 @@ void force_hmc_ff(double dt, void *vpar){
 
     spinor_field_zero_f(&Ye);
     mre_guess( &par->mpar, 0, &Ye, &Dff_sq, &Xe);
-    n_iters+=cg_mshift( &mpar, &Dff_sq, &Xe, &Ye );
-    mre_store( &par->mpar, 0, &Ye);
+    iter = cg_mshift( &mpar, &Dff_sq, &Xe, &Ye );
+    mre_store( &par->mpar, 0, &Ye, iter);
+    n_iters += iter;
     
     Dff(&Xe,&Ye);
 
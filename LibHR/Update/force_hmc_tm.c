@@ -77,7 +77,7 @@ void force_hmc_tm(double dt, void *vpar)
 	Xo.type = &glat_odd;
 	Xo.ptr += glat_odd.master_shift;
 	
-	int n_iters = 0;
+	int n_iters = 0, iter;
 	force_hmc_par *par = (force_hmc_par*)vpar;
 	suNg_av_field *force = *par->momenta;
 	spinor_field *pf = par->pf;
@@ -96,8 +96,9 @@ void force_hmc_tm(double dt, void *vpar)
 	{
 		/* Ye = (\hat{Q}_+ \hat{Q}_-)^(-1)\phi */
 		mre_guess(&par->mpar, 0, Ys, &QpQm_tm, pf);
-		n_iters += 2*cg_mshift(&mpar, QpQm_tm, pf, Ys);
-		mre_store(&par->mpar, 0, Ys);
+		iter = cg_mshift(&mpar, QpQm_tm, pf, Ys);
+		mre_store(&par->mpar, 0, Ys, iter);
+		n_iters += 2 * iter;
 
 		/* Xe = (\hat{Q}+)^-1\phi = \hat{Q}_- * Ye */
 		Qtm_m(Xs, Ys);
@@ -119,9 +120,10 @@ void force_hmc_tm(double dt, void *vpar)
 		Qtm_p(Ys,pf);
 		set_twisted_mass(par->mu);
 		spinor_field_zero_f(Xs);
-		mre_guess(&par->mpar, 0, Xs, &QpQm_tm, pf);
-		n_iters += 2*cg_mshift(&mpar, QpQm_tm, Ys, Xs);
-		mre_store(&par->mpar, 0, Xs);
+		mre_guess(&par->mpar, 0, Xs, &QpQm_tm, Ys);
+		iter = cg_mshift(&mpar, QpQm_tm, Ys, Xs);
+		mre_store(&par->mpar, 0, Xs, iter);
+		n_iters += 2 * iter;
 
 		// Ye = Q_- Xe
 		Qtm_m(Ys, Xs);
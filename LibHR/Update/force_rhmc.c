@@ -76,7 +76,10 @@ void force_rhmc(double dt, void *vpar)
 		#endif
 
 		set_dirac_mass(par->mass);
-		n_iters += cg_mshift(&mpar, &H2, &pf[k], chi);
+		if(par->mixed)
+			n_iters += cg_mshift_flt(&mpar, &H2, &H2_flt, &pf[k], chi);
+		else
+			n_iters += cg_mshift(&mpar, &H2, &pf[k], chi);
 
 		#ifdef TIMING
 		#ifdef TIMING_WITH_BARRIERS
@@ -0,0 +1,216 @@
+/***************************************************************************\
+ * Copyright (c) 2008, Agostino Patella, Claudio Pica                        *
+ * All rights reserved.                                                      *
+\***************************************************************************/
+
+/*******************************************************************************
+ *
+ * File hmc_cost.c
+ *
+ * Cost accounting of the HMC.
+ *
+ * The work done by the process is counted in cost_cnt (global.h): Dirac
+ * operator applications (Dphi.c, Dphi_flt.c), iterations of the solvers used
+ * by the monomials, bytes sent in halo exchanges and global reductions
+ * (communications*.c). Here the differences of the counters and the wall time
+ * between hmc_cost_begin and hmc_cost_end are attributed to a monomial and a
+ * phase of the trajectory: pseudofermion generation, forces, field updates
+ * and final action.
+ *
+ * At the end of each trajectory one JSON line is appended to cost_log:
+ *   {"record":"cost","traj":..,"accepted":..,"dH":..,"time":..,<counters>,
+ *    "monomials":[{"id":..,"type":..,"level":..,"pf":{"calls":..,"time":..,
+ *    <counters>},"force":{..},"field":{..},"action":{..}},..]}
+ * where <counters> are "mvm","mvm_flt" (full lattice applications), "iter",
+ * "halo_bytes" (summed over the processes), "halos" and "reductions".
+ * The times are the maximum over the processes. The totals of the trajectory
+ * include the work not attributed to any monomial (momenta, projections,
+ * Metropolis test). Phases without calls are omitted.
+ *
+ *******************************************************************************/
+
+#include "global.h"
+#include "update.h"
+#include "error.h"
+#include "logger.h"
+#include "communications.h"
+#include "utils.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef struct
+{
+  int calls;
+  double time;
+  cost_counters cnt;
+} cost_entry;
+
+typedef struct
+{
+  const monomial *m;
+  int level;
+  cost_entry ph[COST_NPHASE];
+} cost_mon;
+
+static const char *phase_name[COST_NPHASE] = {"pf", "force", "field", "action"};
+
+static char cost_log[256] = "";
+static cost_mon *cmon = NULL;
+static int ncmon = 0;
+static int ntraj = 0;
+
+static cost_entry traj;
+static struct timeval traj_start, mon_start;
+static cost_counters traj_cnt, mon_cnt;
+
+static double elapsed(struct timeval *start)
+{
+  struct timeval end, etime;
+  gettimeofday(&end, 0);
+  timeval_subtract(&etime, &end, start);
+  return etime.tv_sec + 1.e-6 * etime.tv_usec;
+}
+
+/* d += a - b */
+static void add_diff(cost_counters *d, const cost_counters *a, const cost_counters *b)
+{
+  d->mvm += a->mvm - b->mvm;
+  d->mvm_flt += a->mvm_flt - b->mvm_flt;
+  d->iter += a->iter - b->iter;
+  d->halo_bytes += a->halo_bytes - b->halo_bytes;
+  d->halos += a->halos - b->halos;
+  d->reductions += a->reductions - b->reductions;
+}
+
+void init_hmc_cost(ghmc_par *par)
+{
+  free_hmc_cost();
+  if (par->cost_log[0] == '\0')
+    return;
+
+  strcpy(cost_log, par->cost_log);
+  ncmon = num_mon();
+  cmon = calloc(ncmon, sizeof(*cmon));
+  error(cmon == NULL, 1, "init_hmc_cost [hmc_cost.c]", "Could not allocate memory space for the cost accounting");
+  for (int k = 0; k < ncmon; k++)
+  {
+    cmon[k].m = mon_n(k);
+    cmon[k].level = -1;
+  }
+  for (integrator_par *ip = par->integrator; ip != NULL; ip = ip->next)
+    for (int n = 0; n < ip->nmon; n++)
+      for (int k = 0; k < ncmon; k++)
+        if (cmon[k].m == ip->mon_list[n])
+          cmon[k].level = ip->level;
+  ntraj = 0;
+
+  lprintf("HMC", 0, "Cost of the trajectories appended to %s\n", cost_log);
+}
+
+void free_hmc_cost()
+{
+  free(cmon);
+  cmon = NULL;
+  ncmon = 0;
+  cost_log[0] = '\0';
+}
+
+void hmc_cost_begin()
+{
+  if (cmon == NULL)
+    return;
+  mon_cnt = cost_cnt;
+  gettimeofday(&mon_start, 0);
+}
+
+void hmc_cost_end(const monomial *m, cost_phase phase)
+{
+  if (cmon == NULL)
+    return;
+  const double t = elapsed(&mon_start);
+  for (int k = 0; k < ncmon; k++)
+    if (cmon[k].m == m)
+    {
+      cost_entry *e = cmon[k].ph + phase;
+      e->calls++;
+      e->time += t;
+      add_diff(&e->cnt, &cost_cnt, &mon_cnt);
+      return;
+    }
+}
+
+void hmc_cost_trajectory_begin()
+{
+  if (cmon == NULL)
+    return;
+  for (int k = 0; k < ncmon; k++)
+    memset(cmon[k].ph, 0, sizeof(cmon[k].ph));
+  memset(&traj, 0, sizeof(traj));
+  traj_cnt = cost_cnt;
+  gettimeofday(&traj_start, 0);
+}
+
+static void print_counters(FILE *fp, const cost_counters *c, double halo_bytes)
+{
+  fprintf(fp, "\"mvm\":%.1f,\"mvm_flt\":%.1f,\"iter\":%lu,\"halo_bytes\":%.0f,\"halos\":%lu,\"reductions\":%lu",
+          0.5 * c->mvm, 0.5 * c->mvm_flt, c->iter, halo_bytes, c->halos, c->reductions);
+}
+
+void hmc_cost_trajectory_end(double deltaH, int accepted)
+{
+  if (cmon == NULL)
+    return;
+
+  traj.calls = 1;
+  traj.time = elapsed(&traj_start);
+  add_diff(&traj.cnt, &cost_cnt, &traj_cnt);
+
+  /* times: maximum over the processes, halo bytes: sum */
+  const int n = ncmon * COST_NPHASE + 1;
+  double *t = malloc(2 * n * sizeof(double));
+  double *b = t + n;
+  error(t == NULL, 1, "hmc_cost_trajectory_end [hmc_cost.c]", "Could not allocate memory space for the cost accounting");
+  for (int k = 0; k < ncmon; k++)
+    for (int p = 0; p < COST_NPHASE; p++)
+    {
+      t[k * COST_NPHASE + p] = cmon[k].ph[p].time;
+      b[k * COST_NPHASE + p] = cmon[k].ph[p].cnt.halo_bytes;
+    }
+  t[n - 1] = traj.time;
+  b[n - 1] = traj.cnt.halo_bytes;
+  global_max(t, n);
+  global_sum(b, n);
+
+  ntraj++;
+  lprintf("HMC", 10, "Trajectory cost: %1.6f s, MVM = %.1f ; %.1f (f;d), %lu solver iterations, %.0f halo bytes, %lu reductions\n",
+          t[n - 1], 0.5 * traj.cnt.mvm_flt, 0.5 * traj.cnt.mvm, traj.cnt.iter, b[n - 1], traj.cnt.reductions);
+
+  if (PID == 0)
+  {
+    FILE *fp = fopen(cost_log, "a");
+    error(fp == NULL, 1, "hmc_cost_trajectory_end [hmc_cost.c]", "Unable to open the cost log");
+    fprintf(fp, "{\"record\":\"cost\",\"traj\":%d,\"accepted\":%d,\"dH\":%.8e,\"time\":%.6e,", ntraj, accepted, deltaH, t[n - 1]);
+    print_counters(fp, &traj.cnt, b[n - 1]);
+    fprintf(fp, ",\"monomials\":[");
+    for (int k = 0; k < ncmon; k++)
+    {
+      fprintf(fp, "%s{\"id\":%d,\"type\":\"%s\",\"level\":%d", (k == 0) ? "" : ",", cmon[k].m->data.id,
+              mon_type_name(cmon[k].m->data.type), cmon[k].level);
+      for (int p = 0; p < COST_NPHASE; p++)
+      {
+        const cost_entry *e = cmon[k].ph + p;
+        if (e->calls == 0)
+          continue;
+        fprintf(fp, ",\"%s\":{\"calls\":%d,\"time\":%.6e,", phase_name[p], e->calls, t[k * COST_NPHASE + p]);
+        print_counters(fp, &e->cnt, b[k * COST_NPHASE + p]);
+        fprintf(fp, "}");
+      }
+      fprintf(fp, "}");
+    }
+    fprintf(fp, "]}\n");
+    fclose(fp);
+  }
+
+  free(t);
+}
@@ -0,0 +1,372 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *
+* All rights reserved.                                                      *
+\***************************************************************************/
+
+/*******************************************************************************
+*
+* File hmc_deflation.c
+*
+* Low-mode deflation of the solves in the fermion force.
+*
+* The nev lowest eigenvectors v_k of H2 = (g5 D)^2 are computed with eva when
+* a trajectory starts. In the molecular dynamics the gauge field changes
+* little between two force evaluations, so the v_k are only refined: each
+* Rayleigh-Ritz step projects H2 on the span of the v_k and of their
+* residuals H2 v_k - lambda_k v_k, and keeps the nev lowest Ritz vectors.
+*
+* D out = in is solved as H2 out = D^dag in with the deflated CG of
+* Saad et al., SIAM J. Sci. Comput. 21 (2000) 1909: the low modes are
+* removed from the initial residual and the search directions are kept
+* H2-orthogonal to them, so that the convergence is set by the modes above
+* the nev-th one. The stopping criterion is the one of the CG on the true
+* residual, so the result has the requested precision whatever the accuracy
+* of the v_k.
+*
+*******************************************************************************/
+
+#include "global.h"
+#include "update.h"
+#include "dirac.h"
+#include "inverters.h"
+#include "linear_algebra.h"
+#include "memory.h"
+#include "utils.h"
+#include "error.h"
+#include "logger.h"
+#include <stdlib.h>
+#include <math.h>
+
+#define DEFL_EVA_KMAX 200
+#define DEFL_EVA_IMAX 50
+#define DEFL_MAX_RESTART 5
+
+struct _defl_data
+{
+	geometry_descriptor *type;
+	int nb; /* vectors in the Rayleigh-Ritz basis */
+	spinor_field *b; /* basis, the first nev are the low modes */
+	spinor_field *hb; /* H2 applied to the basis */
+	spinor_field *aw; /* H2 applied to the low modes */
+	spinor_field *w; /* work fields */
+	double *lambda; /* Ritz values */
+	double complex *a, *v; /* projected H2 and its eigenvectors */
+	double *d;
+	double complex *coef;
+	int fresh; /* compute the low modes with eva */
+	double fingerprint;
+	double mass;
+	int mvm; /* applications of H2 for the low modes */
+};
+
+void defl_init(defl_par *defl, int nev, int refine)
+{
+	error(nev < 1, 1, "defl_init [hmc_deflation.c]", "The number of low modes must be positive");
+	defl->nev = nev;
+	defl->refine = refine;
+	defl->data = NULL;
+	lprintf("DEFL", 10, "Deflation of %d low modes, %d Rayleigh-Ritz steps per update\n", nev, refine);
+}
+
+void defl_free(defl_par *defl)
+{
+	struct _defl_data *d = defl->data;
+
+	if (d == NULL)
+		return;
+	free_spinor_field_f(d->b);
+	free_spinor_field_f(d->hb);
+	free_spinor_field_f(d->aw);
+	free_spinor_field_f(d->w);
+	free(d->lambda);
+	free(d->a);
+	free(d->v);
+	free(d->d);
+	free(d->coef);
+	free(d);
+	defl->data = NULL;
+}
+
+/* the low modes are computed again at the next solve */
+void defl_reset(defl_par *defl)
+{
+	if (defl->data != NULL)
+		defl->data->fresh = 1;
+}
+
+static void defl_alloc(defl_par *defl, geometry_descriptor *type)
+{
+	struct _defl_data *d;
+	const int n = 2 * defl->nev;
+
+	d = malloc(sizeof(*d));
+	error(d == NULL, 1, "defl_alloc [hmc_deflation.c]", "Could not allocate memory space for the deflation");
+	d->type = type;
+	d->nb = 0;
+	d->b = alloc_spinor_field_f(n, type);
+	d->hb = alloc_spinor_field_f(n, type);
+	d->aw = alloc_spinor_field_f(defl->nev, type);
+	d->w = alloc_spinor_field_f(4, type);
+	d->lambda = malloc(sizeof(double) * n);
+	d->a = malloc(sizeof(double complex) * n * n);
+	d->v = malloc(sizeof(double complex) * n * n);
+	d->d = malloc(sizeof(double) * n);
+	d->coef = malloc(sizeof(double complex) * defl->nev);
+	d->fresh = 1;
+	d->fingerprint = 0.;
+	d->mass = 0.;
+	d->mvm = 0;
+	defl->data = d;
+}
+
+/*
+ * Rayleigh-Ritz on the basis b[0..n-1], with hb = H2 b: the nev lowest Ritz
+ * vectors become the low modes, with aw = H2 b and lambda their Ritz values
+ */
+static void defl_project(defl_par *defl, int n)
+{
+	struct _defl_data *d = defl->data;
+
+	for (int i = 0; i < n; i++)
+		for (int j = i; j < n; j++)
+		{
+			double complex p = spinor_field_prod_f(&d->b[i], &d->hb[j]);
+			d->a[n * i + j] = p;
+			d->a[n * j + i] = conj(p);
+		}
+	for (int i = 0; i < n; i++)
+		d->a[n * i + i] = creal(d->a[n * i + i]);
+	jacobi2(n, d->a, d->d, d->v);
+
+	if (n < defl->nev)
+		lprintf("DEFL", 10, "Rayleigh-Ritz basis of dimension %d only\n", n);
+	d->nb = (n < defl->nev) ? n : defl->nev;
+	for (int k = 0; k < d->nb; k++)
+	{
+		spinor_field_zero_f(&d->aw[k]);
+		for (int j = 0; j < n; j++)
+			spinor_field_mulc_add_assign_f(&d->aw[k], d->v[n * j + k], &d->hb[j]);
+	}
+	for (int k = 0; k < d->nb; k++)
+	{
+		spinor_field_zero_f(&d->hb[k]);
+		for (int j = 0; j < n; j++)
+			spinor_field_mulc_add_assign_f(&d->hb[k], d->v[n * j + k], &d->b[j]);
+		d->lambda[k] = d->d[k];
+	}
+	for (int k = 0; k < d->nb; k++)
+		spinor_field_copy_f(&d->b[k], &d->hb[k]);
+}
+
+/* low modes from eva, starting from the previous ones if there are any */
+static void defl_compute(defl_par *defl)
+{
+	struct _defl_data *d = defl->data;
+	int status, ie, init;
+	double ubnd;
+
+	d->mvm += max_H(&H2, d->type, &ubnd);
+	init = (d->nb == 0) ? 0 : 2;
+	ie = eva(defl->nev, 2 * defl->nev, init, DEFL_EVA_KMAX, DEFL_EVA_IMAX, 1.1 * ubnd, 1.e-10, 1.e-3, &H2, d->b, d->lambda, &status);
+	d->mvm += status;
+	for (int rep = 0; ie != 0 && rep < DEFL_MAX_RESTART; rep++)
+	{
+		lprintf("DEFL", 10, "Restarting EVA\n");
+		ie = eva(defl->nev, 2 * defl->nev, 2, DEFL_EVA_KMAX, DEFL_EVA_IMAX, 1.1 * ubnd, 1.e-10, 1.e-3, &H2, d->b, d->lambda, &status);
+		d->mvm += status;
+	}
+	/* unconverged modes only make the deflation less effective */
+	if (ie != 0)
+		lprintf("DEFL", 0, "EVA did not converge, using the approximate low modes\n");
+
+	for (int k = 0; k < defl->nev; k++)
+	{
+		H2(&d->hb[k], &d->b[k]);
+		d->mvm++;
+	}
+	defl_project(defl, defl->nev);
+}
+
+/* v = v - sum_{j<n} b_j <b_j, v>, twice */
+static void orthogonalize(spinor_field *v, spinor_field *b, int n)
+{
+	for (int pass = 0; pass < 2; pass++)
+		for (int j = 0; j < n; j++)
+		{
+			double complex p = spinor_field_prod_f(&b[j], v);
+			spinor_field_mulc_add_assign_f(v, -p, &b[j]);
+		}
+}
+
+/* one Rayleigh-Ritz step on the low modes and their residuals */
+static void defl_rayleigh_ritz(defl_par *defl)
+{
+	struct _defl_data *d = defl->data;
+	int n = 0;
+
+	/* orthonormal basis: the low modes, then their residuals */
+	for (int k = 0; k < d->nb; k++)
+	{
+		double norm;
+		orthogonalize(&d->b[k], d->b, n);
+		norm = sqrt(spinor_field_sqnorm_f(&d->b[k]));
+		if (norm > 0.)
+		{
+			spinor_field_mul_f(&d->b[n], 1. / norm, &d->b[k]);
+			n++;
+		}
+	}
+	for (int k = 0; k < n; k++)
+	{
+		H2(&d->hb[k], &d->b[k]);
+		d->mvm++;
+	}
+	for (int k = 0, nv = n; k < nv; k++)
+	{
+		double norm, theta;
+		theta = spinor_field_prod_re_f(&d->b[k], &d->hb[k]);
+		spinor_field_mul_f(&d->b[n], -theta, &d->b[k]);
+		spinor_field_add_assign_f(&d->b[n], &d->hb[k]);
+		orthogonalize(&d->b[n], d->b, n);
+		norm = sqrt(spinor_field_sqnorm_f(&d->b[n]));
+		if (norm > 1.e-10 * fabs(theta))
+		{
+			spinor_field_mul_f(&d->b[n], 1. / norm, &d->b[n]);
+			H2(&d->hb[n], &d->b[n]);
+			d->mvm++;
+			n++;
+		}
+	}
+
+	defl_project(defl, n);
+}
+
+/* brings the low modes up to date with the gauge field and the mass */
+static void defl_update(defl_par *defl, geometry_descriptor *type)
+{
+	struct _defl_data *d = defl->data;
+	double fp, mass = get_dirac_mass();
+
+	if (d != NULL && d->type != type)
+	{
+		defl_free(defl);
+		d = NULL;
+	}
+	if (d == NULL)
+	{
+		defl_alloc(defl, type);
+		d = defl->data;
+	}
+
+	fp = gauge_fingerprint();
+	d->mvm = 0;
+	if (d->fresh)
+	{
+		defl_compute(defl);
+		lprintf("DEFL", 10, "Low modes computed: lambda = [%1.6e, %1.6e], MVM = %d\n", d->lambda[0], d->lambda[d->nb - 1], d->mvm);
+	}
+	else if (fp != d->fingerprint || mass != d->mass)
+	{
+		for (int k = 0; k < defl->refine; k++)
+			defl_rayleigh_ritz(defl);
+		if (defl->refine > 0)
+			lprintf("DEFL", 10, "Low modes refined: lambda = [%1.6e, %1.6e], MVM = %d\n", d->lambda[0], d->lambda[d->nb - 1], d->mvm);
+	}
+
+	d->fresh = 0;
+	d->fingerprint = fp;
+	d->mass = mass;
+}
+
+/* coef_k = <c_k, r> / lambda_k */
+static void defl_coef(struct _defl_data *d, spinor_field *c, spinor_field *r)
+{
+	for (int k = 0; k < d->nb; k++)
+		d->coef[k] = (d->lambda[k] > 0.) ? spinor_field_prod_f(&c[k], r) / d->lambda[k] : 0.;
+}
+
+/* v = v + s sum_k coef_k b_k */
+static void defl_mul_add(struct _defl_data *d, spinor_field *v, double s, spinor_field *b)
+{
+	for (int k = 0; k < d->nb; k++)
+		spinor_field_mulc_add_assign_f(v, s * d->coef[k], &b[k]);
+}
+
+int defl_solve(mshift_par *par, spinor_operator M, spinor_field *in, spinor_field *out)
+{
+	defl_par *defl = (defl_par *)par->add_par;
+	struct _defl_data *d;
+	spinor_field *rhs, *r, *p, *ap;
+	double innorm2, delta, delta_old, alpha, beta;
+	int cgiter = 0, mvm = 0, rep = 0;
+
+	error(defl == NULL, 1, "defl_solve [hmc_deflation.c]", "The deflation parameters must be given in add_par");
+	error(par->n != 1 || par->shift[0] != 0., 1, "defl_solve [hmc_deflation.c]", "Only one vanishing shift is supported");
+
+	defl_update(defl, in->type);
+	d = defl->data;
+	rhs = d->w;
+	r = rhs + 1;
+	p = rhs + 2;
+	ap = rhs + 3;
+
+	/* rhs = D^dag in = g5 D g5 in */
+	spinor_field_g5_f(r, in);
+	H(rhs, r);
+	mvm++;
+	innorm2 = spinor_field_sqnorm_f(rhs);
+
+	do
+	{
+		/* the low modes are removed from the residual */
+		H2(r, out);
+		mvm += 2;
+		spinor_field_sub_f(r, rhs, r);
+		defl_coef(d, d->b, r);
+		defl_mul_add(d, out, 1., d->b);
+		defl_mul_add(d, r, -1., d->aw);
+		spinor_field_copy_f(p, r);
+		defl_coef(d, d->aw, r);
+		defl_mul_add(d, p, -1., d->b);
+		delta = spinor_field_sqnorm_f(r);
+
+		/* deflated CG */
+		while (delta > par->err2 * innorm2 && (par->max_iter == 0 || cgiter < par->max_iter))
+		{
+			H2(ap, p);
+			mvm += 2;
+			cgiter++;
+			alpha = delta / spinor_field_prod_re_f(p, ap);
+			spinor_field_mul_add_assign_f(out, alpha, p);
+			spinor_field_mul_add_assign_f(r, -alpha, ap);
+			delta_old = delta;
+			delta = spinor_field_sqnorm_f(r);
+			beta = delta / delta_old;
+			spinor_field_lc_f(ap, 1., r, beta, p);
+			spinor_field_copy_f(p, ap);
+			defl_coef(d, d->aw, r);
+			defl_mul_add(d, p, -1., d->b);
+		}
+
+		/* true residual */
+		H2(r, out);
+		mvm += 2;
+		spinor_field_sub_assign_f(r, rhs);
+		delta = spinor_field_sqnorm_f(r);
+		if (delta > par->err2 * innorm2)
+		{
+			lprintf("INVERTER", 30, "defl_solve failed: err2 = %1.8e > %1.8e\n", delta / innorm2, par->err2);
+			rep++;
+		}
+	} while (delta > par->err2 * innorm2 && rep < DEFL_MAX_RESTART && (par->max_iter == 0 || cgiter < par->max_iter));
+
+	if (delta > par->err2 * innorm2)
+		lprintf("INVERTER", -10, "defl_solve: precision not reached, err2 = %1.8e > %1.8e\n", delta / innorm2, par->err2);
+
+	lprintf("INVERTER", 10, "defl_solve: MVM = %d/%d (low modes %d)\n", mvm, cgiter, 2 * d->mvm);
+	d->mvm = 0;
+	cost_cnt.iter += cgiter;
+
+	/* applications of D */
+	return mvm;
+}
@@ -5,6 +5,9 @@
 
 #include "global.h"
 #include "update.h"
+#include "memory.h"
+#include "representation.h"
+#include "error.h"
 #include "logger.h"
 
 void monomial_force(double dt, integrator_par *par)
@@ -12,7 +15,16 @@ void monomial_force(double dt, integrator_par *par)
 	for(int n = 0; n < par->nmon; n++)
 	{
 		const monomial *m = par->mon_list[n];
-		m->update_force(dt, m->force_par);
+		hmc_cost_begin();
+		if(ghmc_tune_on)
+		{
+			ghmc_tune_force(dt, m);
+		}
+		else
+		{
+			m->update_force(dt, m->force_par);
+		}
+		hmc_cost_end(m, COST_FORCE);
 	}
 }
 
@@ -23,7 +35,9 @@ void monomial_field(double dt, integrator_par *par)
 		const monomial *m = par->mon_list[n];
 		if(m->update_field)
 		{
+			hmc_cost_begin();
 			m->update_field(dt, m->field_par);
+			hmc_cost_end(m, COST_FIELD);
 		}
 	}
 	if(par->next)
@@ -32,6 +46,73 @@ void monomial_field(double dt, integrator_par *par)
 	}
 }
 
+/*
+ * Force-gradient update of the momenta: exp(dt B + c C) with C = [B,[A,B]].
+ * The force gradient is not computed explicitly: as proposed by H. Yin and
+ * R. Mawhinney (arXiv:1111.5059), the forces of the level are evaluated on
+ * the fields displaced by 2c/dt along the same forces, which reproduces
+ * exp(dt B + c C) up to terms of higher order.
+ * The auxiliary momenta take the place of suN_momenta (and scalar_momenta),
+ * which the monomials reference, and the fields are restored at the end.
+ */
+static void monomial_force_gradient(double dt, double c, integrator_par *par)
+{
+	suNg_av_field *mom = suN_momenta;
+	suNg_scalar_field *smom = scalar_momenta;
+	suNg_field *gsave;
+	suNg_scalar_field *ssave = NULL;
+	field_gauge_par gpar = {&u_gauge, &suN_momenta};
+	field_scalar_par spar = {&u_scalar, &scalar_momenta};
+
+	error(four_fermion_active, 1, "monomial_force_gradient [integrators.c]",
+		  "Force-gradient integrators do not support the four fermion auxiliary fields");
+
+	gsave = alloc_gfield(&glattice);
+	suNg_field_copy(gsave, u_gauge);
+	suN_momenta = alloc_avfield(&glattice);
+	_MASTER_FOR(&glattice, ix)
+	{
+		for (int mu = 0; mu < 4; mu++)
+		{
+			_algebra_vector_zero_g(*_4FIELD_AT(suN_momenta, ix, mu));
+		}
+	}
+	if (u_scalar != NULL)
+	{
+		ssave = alloc_scalar_field(&glattice);
+		suNg_scalar_field_copy(ssave, u_scalar);
+		scalar_momenta = alloc_scalar_field(&glattice);
+		_MASTER_FOR(&glattice, ix)
+		{
+			_vector_zero_g(*_FIELD_AT(scalar_momenta, ix));
+		}
+	}
+
+	/* displacement of the fields along the forces */
+	monomial_force(1., par);
+	update_gauge_field(2. * c / dt, &gpar);
+	if (u_scalar != NULL)
+	{
+		update_scalar_field(2. * c / dt, &spar);
+		free_scalar_field(scalar_momenta);
+		scalar_momenta = smom;
+	}
+	free_avfield(suN_momenta);
+	suN_momenta = mom;
+
+	/* forces on the displaced fields */
+	monomial_force(dt, par);
+
+	suNg_field_copy(u_gauge, gsave);
+	free_gfield(gsave);
+	if (u_scalar != NULL)
+	{
+		suNg_scalar_field_copy(u_scalar, ssave);
+		free_scalar_field(ssave);
+	}
+	represent_gauge_field();
+}
+
 void leapfrog_multistep(double tlen, integrator_par *par)
 {
 	double dt = tlen / par->nsteps;
@@ -135,3 +216,65 @@ void O4MN_multistep(double tlen, integrator_par *par)
 	monomial_force(rho*dt, par);
 }
 
+/* 4th order force-gradient integrator with the force updates at the ends of the step,
+I.P. Omelyan, I.M. Mryglod, R. Folk, Computer Physics Communications 151 (2003) 272-314,
+see also A.D. Kennedy, M.A. Clark, P.J. Silva, arXiv:0910.2950 */
+
+void FG_multistep(double tlen, integrator_par *par)
+{
+	double dt = tlen / par->nsteps;
+	int level = 10+par->level*10;
+
+	if(par->nsteps == 0)
+	{
+		return;
+	}
+
+	lprintf("MD_INT", level, "Starting new MD trajectory with FG_multistep\n");
+	lprintf("MD_INT", level, "MD parameters: level=%d tlen=%1.6f nsteps=%d => dt=%1.6f\n", par->level, tlen, par->nsteps, dt);
+
+	for(int n = 0; n < par->nsteps; n++)
+	{
+		if(n == 0)
+		{
+			monomial_force(dt/6, par);
+		}
+		else
+		{
+			monomial_force(dt/3, par);
+		}
+		monomial_field(dt/2, par);
+		monomial_force_gradient(2*dt/3, dt*dt*dt/72, par);
+		monomial_field(dt/2, par);
+	}
+	monomial_force(dt/6, par);
+}
+
+/* 4th order force-gradient integrator with the field updates at the ends of the step,
+from the same reference */
+
+void FG_pos_multistep(double tlen, integrator_par *par)
+{
+	const double lambda = 0.2113248654051871; /* 1/2-1/(2 sqrt(3)) */
+	const double xi = 0.005582274842315059; /* (2-sqrt(3))/48 */
+
+	double dt = tlen / par->nsteps;
+	int level = 10+par->level*10;
+
+	if(par->nsteps == 0)
+	{
+		return;
+	}
+
+	lprintf("MD_INT", level, "Starting new MD trajectory with FG_pos_multistep\n");
+	lprintf("MD_INT", level, "MD parameters: level=%d tlen=%1.6f nsteps=%d => dt=%1.6f\n", par->level, tlen, par->nsteps, dt);
+
+	for(int n = 0; n < par->nsteps; n++)
+	{
+		monomial_field(lambda*dt, par);
+		monomial_force_gradient(dt/2, xi*dt*dt*dt, par);
+		monomial_field((1-2*lambda)*dt, par);
+		monomial_force_gradient(dt/2, xi*dt*dt*dt, par);
+		monomial_field(lambda*dt, par);
+	}
+}
@@ -69,7 +69,9 @@ void local_hmc_action(local_action_type type,
   {
     const monomial *m = mon_n(i);
 
+    hmc_cost_begin();
     m->add_local_action(m, loc_action);
+    hmc_cost_end(m, COST_ACTION);
   }
 
 }
@@ -19,6 +19,10 @@ void hasen_gaussian_pf(const struct _monomial *m)
 {
 	mon_hasenbusch_par *par = (mon_hasenbusch_par*)(m->data.par);
 	gaussian_spinor_field(par->pf);
+	if(par->fpar.defl != NULL)
+	{
+		defl_reset(par->fpar.defl);
+	}
 }
 
 void hasen_correct_pf(const struct _monomial *m)
@@ -52,12 +56,25 @@ void hasen_correct_la_pf(const struct _monomial *m)
 	mpar.n = 1;
 	mpar.shift = &shift;
 	mpar.shift[0] = 0;
+	mpar.add_par = par->fpar.mg;
 
 	/* compute D(m+dm)D^{-1}(m)*g5*pf */
 	spinor_field_g5_assign_f(par->pf);
 	set_dirac_mass(par->mass);
 	spinor_field_zero_f(tmp_pf);
-	g5QMR_mshift(&mpar, &D, par->pf, tmp_pf);
+	if(par->fpar.mg != NULL)
+	{
+		mg_solve(&mpar, &D, par->pf, tmp_pf);
+	}
+	else if(par->fpar.defl != NULL)
+	{
+		mpar.add_par = par->fpar.defl;
+		defl_solve(&mpar, &D, par->pf, tmp_pf);
+	}
+	else
+	{
+		g5QMR_mshift(&mpar, &D, par->pf, tmp_pf);
+	}
 	set_dirac_mass(par->mass + par->dm);
 	D(par->pf, tmp_pf);
 }
@@ -83,6 +100,18 @@ void hasen_free(struct _monomial *m)
 		free_spinor_field_f(par->pf);
 	}
 
+	if(par->fpar.mg != NULL)
+	{
+		mg_free(par->fpar.mg);
+		free(par->fpar.mg);
+	}
+
+	if(par->fpar.defl != NULL)
+	{
+		defl_free(par->fpar.defl);
+		free(par->fpar.defl);
+	}
+
 	free(par);
 	free(m);
 }
@@ -119,9 +148,31 @@ struct _monomial* hasen_create(const monomial_data *data)
 	par->fpar.mu = 0;
 	par->fpar.logdet = 0;
 	par->fpar.momenta = &suN_momenta;
+	par->fpar.mg = NULL;
+	par->fpar.defl = NULL;
+
+	// Setup multigrid solver
+	if(par->mg_nvec > 0)
+	{
+		par->fpar.mg = malloc(sizeof(mg_par));
+		mg_init(par->fpar.mg, par->mass);
+		par->fpar.mg->nvec = par->mg_nvec;
+		for(int mu = 0; mu < 4; mu++)
+		{
+			par->fpar.mg->block[mu] = par->mg_block;
+		}
+		par->fpar.mg->reuse = 1;
+	}
+
+	// Setup deflation of the low modes
+	if(par->defl_nev > 0)
+	{
+		par->fpar.defl = malloc(sizeof(defl_par));
+		defl_init(par->fpar.defl, par->defl_nev, par->defl_refine);
+	}
 
 	// Setup chronological inverter
-	mre_init(&(par->fpar.mpar), par->mre_past, data->force_prec);
+	mre_init(&(par->fpar.mpar), par->mre_past, par->mre_share, par->mre_half, data->force_prec);
 
 	// Setup pointers to update functions
 	m->free = &hasen_free;
@@ -124,7 +124,7 @@ struct _monomial* hasen_tm_create(const monomial_data *data)
 	par->fpar.momenta = &suN_momenta;
 
 	// Setup chronological inverter
-	mre_init(&(par->fpar.mpar), par->mre_past, data->force_prec);
+	mre_init(&(par->fpar.mpar), par->mre_past, par->mre_share, par->mre_half, data->force_prec);
 
 	// Setup pointers to update functions
 	m->free = &hasen_tm_free;
@@ -20,6 +20,10 @@ void hmc_gaussian_pf(const struct _monomial *m)
 {
 	mon_hmc_par *par = (mon_hmc_par*)(m->data.par);
 	gaussian_spinor_field(par->pf);
+	if(par->fpar.defl != NULL)
+	{
+		defl_reset(par->fpar.defl);
+	}
 }
 
 void hmc_correct_pf(const struct _monomial *m)
@@ -43,12 +47,25 @@ void hmc_correct_la_pf(const struct _monomial *m)
 	mpar.n = 1;
 	mpar.shift = &shift;
 	mpar.shift[0] = 0;
+	mpar.add_par = par->fpar.mg;
    
 	/* compute H2^{-1/2}*pf = H^{-1}*pf */
 	spinor_field_g5_f(tmp_pf, par->pf);
 	set_dirac_mass(par->mass);
 	spinor_field_zero_f(par->pf); /* mshift inverter uses this as initial guess for 1 shift */
-	g5QMR_mshift(&mpar, &D, tmp_pf, par->pf);
+	if(par->fpar.mg != NULL)
+	{
+		mg_solve(&mpar, &D, tmp_pf, par->pf);
+	}
+	else if(par->fpar.defl != NULL)
+	{
+		mpar.add_par = par->fpar.defl;
+		defl_solve(&mpar, &D, tmp_pf, par->pf);
+	}
+	else
+	{
+		g5QMR_mshift(&mpar, &D, tmp_pf, par->pf);
+	}
 }
 
 const spinor_field* hmc_pseudofermion(const struct _monomial *m)
@@ -75,6 +92,18 @@ void hmc_free(struct _monomial *m)
 		free_spinor_field_f(par->pf);
 	}
 
+	if(par->fpar.mg != NULL)
+	{
+		mg_free(par->fpar.mg);
+		free(par->fpar.mg);
+	}
+
+	if(par->fpar.defl != NULL)
+	{
+		defl_free(par->fpar.defl);
+		free(par->fpar.defl);
+	}
+
 	free(par);
 	free(m);
 }
@@ -108,9 +137,31 @@ struct _monomial* hmc_create(const monomial_data *data)
 	par->fpar.mu = 0;
 	par->fpar.logdet = 1;
 	par->fpar.momenta = &suN_momenta;
+	par->fpar.mg = NULL;
+	par->fpar.defl = NULL;
+
+	// Setup multigrid solver
+	if(par->mg_nvec > 0)
+	{
+		par->fpar.mg = malloc(sizeof(mg_par));
+		mg_init(par->fpar.mg, par->mass);
+		par->fpar.mg->nvec = par->mg_nvec;
+		for(int mu = 0; mu < 4; mu++)
+		{
+			par->fpar.mg->block[mu] = par->mg_block;
+		}
+		par->fpar.mg->reuse = 1;
+	}
+
+	// Setup deflation of the low modes
+	if(par->defl_nev > 0)
+	{
+		par->fpar.defl = malloc(sizeof(defl_par));
+		defl_init(par->fpar.defl, par->defl_nev, par->defl_refine);
+	}
 
 	// Setup chronological inverter
-	mre_init(&(par->fpar.mpar), par->mre_past, data->force_prec);
+	mre_init(&(par->fpar.mpar), par->mre_past, par->mre_share, par->mre_half, data->force_prec);
 
 	// Setup pointers to update functions
 	m->free = &hmc_free;
@@ -127,7 +127,7 @@ struct _monomial* hmc_ff_create(const monomial_data *data)
 	par->fpar.momenta = &suN_momenta;
 
 	// Setup chronological inverter
-	mre_init(&(par->fpar.mpar), par->mre_past, data->force_prec);
+	mre_init(&(par->fpar.mpar), par->mre_past, par->mre_share, par->mre_half, data->force_prec);
 
 	// Setup pointers to update functions
 	m->free = &hmc_ff_free;
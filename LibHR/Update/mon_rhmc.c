@@ -12,6 +12,7 @@
 #include "inverters.h"
 #include "rational_functions.h"
 #include "clover_tools.h"
+#include "utils.h"
 #include <stdlib.h>
 
 static spinor_field *tmp_pf = NULL;
@@ -129,6 +130,13 @@ struct _monomial* rhmc_create(const monomial_data *data)
 	par->fpar.n_pf = 1;
 	par->fpar.pf = par->pf;
 	par->fpar.inv_err2 = data->force_prec;
+	par->fpar.mixed = par->mixed_prec;
+	if(par->mixed_prec && u_gauge_f_flt == NULL)
+	{
+		/* single precision links, refreshed by represent_gauge_field */
+		u_gauge_f_flt = alloc_gfield_f_flt(&glattice);
+		assign_ud2u_f();
+	}
 	par->fpar.mass = par->mass;
 	par->ratio.rel_error = data->MD_prec;
 	par->fpar.ratio = &par->ratio;
@@ -106,7 +106,7 @@ struct _monomial* tm_create(const monomial_data *data)
 	par->fpar.momenta = &suN_momenta;
 
 	// Setup chronological inverter
-	mre_init(&(par->fpar.mpar), par->mre_past, data->force_prec);
+	mre_init(&(par->fpar.mpar), par->mre_past, par->mre_share, par->mre_half, data->force_prec);
   
 	// Setup pointers to update functions
 	m->free = &tm_free;
@@ -110,9 +110,11 @@ struct _monomial* tm_alt_create(const monomial_data *data)
 	par->fpar.hasenbusch = 0;
 	par->fpar.logdet = 1;
 	par->fpar.momenta = &suN_momenta;
+	par->fpar.mg = NULL;
+	par->fpar.defl = NULL;
 
 	// Setup chronological inverter
-	mre_init(&(par->fpar.mpar), par->mre_past, data->force_prec);
+	mre_init(&(par->fpar.mpar), par->mre_past, par->mre_share, par->mre_half, data->force_prec);
 
 	// Setup pointers to update functions
 	m->free = &tm_alt_free;
@@ -123,3 +123,13 @@ const monomial *mon_n(int i)
   }
   return curr->m;
 }
+
+/* name of the monomial type in the action file */
+const char *mon_type_name(mon_type type)
+{
+  static const char *names[] = {"gauge", "lw_gauge", "four_fermion", "hmc", "rhmc", "tm", "tm_alt", "hasenbusch",
+                                "hasenbusch_tm", "hasenbusch_tm_alt", "hmc_ff", "hasenbusch_ff", "scalar"};
+  if (type < 0 || type >= sizeof(names) / sizeof(names[0]))
+    return "unknown";
+  return names[type];
+}
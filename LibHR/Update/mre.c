@@ -6,52 +6,74 @@
 * arXiv: hep-lat/9509012                                                   *
 ***************************************************************************/
 
+/*
+ * The past solutions are kept as an orthonormal basis stored in single or
+ * half precision. A new solution is orthogonalised against the basis when it
+ * is stored, taking the place of the oldest vector once the basis is full,
+ * so that the guess only needs the projection of the operator on the basis.
+ * A history can be shared by the mre_par initialized with the same share
+ * group, e.g. by monomials inverting the same operator at different
+ * Hasenbusch masses; the solutions of the slots p = 0, 1 are kept apart.
+ */
+
 #include "update.h"
 #include "linear_algebra.h"
 #include "memory.h"
 #include "global.h"
 #include "dirac.h"
 #include "logger.h"
+#include "error.h"
+#include "utils.h"
+#include "communications.h"
+#include <stdlib.h>
 #include <math.h>
 
-//#define cabs(a) sqrt(_complex_prod_re(a,a))
-#define MAX 15
-
-// Global variables
-static spinor_field *v[MAX];
-static spinor_field *Dv;
-static int num_init = 0;
+typedef struct _mre_history
+{
+	int share; /* share group, 0 => private */
+	int p;	   /* slot */
+	int half;  /* 1 => half precision, 0 => single precision */
+	int max;   /* size of the basis */
+	int num;   /* vectors in the basis */
+	int next;  /* position of the next vector */
+	spinor_field_flt *qf;
+	spinor_field_half *qh;
+	struct _mre_history *link;
+} mre_history;
+
+static mre_history *shared = NULL;
+
+// Work fields
+static spinor_field *w = NULL;
+static spinor_field *Dv = NULL;
 
 // Variables used in in the LU solver
-static double complex A[MAX][MAX];
-static double complex b[MAX];
-static double complex x[MAX];
-static double complex y[MAX];
-static int mutate[MAX];
+static int lu_max = 0;
+static double complex *A = NULL;
+static double complex *b = NULL;
+static double complex *x = NULL;
+static double complex *y = NULL;
+static int *mutate = NULL;
 
-void gram_schmidt(mre_par *par, int p, int max)
-{
-	double complex rij;
-	double rii;
+#define _A(i, j) A[(i)*lu_max + (j)]
 
-	for (int i = 0; i < max; i++)
+static void lu_alloc(int max)
+{
+	if (max <= lu_max)
 	{
-		spinor_field_copy_f(v[i], &par->s[p][i]);
+		return;
 	}
 
-	for (int i = 0; i < max; i++)
-	{
-		rii = spinor_field_sqnorm_f(v[i]);
-		rii = 1.0 / sqrt(rii);
-		spinor_field_mul_f(v[i], rii, v[i]);
-
-		for (int j = i + 1; j < max; j++)
-		{
-			rij = spinor_field_prod_f(v[i], v[j]);
-			_complex_minus(rij, rij);
-			spinor_field_mulc_add_assign_f(v[j], rij, v[i]);
-		}
-	}
+	free(A);
+	free(b);
+	free(mutate);
+	lu_max = max;
+	A = malloc(lu_max * lu_max * sizeof(*A));
+	b = malloc(3 * lu_max * sizeof(*b));
+	x = b + lu_max;
+	y = x + lu_max;
+	mutate = malloc(lu_max * sizeof(*mutate));
+	error(A == NULL || b == NULL || mutate == NULL, 1, "lu_alloc [mre.c]", "Could not allocate memory space for the LU solver");
 }
 
 void lu_solve(int max)
@@ -74,23 +96,23 @@ void lu_solve(int max)
 		{
 			for (int k = 0; k < j; k++)
 			{
-				_complex_mul_sub_assign(A[j][i], A[j][k], A[k][i]);
+				_complex_mul_sub_assign(_A(j, i), _A(j, k), _A(k, i));
 			}
 		}
 
-		big = cabs(A[i][i]);
+		big = cabs(_A(i, i));
 		row = i;
 
 		for (int j = i + 1; j < max; j++)
 		{
 			for (int k = 0; k < i; k++)
 			{
-				_complex_mul_sub_assign(A[j][i], A[j][k], A[k][i]);
+				_complex_mul_sub_assign(_A(j, i), _A(j, k), _A(k, i));
 			}
 
-			if (cabs(A[j][i]) > big)
+			if (cabs(_A(j, i)) > big)
 			{
-				big = cabs(A[j][i]);
+				big = cabs(_A(j, i));
 				row = j;
 			}
 		}
@@ -98,6 +120,10 @@ void lu_solve(int max)
 		if (big < 1.0e-14)
 		{
 			lprintf("MRE", 10, "LU decomposition failed: matrix is singular\n");
+			for (int k = 0; k < max; k++)
+			{
+				x[k] = 0;
+			}
 			return;
 		}
 
@@ -105,9 +131,9 @@ void lu_solve(int max)
 		{
 			for (int k = 0; k < max; k++)
 			{
-				ctmp = A[row][k];
-				A[row][k] = A[i][k];
-				A[i][k] = ctmp;
+				ctmp = _A(row, k);
+				_A(row, k) = _A(i, k);
+				_A(i, k) = ctmp;
 			}
 
 			itmp = mutate[row];
@@ -117,18 +143,18 @@ void lu_solve(int max)
 
 		for (int k = i + 1; k < max; k++)
 		{
-			_complex_div(ctmp, A[k][i], A[i][i]);
-			A[k][i] = ctmp;
+			_complex_div(ctmp, _A(k, i), _A(i, i));
+			_A(k, i) = ctmp;
 		}
 	}
 
 	// Forward substitution
 	for (int i = 0; i < max; i++)
 	{
-		y[i] = conj(b[mutate[i]]);
+		y[i] = b[mutate[i]];
 		for (int k = 0; k < i; k++)
 		{
-			_complex_mul_sub_assign(y[i], A[i][k], y[k]);
+			_complex_mul_sub_assign(y[i], _A(i, k), y[k]);
 		}
 	}
 
@@ -138,9 +164,9 @@ void lu_solve(int max)
 		x[i] = y[i];
 		for (int k = i + 1; k < max; k++)
 		{
-			_complex_mul_sub_assign(x[i], A[i][k], x[k]);
+			_complex_mul_sub_assign(x[i], _A(i, k), x[k]);
 		}
-		_complex_div(ctmp, x[i], A[i][i]);
+		_complex_div(ctmp, x[i], _A(i, i));
 		x[i] = ctmp;
 	}
 }
@@ -161,34 +187,172 @@ int coefficient(int k, int n)
 	return c;
 }
 
-void mre_init(mre_par *par, int max, double prec)
+/* s = q[i] */
+static void q_load(mre_history *h, int i, spinor_field *s)
 {
-	if (max == 0)
+	if (h->half)
 	{
-		par->max = 0;
-		par->init = 0;
-		return;
+		assign_sh2sd(s, h->qh + i);
 	}
 	else
 	{
-		par->max = (max < MAX) ? max : MAX;
-		par->init = 1;
+		assign_s2sd(s, h->qf + i);
 	}
+}
 
-	par->s[0] = alloc_spinor_field_f(par->max, &glat_default);
-	par->s[1] = alloc_spinor_field_f(par->max, &glat_default);
-	par->num[0] = 0;
-	par->num[1] = 0;
+/* q[i] = s */
+static void q_save(mre_history *h, int i, spinor_field *s)
+{
+	if (h->half)
+	{
+		assign_sd2sh(h->qh + i, s);
+	}
+	else
+	{
+		assign_sd2s(h->qf + i, s);
+	}
+}
 
-	if (num_init == 0)
+/* <q[i],s> without converting q[i] to a double precision field */
+static double complex q_prod(mre_history *h, int i, spinor_field *s)
+{
+	double re = 0., im = 0.;
+
+	if (h->half)
 	{
-		Dv = alloc_spinor_field_f(1, &glat_default);
+		spinor_field_half *q = h->qh + i;
+		_TWO_SPINORS_FOR_SUM(q, s, re, im)
+		{
+			suNf_spinor_flt t;
+			const float *a = (const float *)&t;
+			const double *c = (const double *)_SPINOR_PTR(s);
+			_spinor_half2flt(t, *_SPINOR_PTR(q));
+			for (int n = 0; n < (8 * NF); n += 2)
+			{
+				re += a[n] * c[n] + a[n + 1] * c[n + 1];
+				im += a[n] * c[n + 1] - a[n + 1] * c[n];
+			}
+		}
+	}
+	else
+	{
+		spinor_field_flt *q = h->qf + i;
+		_TWO_SPINORS_FOR_SUM(q, s, re, im)
+		{
+			const float *a = (const float *)_SPINOR_PTR(q);
+			const double *c = (const double *)_SPINOR_PTR(s);
+			for (int n = 0; n < (8 * NF); n += 2)
+			{
+				re += a[n] * c[n] + a[n + 1] * c[n + 1];
+				im += a[n] * c[n + 1] - a[n + 1] * c[n];
+			}
+		}
 	}
 
-	for (int i = num_init; i < par->max; i++)
+	global_sum(&re, 1);
+	global_sum(&im, 1);
+	return re + I * im;
+}
+
+/* s += z q[i] */
+static void q_mulc_add_assign(spinor_field *s, double complex z, mre_history *h, int i)
+{
+	const double zr = creal(z), zi = cimag(z);
+
+	if (h->half)
+	{
+		spinor_field_half *q = h->qh + i;
+		_TWO_SPINORS_FOR(s, q)
+		{
+			suNf_spinor_flt t;
+			const float *a = (const float *)&t;
+			double *c = (double *)_SPINOR_PTR(s);
+			_spinor_half2flt(t, *_SPINOR_PTR(q));
+			for (int n = 0; n < (8 * NF); n += 2)
+			{
+				c[n] += zr * a[n] - zi * a[n + 1];
+				c[n + 1] += zr * a[n + 1] + zi * a[n];
+			}
+		}
+	}
+	else
 	{
-		v[i] = alloc_spinor_field_f(1, &glat_default);
-		num_init++;
+		spinor_field_flt *q = h->qf + i;
+		_TWO_SPINORS_FOR(s, q)
+		{
+			const float *a = (const float *)_SPINOR_PTR(q);
+			double *c = (double *)_SPINOR_PTR(s);
+			for (int n = 0; n < (8 * NF); n += 2)
+			{
+				c[n] += zr * a[n] - zi * a[n + 1];
+				c[n + 1] += zr * a[n + 1] + zi * a[n];
+			}
+		}
+	}
+}
+
+static mre_history *get_history(int share, int p, int half, int max)
+{
+	mre_history *h;
+
+	for (h = shared; h != NULL && share != 0; h = h->link)
+	{
+		if (h->share == share && h->p == p)
+		{
+			error(h->half != half, 1, "mre_init [mre.c]", "The precision of a shared history must be the same for all monomials");
+			error(h->qf != NULL || h->qh != NULL, 1, "mre_init [mre.c]", "The shared history is already in use");
+			h->max = (max > h->max) ? max : h->max;
+			return h;
+		}
+	}
+
+	h = malloc(sizeof(*h));
+	error(h == NULL, 1, "mre_init [mre.c]", "Could not allocate memory space for the history");
+	h->share = share;
+	h->p = p;
+	h->half = half;
+	h->max = max;
+	h->num = 0;
+	h->next = 0;
+	h->qf = NULL;
+	h->qh = NULL;
+	h->link = NULL;
+
+	if (share != 0)
+	{
+		h->link = shared;
+		shared = h;
+	}
+
+	return h;
+}
+
+void mre_init(mre_par *par, int max, int share, int half, double prec)
+{
+	par->nsolve = 0;
+	par->iter = 0;
+	par->zero_iter = 0;
+	par->guess_iter = 0;
+
+	if (max <= 0)
+	{
+		par->max = 0;
+		par->init = 0;
+		return;
+	}
+
+	par->max = max;
+	par->init = 1;
+	par->prec = prec;
+	par->guess_res2 = 1;
+	par->guess_cost = 0;
+	par->h[0] = get_history(share, 0, half, max);
+	par->h[1] = get_history(share, 1, half, max);
+
+	if (w == NULL)
+	{
+		w = alloc_spinor_field_f(2, &glat_default);
+		Dv = w + 1;
 	}
 
 	if (prec > 1e-14)
@@ -196,14 +360,22 @@ void mre_init(mre_par *par, int max, double prec)
 		lprintf("MRE", 10, "WARNING: Inverter precision should be at least 1e-14 to ensure reversibility!\n");
 	}
 
-	lprintf("MRE", 10, "Enabled chronological inverter with %d past solutions\n", par->max);
+	if (share != 0)
+	{
+		lprintf("MRE", 10, "Enabled chronological inverter with %d past solutions in %s precision, shared in group %d\n", max, half ? "half" : "single", share);
+	}
+	else
+	{
+		lprintf("MRE", 10, "Enabled chronological inverter with %d past solutions in %s precision\n", max, half ? "half" : "single");
+	}
 }
 
-void mre_store(mre_par *par, int p, spinor_field *in)
+void mre_store(mre_par *par, int p, spinor_field *in, int iter)
 {
-	spinor_field *tmp;
+	mre_history *h;
+	double norm, n0;
 
-	if (num_init == 0 || par->init == 0 || par->max <= 0)
+	if (par->init == 0 || par->max <= 0)
 	{
 		return;
 	}
@@ -214,24 +386,82 @@ void mre_store(mre_par *par, int p, spinor_field *in)
 		return;
 	}
 
-	// Shift all vectors by one and store the new vector at position zero
-	tmp = &par->s[p][par->max - 1];
+	h = par->h[p];
+	if (h->qf == NULL && h->qh == NULL)
+	{
+		if (h->half)
+		{
+			h->qh = alloc_spinor_field_f_half(h->max, &glat_default);
+		}
+		else
+		{
+			h->qf = alloc_spinor_field_f_flt(h->max, &glat_default);
+		}
+	}
+
+	// Iterations saved by the guess: the solver reduced the residual from guess_res2
+	// to prec in iter iterations, at the same rate it would have started from 1
+	if (iter > 0 && par->guess_cost > 0)
+	{
+		if (par->guess_res2 >= 1.)
+		{
+			n0 = iter;
+		}
+		else if (par->guess_res2 > par->prec)
+		{
+			n0 = iter * log(par->prec) / log(par->prec / par->guess_res2);
+		}
+		else
+		{
+			n0 = (par->nsolve > 0) ? par->zero_iter / par->nsolve : iter;
+		}
+		par->nsolve++;
+		par->iter += iter;
+		par->zero_iter += n0;
+		par->guess_iter += par->guess_cost;
+		lprintf("MRE", 10, "Guess from %d vectors: res2 = %1.2e, %d iterations, %1.1f saved [average %1.1f over %d solves]\n",
+				par->guess_cost - 1, par->guess_res2, iter, n0 - iter - par->guess_cost,
+				(par->zero_iter - par->iter - par->guess_iter) / par->nsolve, par->nsolve);
+	}
+	par->guess_res2 = 1;
+	par->guess_cost = 0;
 
-	for (int i = (par->max - 1); i > 0; i--)
+	// Orthogonalise the new vector against the basis, without the vector it replaces
+	spinor_field_copy_f(w, in);
+	norm = spinor_field_sqnorm_f(w);
+	for (int pass = 0; pass < 2; pass++)
 	{
-		par->s[p][i] = par->s[p][i - 1];
+		for (int i = 0; i < h->num; i++)
+		{
+			if (i != h->next)
+			{
+				q_mulc_add_assign(w, -q_prod(h, i, w), h, i);
+			}
+		}
+	}
+
+	if (spinor_field_sqnorm_f(w) < 1e-20 * norm)
+	{
+		lprintf("MRE", 20, "The solution is already in the span of the basis\n");
+		return;
 	}
 
-	par->s[p][0] = *tmp;
-	spinor_field_copy_f(&par->s[p][0], in);
-	par->num[p]++;
+	spinor_field_mul_f(w, 1. / sqrt(spinor_field_sqnorm_f(w)), w);
+	q_save(h, h->next, w);
+	if (h->num < h->max)
+	{
+		h->num++;
+	}
+	h->next = (h->next + 1) % h->max;
 }
 
 void mre_guess(mre_par *par, int p, spinor_field *out, spinor_operator DD, spinor_field *pf)
 {
+	mre_history *h;
+	double norm;
 	int max;
 
-	if (num_init == 0 || par->init == 0 || par->max <= 0)
+	if (par->init == 0 || par->max <= 0)
 	{
 		return;
 	}
@@ -242,27 +472,40 @@ void mre_guess(mre_par *par, int p, spinor_field *out, spinor_operator DD, spino
 		return;
 	}
 
+	h = par->h[p];
 	spinor_field_zero_f(out);
-	max = (par->num[p] > par->max) ? par->max : par->num[p];
-	gram_schmidt(par, p, max);
+	max = h->num;
+	if (max == 0)
+	{
+		return;
+	}
 
+	// Projection of the operator on the basis
+	lu_alloc(max);
 	for (int i = 0; i < max; i++)
 	{
-		DD(Dv, v[i]);
+		q_load(h, i, w);
+		DD(Dv, w);
 
 		for (int j = 0; j < max; j++)
 		{
-			A[j][i] = spinor_field_prod_f(Dv, v[j]);
+			_A(j, i) = q_prod(h, j, Dv);
 		}
 
-		b[i] = spinor_field_prod_f(v[i], pf);
+		b[i] = spinor_field_prod_f(w, pf);
 	}
 
 	lu_solve(max);
 
 	for (int i = 0; i < max; i++)
 	{
-		//		spinor_field_mul_add_assign_f(out, coefficient(i+1, max), s[p][i]);
-		spinor_field_mulc_add_assign_f(out, x[i], v[i]);
+		q_mulc_add_assign(out, x[i], h, i);
 	}
+
+	// Residual of the guess
+	norm = spinor_field_sqnorm_f(pf);
+	DD(Dv, out);
+	spinor_field_sub_assign_f(Dv, pf);
+	par->guess_res2 = (norm > 0) ? spinor_field_sqnorm_f(Dv) / norm : 1;
+	par->guess_cost = max + 1;
 }
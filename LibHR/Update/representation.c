@@ -469,6 +469,10 @@ void represent_gauge_field()
 #endif//ALLOCATE_REPR_GAUGE_FIELD
   assign_ud2u_f();
 
+#ifdef WITH_SIMD_LAYOUT
+  assign_u_f2u_f_simd();
+#endif
+
 #if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
   compute_clover_term();
 #endif
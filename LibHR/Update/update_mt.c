@@ -31,6 +31,388 @@ static scalar_field *la = NULL; /* local action field for Metropolis test */
 static ghmc_par update_par;
 static int init = 0;
 
+/*
+ * Integrator tuner.
+ * Over the warm-up window, the force of each monomial on the gauge momenta and
+ * the time of its computation are measured in every call of monomial_force,
+ * together with DeltaH, the acceptance and the time of each trajectory.
+ * The variance of DeltaH is split among the integrator levels in proportion to
+ * (|F| h^p)^2, F being the force of the level, h its step and p the order of
+ * its integrator, and the part of each level is scaled as h^(2p) when the step
+ * counts change. For Gaussian DeltaH with <exp(-DeltaH)> = 1 the acceptance is
+ * erfc(sqrt(var/8)). The step counts minimizing the time per accepted
+ * trajectory, with the acceptance at least tune_acc, are found by coordinate
+ * descent. The monomials are also assigned to the levels by their cost per
+ * force evaluation, the most expensive ones to the outermost levels: this
+ * assignment is only proposed.
+ * The records are appended as JSON lines to tune_log.
+ */
+
+typedef struct
+{
+  const monomial *m;
+  int level;
+  int ncalls;
+  double f2;   /* sum over the calls of |F|^2 per link */
+  double time; /* time spent in the force */
+} tune_mon_stat;
+
+typedef struct
+{
+  integrator_par *ip;
+  const char *name;
+  int order;
+  double force; /* |F| per link of the level */
+  double var;   /* part of the variance of DeltaH */
+  double cost;  /* time per trajectory */
+} tune_level_stat;
+
+int ghmc_tune_on = 0;
+
+static suNg_av_field *tune_mom = NULL;
+static tune_mon_stat *tune_mon = NULL;
+static int tune_nmon = 0;
+static int tune_traj = 0, tune_nacc = 0;
+static double tune_dH = 0., tune_dH2 = 0., tune_expdH = 0., tune_time = 0.;
+static struct timeval tune_start;
+
+static const char *integrator_name(integrator_par *ip, int *order)
+{
+  *order = 2;
+  if (ip->integrator == &leapfrog_multistep)
+    return "lf";
+  if (ip->integrator == &O2MN_multistep)
+    return "o2mn";
+  *order = 4;
+  if (ip->integrator == &O4MN_multistep)
+    return "o4mn";
+  if (ip->integrator == &FG_multistep)
+    return "fg";
+  if (ip->integrator == &FG_pos_multistep)
+    return "fg_pos";
+  *order = 2;
+  return "unknown";
+}
+
+static FILE *tune_log_open()
+{
+  FILE *fp;
+  if (PID != 0 || update_par.tune_log[0] == '\0')
+    return NULL;
+  fp = fopen(update_par.tune_log, "a");
+  error(fp == NULL, 1, "tune_log_open [update_mt.c]", "Unable to open the tuning log");
+  return fp;
+}
+
+static void init_tune()
+{
+  integrator_par *ip;
+  int k = 0;
+
+  error(update_par.tune_acc <= 0. || update_par.tune_acc >= 1., 1, "init_tune [update_mt.c]",
+        "The target acceptance must be between 0 and 1");
+
+  tune_nmon = 0;
+  for (ip = update_par.integrator; ip != NULL; ip = ip->next)
+    tune_nmon += ip->nmon;
+  tune_mon = calloc(tune_nmon, sizeof(*tune_mon));
+  error(tune_mon == NULL, 1, "init_tune [update_mt.c]", "Could not allocate memory space for the tuner");
+  for (ip = update_par.integrator; ip != NULL; ip = ip->next)
+    for (int n = 0; n < ip->nmon; n++)
+    {
+      tune_mon[k].m = ip->mon_list[n];
+      tune_mon[k].level = ip->level;
+      k++;
+    }
+
+  tune_mom = alloc_avfield(&glattice);
+  tune_traj = tune_nacc = 0;
+  tune_dH = tune_dH2 = tune_expdH = tune_time = 0.;
+  ghmc_tune_on = 1;
+
+  lprintf("TUNER", 0, "Tuning the integrator over %d trajectories, target acceptance %1.3f\n", update_par.tune_ntraj, update_par.tune_acc);
+}
+
+static void free_tune()
+{
+  ghmc_tune_on = 0;
+  if (tune_mom != NULL)
+  {
+    free_avfield(tune_mom);
+    tune_mom = NULL;
+  }
+  free(tune_mon);
+  tune_mon = NULL;
+  tune_nmon = 0;
+}
+
+void ghmc_tune_force(double dt, const monomial *m)
+{
+  struct timeval start, end, etime;
+  suNg_av_field *mom = suN_momenta;
+  tune_mon_stat *t = NULL;
+  double f2 = 0.;
+
+  for (int k = 0; k < tune_nmon; k++)
+    if (tune_mon[k].m == m)
+      t = tune_mon + k;
+  error(t == NULL, 1, "ghmc_tune_force [update_mt.c]", "Unknown monomial");
+
+  _MASTER_FOR(&glattice, ix)
+  {
+    for (int mu = 0; mu < 4; mu++)
+      *_4FIELD_AT(tune_mom, ix, mu) = *_4FIELD_AT(mom, ix, mu);
+  }
+
+  gettimeofday(&start, 0);
+  m->update_force(dt, m->force_par);
+  gettimeofday(&end, 0);
+  timeval_subtract(&etime, &end, &start);
+
+  _MASTER_FOR_SUM(&glattice, ix, f2)
+  {
+    for (int mu = 0; mu < 4; mu++)
+    {
+      suNg_algebra_vector f = *_4FIELD_AT(mom, ix, mu);
+      double nsq;
+      _algebra_vector_sub_assign_g(f, *_4FIELD_AT(tune_mom, ix, mu));
+      _algebra_vector_sqnorm_g(nsq, f);
+      f2 += nsq;
+    }
+  }
+  global_sum(&f2, 1);
+
+  t->ncalls++;
+  t->f2 += f2 / (dt * dt * 4. * GLB_VOLUME);
+  t->time += etime.tv_sec + 1.e-6 * etime.tv_usec;
+}
+
+/* time per accepted trajectory for the step counts n, infinite if the acceptance is below the target */
+static double tune_cost(int nlev, const int *n, const tune_level_stat *lev, double overhead, double *acc, double *cost)
+{
+  double var = 0., prod = 1.;
+
+  *cost = overhead;
+  for (int l = 0; l < nlev; l++)
+  {
+    prod *= (double)n[l] / lev[l].ip->nsteps;
+    var += lev[l].var * pow(prod, -2. * lev[l].order);
+    *cost += lev[l].cost * prod;
+  }
+  *acc = erfc(sqrt(var / 8.));
+
+  if (*acc < update_par.tune_acc)
+    return 1.e300 * (1. + update_par.tune_acc - *acc);
+  return *cost / *acc;
+}
+
+static void tune_analyse()
+{
+  integrator_par *ip;
+  tune_level_stat *lev;
+  int *n, *order, *plevel, *count;
+  int nlev = 0;
+  double var, mean, acc, w = 0., ftime = 0., overhead, pacc, pcost, cost, score;
+  FILE *fp;
+
+  for (ip = update_par.integrator; ip != NULL; ip = ip->next)
+    nlev++;
+  lev = calloc(nlev, sizeof(*lev));
+  n = malloc(nlev * sizeof(*n));
+  count = calloc(nlev, sizeof(*count));
+  order = malloc(tune_nmon * sizeof(*order));
+  plevel = malloc(tune_nmon * sizeof(*plevel));
+  error(lev == NULL || n == NULL || count == NULL || order == NULL || plevel == NULL, 1, "tune_analyse [update_mt.c]",
+        "Could not allocate memory space for the tuner");
+
+  /* the slowest process sets the times */
+  for (int k = 0; k < tune_nmon; k++)
+    global_max(&tune_mon[k].time, 1);
+  global_max(&tune_time, 1);
+
+  mean = tune_dH / tune_traj;
+  var = (tune_traj > 1) ? (tune_dH2 - tune_traj * mean * mean) / (tune_traj - 1) : 0.;
+  acc = (double)tune_nacc / tune_traj;
+
+  /* levels */
+  for (ip = update_par.integrator; ip != NULL; ip = ip->next)
+  {
+    tune_level_stat *l = lev + ip->level;
+    double h = update_par.tlen;
+    integrator_par *jp;
+    l->ip = ip;
+    l->name = integrator_name(ip, &l->order);
+    for (int k = 0; k < tune_nmon; k++)
+      if (tune_mon[k].level == ip->level && tune_mon[k].ncalls > 0)
+      {
+        l->force += tune_mon[k].f2 / tune_mon[k].ncalls;
+        l->cost += tune_mon[k].time / tune_traj;
+      }
+    l->force = sqrt(l->force);
+    for (jp = update_par.integrator; jp != ip->next; jp = jp->next)
+      h /= jp->nsteps;
+    l->var = pow(l->force * pow(h, l->order), 2);
+    w += l->var;
+    ftime += l->cost;
+    n[ip->level] = ip->nsteps;
+  }
+  for (int l = 0; l < nlev; l++)
+    lev[l].var = (w > 0.) ? var * lev[l].var / w : 0.;
+  overhead = tune_time / tune_traj - ftime;
+  if (overhead < 0.)
+    overhead = 0.;
+
+  /* step counts by coordinate descent */
+  if (var > 0.)
+  {
+    score = tune_cost(nlev, n, lev, overhead, &pacc, &pcost);
+    for (int sweep = 0; sweep < 50; sweep++)
+    {
+      int changed = 0;
+      for (int l = 0; l < nlev; l++)
+      {
+        const int n0 = n[l];
+        const int nmax = (8 * lev[l].ip->nsteps > 16) ? 8 * lev[l].ip->nsteps : 16;
+        int best = n0;
+        if (lev[l].force == 0.)
+          continue; /* no force on the gauge field is measured on this level */
+        for (int k = 1; k <= nmax; k++)
+        {
+          double s;
+          n[l] = k;
+          s = tune_cost(nlev, n, lev, overhead, &pacc, &pcost);
+          if (s < score)
+          {
+            score = s;
+            best = k;
+          }
+        }
+        n[l] = best;
+        changed |= (best != n0);
+      }
+      if (!changed)
+        break;
+    }
+  }
+  else
+  {
+    lprintf("TUNER", 0, "WARNING: no variance of DeltaH measured, the step counts are not changed\n");
+  }
+  score = tune_cost(nlev, n, lev, overhead, &pacc, &pcost);
+  cost = tune_time / tune_traj;
+
+  /* level assignment: the most expensive monomials on the outermost levels */
+  for (int k = 0; k < tune_nmon; k++)
+  {
+    order[k] = k;
+    count[tune_mon[k].level]++;
+  }
+  for (int i = 1; i < tune_nmon; i++)
+    for (int j = i; j > 0; j--)
+    {
+      const tune_mon_stat *a = tune_mon + order[j - 1], *b = tune_mon + order[j];
+      const double ca = (a->ncalls > 0) ? a->time / a->ncalls : 0.;
+      const double cb = (b->ncalls > 0) ? b->time / b->ncalls : 0.;
+      if (cb > ca)
+      {
+        int tmp = order[j];
+        order[j] = order[j - 1];
+        order[j - 1] = tmp;
+      }
+    }
+  for (int k = 0, l = 0; k < tune_nmon; k++)
+  {
+    while (count[l] == 0)
+      l++;
+    plevel[order[k]] = l;
+    count[l]--;
+  }
+
+  /* report */
+  fp = tune_log_open();
+  for (int l = 0; l < nlev; l++)
+  {
+    lprintf("TUNER", 0, "Level %d: %s, nsteps = %d, |F| = %1.6e, DeltaH variance = %1.6e, time = %1.6e s => proposed nsteps = %d\n",
+            l, lev[l].name, lev[l].ip->nsteps, lev[l].force, lev[l].var, lev[l].cost, n[l]);
+    if (fp != NULL)
+      fprintf(fp, "{\"record\":\"level\",\"level\":%d,\"integrator\":\"%s\",\"order\":%d,\"nsteps\":%d,\"force\":%.8e,"
+                  "\"dH_var\":%.8e,\"time\":%.8e,\"proposed_nsteps\":%d}\n",
+              l, lev[l].name, lev[l].order, lev[l].ip->nsteps, lev[l].force, lev[l].var, lev[l].cost, n[l]);
+  }
+  for (int k = 0; k < tune_nmon; k++)
+  {
+    const tune_mon_stat *t = tune_mon + k;
+    const double f = (t->ncalls > 0) ? sqrt(t->f2 / t->ncalls) : 0.;
+    const double tc = (t->ncalls > 0) ? t->time / t->ncalls : 0.;
+    lprintf("TUNER", 0, "Monomial %d (%s): level = %d, |F| = %1.6e, %d forces, %1.6e s per force => proposed level = %d\n",
+            t->m->data.id, mon_type_name(t->m->data.type), t->level, f, t->ncalls, tc, plevel[k]);
+    if (fp != NULL)
+      fprintf(fp, "{\"record\":\"monomial\",\"id\":%d,\"type\":\"%s\",\"level\":%d,\"force\":%.8e,\"calls\":%d,"
+                  "\"time_per_call\":%.8e,\"proposed_level\":%d}\n",
+              t->m->data.id, mon_type_name(t->m->data.type), t->level, f, t->ncalls, tc, plevel[k]);
+  }
+  lprintf("TUNER", 0, "%d trajectories: acceptance = %1.3f, <DeltaH> = %1.6e, var(DeltaH) = %1.6e, <exp(-DeltaH)> = %1.6f\n",
+          tune_traj, acc, mean, var, tune_expdH / tune_traj);
+  lprintf("TUNER", 0, "Time per accepted trajectory: %1.6e s => predicted %1.6e s, predicted acceptance = %1.3f\n",
+          (tune_nacc > 0) ? cost / acc : 0., pcost / pacc, pacc);
+  if (fp != NULL)
+  {
+    fprintf(fp, "{\"record\":\"summary\",\"lattice\":[%d,%d,%d,%d],\"tlen\":%.8e,\"ntraj\":%d,\"acceptance\":%.8e,"
+                "\"dH_mean\":%.8e,\"dH_var\":%.8e,\"exp_mdH\":%.8e,\"time\":%.8e,\"target_acceptance\":%.8e,"
+                "\"predicted_acceptance\":%.8e,\"predicted_time\":%.8e,\"proposed_nsteps\":[",
+            GLB_T, GLB_X, GLB_Y, GLB_Z, update_par.tlen, tune_traj, acc, mean, var, tune_expdH / tune_traj, cost,
+            update_par.tune_acc, pacc, pcost);
+    for (int l = 0; l < nlev; l++)
+      fprintf(fp, (l == 0) ? "%d" : ",%d", n[l]);
+    fprintf(fp, "],\"applied\":%d}\n", update_par.tune_apply ? 1 : 0);
+    fclose(fp);
+  }
+
+  if (update_par.tune_apply)
+  {
+    for (int l = 0; l < nlev; l++)
+      lev[l].ip->nsteps = n[l];
+    lprintf("TUNER", 0, "Proposed step counts applied\n");
+  }
+
+  free(lev);
+  free(n);
+  free(count);
+  free(order);
+  free(plevel);
+}
+
+static void tune_trajectory(double deltaH, int accepted)
+{
+  struct timeval end, etime;
+  FILE *fp;
+  double t;
+
+  gettimeofday(&end, 0);
+  timeval_subtract(&etime, &end, &tune_start);
+  t = etime.tv_sec + 1.e-6 * etime.tv_usec;
+
+  tune_traj++;
+  tune_nacc += accepted;
+  tune_dH += deltaH;
+  tune_dH2 += deltaH * deltaH;
+  tune_expdH += exp(-deltaH);
+  tune_time += t;
+
+  fp = tune_log_open();
+  if (fp != NULL)
+  {
+    fprintf(fp, "{\"record\":\"trajectory\",\"traj\":%d,\"dH\":%.8e,\"accepted\":%d,\"time\":%.8e}\n", tune_traj, deltaH, accepted, t);
+    fclose(fp);
+  }
+
+  if (tune_traj == update_par.tune_ntraj)
+  {
+    tune_analyse();
+    free_tune();
+  }
+}
+
 void init_ghmc(ghmc_par *par)
 {
 
@@ -89,6 +471,10 @@ void init_ghmc(ghmc_par *par)
   /* copy update parameters */
   update_par = *par;
 
+  if (update_par.tune_ntraj > 0)
+    init_tune();
+  init_hmc_cost(&update_par);
+
   //#ifdef ROTATED_SF
   //  hmc_action_par.SF_ct = _update_par.SF_ct;
   //#endif
@@ -140,6 +526,9 @@ void free_ghmc()
   }
   update_par.integrator = NULL;
 
+  free_tune();
+  free_hmc_cost();
+
   //free_force_hmc();
   init = 0;
   lprintf("HMC", 0, "Memory deallocated.\n");
@@ -156,6 +545,10 @@ int update_ghmc()
     return -1;
   }
 
+  if (ghmc_tune_on)
+    gettimeofday(&tune_start, 0);
+  hmc_cost_trajectory_begin();
+
   /* generate new momenta */
   lprintf("HMC", 30, "Generating gaussian momenta and pseudofermions...\n");
   gaussian_momenta(suN_momenta);
@@ -168,7 +561,9 @@ int update_ghmc()
   for (int i = 0; i < num_mon(); ++i)
   {
     const monomial *m = mon_n(i);
+    hmc_cost_begin();
     m->gaussian_pf(m);
+    hmc_cost_end(m, COST_PF);
   }
 
   /* compute starting action */
@@ -179,7 +574,9 @@ int update_ghmc()
   for (int i = 0; i < num_mon(); ++i)
   {
     const monomial *m = mon_n(i);
+    hmc_cost_begin();
     m->correct_pf(m);
+    hmc_cost_end(m, COST_PF);
   }
 
   /* integrate molecular dynamics */
@@ -195,7 +592,9 @@ int update_ghmc()
   for (int i = 0; i < num_mon(); ++i)
   {
     const monomial *m = mon_n(i);
+    hmc_cost_begin();
     m->correct_la_pf(m);
+    hmc_cost_end(m, COST_ACTION);
   }
   local_hmc_action(DELTA, la, suN_momenta, scalar_momenta);
 
@@ -275,11 +674,17 @@ int update_ghmc()
         start_sc_sendrecv(u_scalar); /* this may not be needed if we always guarantee that we copy also the buffers */
       }
       represent_gauge_field();
+      if (ghmc_tune_on)
+        tune_trajectory(deltaH, 0);
+      hmc_cost_trajectory_end(deltaH, 0);
       return 0;
     }
   }
 
   lprintf("HMC", 10, "Configuration accepted.\n");
+  if (ghmc_tune_on)
+    tune_trajectory(deltaH, 1);
+  hmc_cost_trajectory_end(deltaH, 1);
   return 1;
 }
 
@@ -0,0 +1,36 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *
+* All rights reserved.                                                      *
+\***************************************************************************/
+
+/*******************************************************************************
+*
+* File gauge_fingerprint.c
+*
+* Weighted sum of the represented links, to detect that the gauge field
+* has changed since some data depending on it was computed.
+*
+*******************************************************************************/
+
+#include "global.h"
+#include "utils.h"
+#include "communications.h"
+
+double gauge_fingerprint(void)
+{
+  const int n = sizeof(suNf) / sizeof(double);
+  double sum = 0.;
+
+  _MASTER_FOR_SUM(&glattice, ix, sum)
+  {
+    for (int mu = 0; mu < 4; mu++)
+    {
+      double *u = (double *)pu_gauge_f(ix, mu);
+      for (int k = 0; k < n; k++)
+        sum += (1. + ((4 * ix + mu) * n + k) % 13) * u[k];
+    }
+  }
+  global_sum(&sum, 1);
+
+  return sum;
+}
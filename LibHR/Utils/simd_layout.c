@@ -0,0 +1,86 @@
+/***************************************************************************\
+* Copyright (c) 2008, Claudio Pica                                          *
+* All rights reserved.                                                      *
+\***************************************************************************/
+
+/*******************************************************************************
+*
+* File simd_layout.c
+*
+* Conversion of the represented gauge field to the site-blocked layout
+* used by the vectorized Dirac operator (see Update/Dphi_simd.c)
+*
+*******************************************************************************/
+
+#include "utils.h"
+#include "suN.h"
+#include "error.h"
+#include "global.h"
+#include "memory.h"
+#include "spinor_field.h"
+
+#ifdef WITH_SIMD_LAYOUT
+
+/*
+ * For every master site ix the 8 links needed by the hopping term are
+ * copied into lane _SIMD_LANE(ix) of block _SIMD_BLOCK(ix):
+ * mu=0..3 -> U(ix,mu), mu=4..7 -> U(ix-mu,mu).
+ * The gauge field must already contain the boundary copies.
+ */
+#if defined(REPR_ADJOINT) || defined(GAUGE_SON)
+#define _PACK_LINK(_dst, _src, _lane)                  \
+  for (int _k = 0; _k < NF * NF; _k++)                 \
+  {                                                    \
+    (_dst)->re[_k][_lane] = (_src)->c[_k];             \
+  }
+#else
+#define _PACK_LINK(_dst, _src, _lane)                  \
+  for (int _k = 0; _k < NF * NF; _k++)                 \
+  {                                                    \
+    (_dst)->re[_k][_lane] = creal((_src)->c[_k]);      \
+    (_dst)->im[_k][_lane] = cimag((_src)->c[_k]);      \
+  }
+#endif
+
+void assign_u_f2u_f_simd(void)
+{
+  if (u_gauge_f_simd == NULL)
+    u_gauge_f_simd = alloc_gfield_f_simd(&glattice);
+
+  _MASTER_FOR(&glattice, ix)
+  {
+    const int lane = _SIMD_LANE(ix);
+    for (int mu = 0; mu < 4; mu++)
+    {
+      suNf *up = pu_gauge_f(ix, mu);
+      suNf *um = pu_gauge_f(idn(ix, mu), mu);
+      _PACK_LINK(_8SIMD_FIELD_AT(u_gauge_f_simd, ix, mu), up, lane);
+      _PACK_LINK(_8SIMD_FIELD_AT(u_gauge_f_simd, ix, mu + 4), um, lane);
+    }
+  }
+}
+
+void assign_u_f2u_f_simd_flt(void)
+{
+  if (u_gauge_f_flt == NULL)
+    return;
+
+  if (u_gauge_f_simd_flt == NULL)
+    u_gauge_f_simd_flt = alloc_gfield_f_simd_flt(&glattice);
+
+  _MASTER_FOR(&glattice, ix)
+  {
+    const int lane = _SIMD_LANE(ix);
+    for (int mu = 0; mu < 4; mu++)
+    {
+      suNf_flt *up = pu_gauge_f_flt(ix, mu);
+      suNf_flt *um = pu_gauge_f_flt(idn(ix, mu), mu);
+      _PACK_LINK(_8SIMD_FIELD_AT(u_gauge_f_simd_flt, ix, mu), up, lane);
+      _PACK_LINK(_8SIMD_FIELD_AT(u_gauge_f_simd_flt, ix, mu + 4), um, lane);
+    }
+  }
+}
+
+#undef _PACK_LINK
+
+#endif /* WITH_SIMD_LAYOUT */
@@ -17,6 +17,7 @@
 #include "error.h"
 #include "global.h"
 #include "spinor_field.h"
+#include "memory.h"
 
 /*
 void assign_u2ud(void)
@@ -83,6 +84,39 @@ void assign_ud2u_f(void)
     {
       *(f + i) = (float)(*(d + i));
     }
+
+#ifdef WITH_SIMD_LAYOUT
+    assign_u_f2u_f_simd_flt();
+#endif
+  }
+  if (u_gauge_f_half != NULL)
+  {
+    assign_ud2u_f_half();
+  }
+}
+
+/* The half precision links are allocated at the first call;
+ * afterwards they are refreshed by assign_ud2u_f.
+ */
+void assign_ud2u_f_half(void)
+{
+  if (u_gauge_f_half == NULL)
+  {
+    u_gauge_f_half = alloc_gfield_f_half(&glattice);
+  }
+
+  _OMP_PRAGMA(_omp_parallel)
+  _OMP_PRAGMA(_omp_for)
+  for (int i = 0; i < 4 * glattice.gsize_gauge; i++)
+  {
+    suNf_flt u;
+    double *d = (double *)(u_gauge_f->ptr + i);
+    float *f = (float *)&u;
+    for (int n = 0; n < _HALF_LINK_LEN; n++)
+    {
+      f[n] = (float)d[n];
+    }
+    _suNf_flt2half(u_gauge_f_half->ptr[i], u);
   }
 }
 
@@ -113,3 +147,53 @@ void assign_sd2s(spinor_field_flt *out, spinor_field *in)
     }
   }
 }
+
+void assign_s2sh(spinor_field_half *out, spinor_field_flt *in)
+{
+
+  _TWO_SPINORS_FOR(out, in)
+  {
+    _spinor_flt2half(*_SPINOR_PTR(out), *_SPINOR_PTR(in));
+  }
+}
+
+void assign_sh2s(spinor_field_flt *out, spinor_field_half *in)
+{
+
+  _TWO_SPINORS_FOR(out, in)
+  {
+    _spinor_half2flt(*_SPINOR_PTR(out), *_SPINOR_PTR(in));
+  }
+}
+
+void assign_sd2sh(spinor_field_half *out, spinor_field *in)
+{
+
+  _TWO_SPINORS_FOR(out, in)
+  {
+    suNf_spinor_flt s;
+    float *o = (float *)&s;
+    double *i = (double *)_SPINOR_PTR(in);
+    for (int n = 0; n < (8 * NF); n++)
+    {
+      *(o++) = (float)*(i++);
+    }
+    _spinor_flt2half(*_SPINOR_PTR(out), s);
+  }
+}
+
+void assign_sh2sd(spinor_field *out, spinor_field_half *in)
+{
+
+  _TWO_SPINORS_FOR(out, in)
+  {
+    suNf_spinor_flt s;
+    double *o = (double *)_SPINOR_PTR(out);
+    float *i = (float *)&s;
+    _spinor_half2flt(s, *_SPINOR_PTR(in));
+    for (int n = 0; n < (8 * NF); n++)
+    {
+      *(o++) = (double)*(i++);
+    }
+  }
+}
@@ -21,7 +21,10 @@ if ( $NY<1 ) { $NY = 1 }
 my $NZ = `awk '/NP_Z/ {printf "%d",\$3}' $input_file`;
 if ( $NZ<1 ) { $NZ = 1 }
 #
-my $NP=$NT*$NX*$NY*$NZ;
+my $NR = `awk '/N_REP/ {printf "%d",\$3}' $input_file`;
+if ( $NR<1 ) { $NR = 1 }
+#
+my $NP=$NT*$NX*$NY*$NZ*$NR;
 #print "NP=$NP ($NT,$NX,$NY,$NZ)\n";
 exec("mpirun", "-np", $NP, @ARGV,"-i",$input_file);
 
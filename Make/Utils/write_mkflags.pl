@@ -29,6 +29,11 @@ GetOptions(
   'mpitiming!'   => \(my $mpit = 0),
   'ioflush!'   => \(my $iof = 1),
   'unrollrepr!'   => \(my $unrollr = 0),
+  'simd!'   => \(my $simd = 0),
+  'simdvlen=i'   => \(my $simdvlen = 4),
+  'projhalo!'   => \(my $projhalo = 0),
+  'overlap!'   => \(my $overlap = 0),
+  'asyncio!'   => \(my $asyncio = 0),
   'timing!'   => \(my $timing = 0),
   'bartiming!'   => \(my $btiming = 0),
   'memory!'   => \(my $mem = 0),
@@ -205,6 +210,15 @@ $mpit && print $fh "MACRO += -DMPI_TIMING\n";
 $iof && print $fh "MACRO += -DIO_FLUSH\n";
 # write unroll representation
 $unrollr && print $fh "MACRO += -DUNROLL_GROUP_REPRESENT\n";
+# write site-blocked layout
+$simd && print $fh "MACRO += -DWITH_SIMD_LAYOUT\n";
+$simd && print $fh "MACRO += -DSIMD_VLEN=$simdvlen\n";
+# write projected halo
+$projhalo && print $fh "MACRO += -DWITH_PROJECTED_HALO\n";
+# write communication overlap
+$overlap && print $fh "MACRO += -DWITH_COMM_OVERLAP\n";
+# write background checkpoints
+$asyncio && print $fh "MACRO += -DWITH_ASYNC_IO\n";
 # write timing
 $timing && print $fh "MACRO += -DTIMING\n";
 # write timing
@@ -217,6 +231,7 @@ $force && print $fh "MACRO += -DMEASURE_FORCE\n";
 $mpi && print $fh "MACRO += -DWITH_MPI\n";
 # write compiler options
 if ($ccache!=0) { $cc="ccache ".$cc; $mpicc="ccache ".$mpicc; }
+if ($asyncio!=0) { $cflags="$cflags -pthread"; $ldflags="$ldflags -pthread"; }
 print $fh "CC = $cc\n";
 print $fh "MPICC = $mpicc\n";
 print $fh "CFLAGS = $cflags\n";
@@ -267,6 +282,11 @@ write_mkflags - write flags file for compilation of HiRep
   --[no-]quat,-q      [false]     Use quaternion representation (only for SU2)
   --[no-]dfloat       [false]     Use single precision acceleration
   --[no-]unrollrepr   [false]     Unroll group representation functions
+  --[no-]simd         [false]     Site-blocked gauge layout and vectorized Dirac operator
+  --simdvlen          [4]         Sites per block for --simd (4: AVX2, 8: AVX-512)
+  --[no-]projhalo     [false]     Exchange spin-projected half-spinors in Dphi_ (requires MPI)
+  --[no-]overlap      [false]     Overlap halo exchange and computation in Dphi_ (requires MPI)
+  --[no-]asyncio      [false]     Write the HMC checkpoints in a background thread
 
   --[no-]checkspinor  [true]      Check spinor field type
   --[no-]mpitiming    [false]     Enable timing of MPI calls
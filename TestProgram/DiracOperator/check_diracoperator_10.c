@@ -0,0 +1,126 @@
+/*******************************************************************************
+*
+* Coherence of the Dirac operator applied to a block of spinors
+* with the Dirac operator applied to each spinor separately
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "update.h"
+#include "geometry.h"
+#include "global.h"
+#include "logger.h"
+#include "random.h"
+#include "memory.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "representation.h"
+#include "communications.h"
+#include "setup.h"
+
+#define NBLOCK 4
+
+static double hmass = 0.1;
+
+/* eopre=1,2 for Dphi_eopre, g5Dphi_eopre;
+ * in is a contiguous block when strided=1, a block of separate fields otherwise */
+static int compare(geometry_descriptor *out_type, geometry_descriptor *in_type, int eopre, int strided, char *name)
+{
+  spinor_field *s0, *s1, *s2, *sep[NBLOCK];
+  spinor_field in[NBLOCK];
+  double sig, tau, res = 0.;
+
+  s1 = alloc_spinor_field_f(NBLOCK, out_type);
+  s2 = alloc_spinor_field_f(1, out_type);
+  if (strided)
+  {
+    s0 = alloc_spinor_field_f(NBLOCK, in_type);
+    for (int k = 0; k < NBLOCK; k++)
+      in[k] = s0[k];
+  }
+  else
+  {
+    for (int k = 0; k < NBLOCK; k++)
+    {
+      sep[k] = alloc_spinor_field_f(1, in_type);
+      in[k] = *sep[k];
+    }
+  }
+
+  for (int k = 0; k < NBLOCK; k++)
+  {
+    gaussian_spinor_field(&in[k]);
+    tau = 1. / sqrt(spinor_field_sqnorm_f(&in[k]));
+    spinor_field_mul_f(&in[k], tau, &in[k]);
+  }
+
+  if (eopre == 2)
+    g5Dphi_eopre_block(hmass, s1, in, NBLOCK);
+  else if (eopre)
+    Dphi_eopre_block(hmass, s1, in, NBLOCK);
+  else
+    Dphi_block_(s1, in, NBLOCK);
+
+  for (int k = 0; k < NBLOCK; k++)
+  {
+    if (eopre == 2)
+      g5Dphi_eopre(hmass, s2, &in[k]);
+    else if (eopre)
+      Dphi_eopre(hmass, s2, &in[k]);
+    else
+      Dphi_(s2, &in[k]);
+    spinor_field_sub_assign_f(s2, &s1[k]);
+    sig = sqrt(spinor_field_sqnorm_f(s2));
+    if (sig > res)
+      res = sig;
+  }
+
+  lprintf("MAIN", 0, "%s: maximal normalized difference = %.2e (should be around 1*10^(-15) or so)\n", name, res);
+
+  free_spinor_field_f(s1);
+  free_spinor_field_f(s2);
+  if (strided)
+    free_spinor_field_f(s0);
+  else
+    for (int k = 0; k < NBLOCK; k++)
+      free_spinor_field_f(sep[k]);
+
+  return (res > 1.e-14);
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+
+  /* setup process id and communications */
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  fflush(stdout);
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  lprintf("MAIN", 0, "done.\n");
+
+  lprintf("MAIN", 0, "Block of %d spinors\n", NBLOCK);
+
+  return_value += compare(&glattice, &glattice, 0, 1, "Full lattice");
+  return_value += compare(&glat_even, &glat_odd, 0, 1, "Odd to even");
+  return_value += compare(&glat_odd, &glat_even, 0, 1, "Even to odd");
+  return_value += compare(&glattice, &glattice, 0, 0, "Full lattice, separate fields");
+  return_value += compare(&glat_even, &glat_even, 1, 1, "Even/odd preconditioned");
+  return_value += compare(&glat_even, &glat_even, 2, 1, "Even/odd preconditioned, g5");
+
+  finalize_process();
+  return return_value;
+}
@@ -0,0 +1,178 @@
+/*******************************************************************************
+*
+* Half precision (16-bit storage) Dirac operator compared with the single
+* precision one, and effective bandwidth of the two
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "update.h"
+#include "geometry.h"
+#include "global.h"
+#include "logger.h"
+#include "random.h"
+#include "memory.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "representation.h"
+#include "communications.h"
+#include "utils.h"
+#include "setup.h"
+
+#define N_TIMES 20
+
+static double hmass = 0.1;
+
+/* relative difference of the half and single precision operators,
+ * op=0 for Dphi_, op=1 for g5Dphi_eopre */
+static int compare(geometry_descriptor *out_type, geometry_descriptor *in_type, int op, char *name)
+{
+  spinor_field_flt *f0, *f1, *f2;
+  spinor_field_half *h0, *h1;
+  double tau, res;
+
+  f0 = alloc_spinor_field_f_flt(1, in_type);
+  f1 = alloc_spinor_field_f_flt(2, out_type);
+  f2 = f1 + 1;
+  h0 = alloc_spinor_field_f_half(1, in_type);
+  h1 = alloc_spinor_field_f_half(1, out_type);
+
+  gaussian_spinor_field_flt(f0);
+  tau = 1. / sqrt(spinor_field_sqnorm_f_flt(f0));
+  spinor_field_mul_f_flt(f0, (float)tau, f0);
+  assign_s2sh(h0, f0);
+
+  if (op == 1)
+  {
+    g5Dphi_eopre_flt(hmass, f1, f0);
+    g5Dphi_eopre_half(hmass, h1, h0);
+  }
+  else
+  {
+    Dphi_flt_(f1, f0);
+    Dphi_half_(h1, h0);
+  }
+
+  assign_sh2s(f2, h1);
+  spinor_field_sub_assign_f_flt(f2, f1);
+  res = sqrt(spinor_field_sqnorm_f_flt(f2) / spinor_field_sqnorm_f_flt(f1));
+
+  lprintf("MAIN", 0, "%s: relative difference half/single = %.2e (should be around 1*10^(-4) or so)\n", name, res);
+
+  free_spinor_field_f_flt(f0);
+  free_spinor_field_f_flt(f1);
+  free_spinor_field_f_half(h0);
+  free_spinor_field_f_half(h1);
+
+  return (res > 1.e-3);
+}
+
+/* conversion double -> half -> double */
+static int check_conversion()
+{
+  spinor_field *s0, *s1;
+  spinor_field_half *h0;
+  double res;
+
+  s0 = alloc_spinor_field_f(2, &glattice);
+  s1 = s0 + 1;
+  h0 = alloc_spinor_field_f_half(1, &glattice);
+
+  gaussian_spinor_field(s0);
+  assign_sd2sh(h0, s0);
+  assign_sh2sd(s1, h0);
+  spinor_field_sub_assign_f(s1, s0);
+  res = sqrt(spinor_field_sqnorm_f(s1) / spinor_field_sqnorm_f(s0));
+
+  lprintf("MAIN", 0, "Conversion double -> half -> double: relative difference = %.2e (should be around 1*10^(-5) or so)\n", res);
+
+  free_spinor_field_f(s0);
+  free_spinor_field_f_half(h0);
+
+  return (res > 1.e-4);
+}
+
+static double elapsed_ms(struct timeval *start, struct timeval *end)
+{
+  struct timeval etime;
+  timeval_subtract(&etime, end, start);
+  return etime.tv_sec * 1000. + etime.tv_usec * 0.001;
+}
+
+/* the bytes per site are those of 8 spinors and 8 links read and 1 spinor written */
+static void bandwidth()
+{
+  spinor_field_flt *f0, *f1;
+  spinor_field_half *h0, *h1;
+  struct timeval start, end;
+  double vol = (double)GLB_T * GLB_X * GLB_Y * GLB_Z;
+  double t_flt, t_half, b_flt, b_half;
+
+  f0 = alloc_spinor_field_f_flt(2, &glattice);
+  f1 = f0 + 1;
+  h0 = alloc_spinor_field_f_half(2, &glattice);
+  h1 = h0 + 1;
+  gaussian_spinor_field_flt(f0);
+  assign_s2sh(h0, f0);
+
+  b_flt = 9. * sizeof(suNf_spinor_flt) + 8. * sizeof(suNf_flt);
+  b_half = 9. * sizeof(suNf_spinor_half) + 8. * sizeof(suNf_half);
+
+  Dphi_flt_(f1, f0);
+  gettimeofday(&start, 0);
+  for (int i = 0; i < N_TIMES; ++i)
+    Dphi_flt_(f1, f0);
+  gettimeofday(&end, 0);
+  t_flt = elapsed_ms(&start, &end) / N_TIMES;
+
+  Dphi_half_(h1, h0);
+  gettimeofday(&start, 0);
+  for (int i = 0; i < N_TIMES; ++i)
+    Dphi_half_(h1, h0);
+  gettimeofday(&end, 0);
+  t_half = elapsed_ms(&start, &end) / N_TIMES;
+
+  lprintf("MAIN", 0, "Dphi_flt_:  %.3f ms, %.0f bytes per site, %.3g GB/s\n", t_flt, b_flt, vol * b_flt / t_flt * 1.e-6);
+  lprintf("MAIN", 0, "Dphi_half_: %.3f ms, %.0f bytes per site, %.3g GB/s\n", t_half, b_half, vol * b_half / t_half * 1.e-6);
+  lprintf("MAIN", 0, "Dphi_half_/Dphi_flt_: bytes %.2f, time %.2f\n", b_half / b_flt, t_half / t_flt);
+
+  free_spinor_field_f_flt(f0);
+  free_spinor_field_f_half(h0);
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+  u_gauge_f_flt = alloc_gfield_f_flt(&glattice);
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  fflush(stdout);
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  assign_ud2u_f_half();
+  lprintf("MAIN", 0, "done.\n");
+
+  return_value += check_conversion();
+  return_value += compare(&glattice, &glattice, 0, "Full lattice");
+  return_value += compare(&glat_even, &glat_odd, 0, "Odd to even");
+  return_value += compare(&glat_odd, &glat_even, 0, "Even to odd");
+  return_value += compare(&glat_even, &glat_even, 1, "Even/odd preconditioned, g5");
+
+  bandwidth();
+
+  finalize_process();
+  return return_value;
+}
@@ -0,0 +1,110 @@
+/*******************************************************************************
+*
+* NOCOMPILE= !WITH_SIMD_LAYOUT
+*
+* Coherence of the site-blocked Dirac operator with the standard one
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "update.h"
+#include "geometry.h"
+#include "global.h"
+#include "logger.h"
+#include "random.h"
+#include "memory.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "representation.h"
+#include "communications.h"
+#include "setup.h"
+
+static int compare(geometry_descriptor *out_type, geometry_descriptor *in_type, char *name)
+{
+  spinor_field *s0, *s1, *s2;
+  double sig, tau;
+
+  s0 = alloc_spinor_field_f(1, in_type);
+  s1 = alloc_spinor_field_f(2, out_type);
+  s2 = s1 + 1;
+
+  gaussian_spinor_field(s0);
+  tau = 1. / sqrt(spinor_field_sqnorm_f(s0));
+  spinor_field_mul_f(s0, tau, s0);
+
+  Dphi_fused_(s1, s0);
+  Dphi_simd_(s2, s0);
+
+  spinor_field_sub_assign_f(s2, s1);
+  sig = sqrt(spinor_field_sqnorm_f(s2));
+
+  lprintf("MAIN", 0, "%s: normalized difference = %.2e (should be around 1*10^(-15) or so)\n", name, sig);
+
+  free_spinor_field_f(s0);
+  free_spinor_field_f(s1);
+
+  return (sig > 1.e-14);
+}
+
+int main(int argc, char *argv[])
+{
+  double sig, tau;
+  spinor_field *s0, *s1;
+  spinor_field_flt *f0, *f1;
+  int return_value = 0;
+
+  /* setup process id and communications */
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+  u_gauge_f_flt = alloc_gfield_f_flt(&glattice);
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  fflush(stdout);
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  lprintf("MAIN", 0, "done.\n");
+
+  lprintf("MAIN", 0, "Block length SIMD_VLEN = %d\n", SIMD_VLEN);
+
+  return_value += compare(&glattice, &glattice, "Full lattice");
+  return_value += compare(&glat_even, &glat_odd, "Odd to even");
+  return_value += compare(&glat_odd, &glat_even, "Even to odd");
+
+  /* single precision kernel against the double precision one */
+  s0 = alloc_spinor_field_f(2, &glattice);
+  s1 = s0 + 1;
+  f0 = alloc_spinor_field_f_flt(2, &glattice);
+  f1 = f0 + 1;
+
+  gaussian_spinor_field(s0);
+  tau = 1. / sqrt(spinor_field_sqnorm_f(s0));
+  spinor_field_mul_f(s0, tau, s0);
+  assign_sd2s(f0, s0);
+
+  Dphi_fused_(s1, s0);
+  Dphi_flt_simd_(f1, f0);
+
+  assign_sd2s(f0, s1);
+  spinor_field_mul_add_assign_f_flt(f0, -1.0, f1);
+  sig = sqrt(spinor_field_sqnorm_f_flt(f0));
+
+  lprintf("MAIN", 0, "Single precision: normalized difference = %.2e (should be around 1*10^(-7) or so)\n", sig);
+  if (sig > 1.e-6)
+    return_value += 1;
+
+  free_spinor_field_f(s0);
+  free_spinor_field_f_flt(f0);
+
+  finalize_process();
+  return return_value;
+}
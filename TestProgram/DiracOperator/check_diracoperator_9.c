@@ -0,0 +1,79 @@
+/*******************************************************************************
+*
+* NOCOMPILE= !WITH_COMM_OVERLAP
+*
+* Coherence of the Dirac operator with overlapped communications with the standard one
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "update.h"
+#include "geometry.h"
+#include "global.h"
+#include "logger.h"
+#include "random.h"
+#include "memory.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "representation.h"
+#include "communications.h"
+#include "setup.h"
+
+static int compare(geometry_descriptor *out_type, geometry_descriptor *in_type, char *name)
+{
+  spinor_field *s0, *s1, *s2;
+  double sig, tau;
+
+  s0 = alloc_spinor_field_f(1, in_type);
+  s1 = alloc_spinor_field_f(2, out_type);
+  s2 = s1 + 1;
+
+  gaussian_spinor_field(s0);
+  tau = 1. / sqrt(spinor_field_sqnorm_f(s0));
+  spinor_field_mul_f(s0, tau, s0);
+
+  Dphi_fused_(s1, s0);
+  Dphi_(s2, s0);
+
+  spinor_field_sub_assign_f(s2, s1);
+  sig = sqrt(spinor_field_sqnorm_f(s2));
+
+  lprintf("MAIN", 0, "%s: normalized difference = %.2e (should be around 1*10^(-15) or so)\n", name, sig);
+
+  free_spinor_field_f(s0);
+  free_spinor_field_f(s1);
+
+  return (sig > 1.e-14);
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+
+  /* setup process id and communications */
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  fflush(stdout);
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  lprintf("MAIN", 0, "done.\n");
+
+  return_value += compare(&glattice, &glattice, "Full lattice");
+  return_value += compare(&glat_even, &glat_odd, "Odd to even");
+  return_value += compare(&glat_odd, &glat_even, "Even to odd");
+
+  finalize_process();
+  return return_value;
+}
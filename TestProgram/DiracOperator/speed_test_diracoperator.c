@@ -85,6 +85,7 @@ int main(int argc, char *argv[])
   lprintf("LA TEST", 0, "Byte per site = %d\n", bytesite);
 
   //speed test Dirac operator
+  lprintf("LA TEST", 0, "Standard layout\n");
   lprintf("LA TEST", 0, "Warmup application of the Diracoperator %d times.\n", n_warmup);
   _OMP_PRAGMA(_omp_parallel)
   {
@@ -123,6 +124,42 @@ int main(int argc, char *argv[])
   lprintf("LA TEST", 0, "GFLOPS: %1.6g\n\n", gflops);
   gflops = (double)n_times * GLB_T * GLB_X * GLB_Y * GLB_Z * bytesite / elapsed / 1.e6;
   lprintf("LA TEST", 0, "BAND: %1.6g GB/s\n\n", gflops);
+
+#ifdef WITH_SIMD_LAYOUT
+  //speed test of the site-blocked Dirac operator
+  lprintf("LA TEST", 0, "Site-blocked layout, SIMD_VLEN = %d\n", SIMD_VLEN);
+  lprintf("LA TEST", 0, "Warmup application of the Diracoperator %d times.\n", n_warmup);
+  _OMP_PRAGMA(_omp_parallel)
+  {
+    for (int i = 0; i < n_warmup; ++i)
+    {
+      Dphi_simd_(s2, s0);
+    }
+  }
+  lprintf("LA TEST", 0, "Calculating massless Diracoperator %d times.\n", n_times);
+  gettimeofday(&start, 0);
+  _OMP_PRAGMA(_omp_parallel)
+  {
+    for (int i = 0; i < n_times; ++i)
+    {
+      Dphi_simd_(s2, s0);
+    }
+  }
+  gettimeofday(&end, 0);
+  timeval_subtract(&etime, &end, &start);
+  elapsed = etime.tv_sec * 1000. + etime.tv_usec * 0.001;
+  lprintf("LA TEST", 0, "Time: [%ld sec %ld usec]\n", etime.tv_sec, etime.tv_usec);
+
+  spinor_field_sub_assign_f(s2, s1);
+  res1 = spinor_field_sqnorm_f(s2);
+  lprintf("LA_TEST", 0, "Square norm of the difference with the standard layout %lf\n", res1);
+
+  gflops = ((double)n_times * GLB_T * GLB_X * GLB_Y * GLB_Z * flopsite) / elapsed / 1.e6;
+  lprintf("LA TEST", 0, "GFLOPS: %1.6g\n\n", gflops);
+  gflops = (double)n_times * GLB_T * GLB_X * GLB_Y * GLB_Z * bytesite / elapsed / 1.e6;
+  lprintf("LA TEST", 0, "BAND: %1.6g GB/s\n\n", gflops);
+#endif
+
   lprintf("LA TEST", 0, "DONE!");
 
   free_spinor_field_f(s0);
@@ -40,6 +40,7 @@ int main(int argc,char *argv[])
   char tmp[256];
   double res1,res2,res_cpu,res_gpu;
   spinor_field_flt *s0,*s1,*s2,*s3;
+  spinor_field_half *h0,*h1;
   float elapsed, gflops;
   int i;
   int flopsite, bytesite;
@@ -142,6 +143,31 @@ int main(int argc,char *argv[])
   lprintf("LA TEST",0,"GFLOPS: %1.6g\n\n",gflops);
   gflops=(double)n_times*GLB_T*GLB_X*GLB_Y*GLB_Z*bytesite/elapsed/1.e6;
   lprintf("LA TEST",0,"BAND: %1.6g GB/s\n\n",gflops);
+
+  //effective bandwidth: 8 neighbours and 8 links read, 1 spinor written
+  bytesite=9*sizeof(suNf_spinor_flt)+8*sizeof(suNf_flt);
+  gflops=(double)n_times*GLB_T*GLB_X*GLB_Y*GLB_Z*bytesite/elapsed/1.e6;
+  lprintf("LA TEST",0,"Single precision: %d byte per site, effective BAND: %1.6g GB/s\n\n",bytesite,gflops);
+
+  //speed test half precision Dirac operator
+  assign_ud2u_f_half();
+  h0=alloc_spinor_field_f_half(2,&glattice);
+  h1=h0+1;
+  assign_s2sh(h0,s0);
+  bytesite=9*sizeof(suNf_spinor_half)+8*sizeof(suNf_half);
+  lprintf("LA TEST",0,"Calculating massless half precision Diracoperator %d times.\n",n_times);
+  gettimeofday(&start,0);
+  for (i=0;i<n_times;++i){ Dphi_half_(h1,h0); }
+  gettimeofday(&end,0);
+  timeval_subtract(&etime,&end,&start);
+  elapsed=etime.tv_sec*1000.+etime.tv_usec*0.001;
+  lprintf("LA TEST",0,"Time: [%ld sec %ld usec]\n",etime.tv_sec,etime.tv_usec);
+  gflops=(double)n_times*GLB_T*GLB_X*GLB_Y*GLB_Z*flopsite/elapsed/1.e6;
+  lprintf("LA TEST",0,"GFLOPS: %1.6g\n\n",gflops);
+  gflops=(double)n_times*GLB_T*GLB_X*GLB_Y*GLB_Z*bytesite/elapsed/1.e6;
+  lprintf("LA TEST",0,"Half precision: %d byte per site, effective BAND: %1.6g GB/s\n\n",bytesite,gflops);
+  free_spinor_field_f_half(h0);
+
   lprintf("LA TEST",0,"DONE!");
 
   
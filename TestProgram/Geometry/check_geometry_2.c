@@ -0,0 +1,99 @@
+/*******************************************************************************
+*
+* Check of the multi-stream runs: each replica works in its own directory with
+* its own random numbers, and the trajectories of the shared pool are given
+* out exactly once.
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "global.h"
+#include "io.h"
+#include "geometry.h"
+#include "logger.h"
+#include "random.h"
+#include "setup.h"
+#include "communications.h"
+#include "observables.h"
+
+#define NTRAJ 9
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+
+  /* working directory */
+  if (N_REP > 1)
+  {
+    char cwd[512], rep[64];
+    sprintf(rep, "/Rep_%d", RID);
+    if (getcwd(cwd, sizeof(cwd)) == NULL || strlen(cwd) < strlen(rep) || strcmp(cwd + strlen(cwd) - strlen(rep), rep) != 0)
+    {
+      lprintf("MAIN", 0, "Wrong working directory for replica %d\n", RID);
+      return_value++;
+    }
+  }
+
+  /* random numbers must differ between all the processes */
+  double r;
+  ranlxd(&r, 1);
+#ifdef WITH_MPI
+  double *rall = malloc(MPI_WORLD_SIZE * sizeof(double));
+  MPI_Allgather(&r, 1, MPI_DOUBLE, rall, 1, MPI_DOUBLE, MPI_COMM_WORLD);
+  for (int i = 0; i < MPI_WORLD_SIZE; i++)
+    for (int j = 0; j < i; j++)
+      if (rall[i] == rall[j])
+      {
+        lprintf("MAIN", 0, "Equal random numbers on processes %d and %d\n", i, j);
+        return_value++;
+      }
+  free(rall);
+#endif
+
+  /* shared pool: the replicas do different amounts of work per trajectory */
+  init_replica_pool(NTRAJ);
+  int taken = 0;
+  while (replica_pool_next())
+  {
+    for (int k = 0; k <= 2 * RID; k++)
+    {
+      random_u(u_gauge);
+      avr_plaquette();
+    }
+    taken++;
+  }
+  replica_report(taken, taken);
+
+  int sum = taken;
+  global_sum_int(&sum, 1);
+  if (sum != taken * WORLD_SIZE)
+  {
+    lprintf("MAIN", 0, "The processes of replica %d disagree on the trajectories\n", RID);
+    return_value++;
+  }
+
+  int total = (PID == 0) ? taken : 0;
+#ifdef WITH_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &total, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+#endif
+  lprintf("MAIN", 0, "Replica %d: %d trajectories, %d in total (should be %d)\n", RID, taken, total, NTRAJ);
+  if (total != NTRAJ)
+    return_value++;
+
+#ifdef WITH_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &return_value, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+#endif
+
+  finalize_process();
+
+  return return_value;
+}
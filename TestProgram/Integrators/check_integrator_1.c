@@ -71,7 +71,7 @@ int main(int argc, char *argv[])
   if (res > 1.0e-14)
     return_value++;
 
-  double rt0[SCALING_RANGE], rt1[SCALING_RANGE], rt2[SCALING_RANGE];
+  double rt0[SCALING_RANGE], rt1[SCALING_RANGE], rt2[SCALING_RANGE], rt3[SCALING_RANGE], rt4[SCALING_RANGE];
 
   for (int i = 0; i < SCALING_RANGE; i++)
   {
@@ -101,7 +101,23 @@ int main(int argc, char *argv[])
     elapsed = etime.tv_sec * 1000. + etime.tv_usec * 0.001;
     lprintf("MAIN", 0, "O4mn timing for dt= %lf  %lf msec \n", 1.0 / ((double)(i)), elapsed);
 
-    lprintf("MAIN", 0, "Delta H at nsteps %lf for LF: %1.16e O2: %1.16e O4: %1.16e\n\n", 1.0 / ((double)(i * 10 + 20)), rt0[i], rt1[i], rt2[i]);
+    set_integrator_type(&(flow.hmc_v->hmc_p), FG);
+    gettimeofday(&start, 0);
+    rt3[i] = integrate_ghmc(1, &(flow.hmc_v->hmc_p));
+    gettimeofday(&end, 0);
+    timeval_subtract(&etime, &end, &start);
+    elapsed = etime.tv_sec * 1000. + etime.tv_usec * 0.001;
+    lprintf("MAIN", 0, "FG timing for dt= %lf  %lf msec \n", 1.0 / ((double)(i)), elapsed);
+
+    set_integrator_type(&(flow.hmc_v->hmc_p), FG_POS);
+    gettimeofday(&start, 0);
+    rt4[i] = integrate_ghmc(1, &(flow.hmc_v->hmc_p));
+    gettimeofday(&end, 0);
+    timeval_subtract(&etime, &end, &start);
+    elapsed = etime.tv_sec * 1000. + etime.tv_usec * 0.001;
+    lprintf("MAIN", 0, "FG_pos timing for dt= %lf  %lf msec \n", 1.0 / ((double)(i)), elapsed);
+
+    lprintf("MAIN", 0, "Delta H at nsteps %lf for LF: %1.16e O2: %1.16e O4: %1.16e FG: %1.16e FG_pos: %1.16e\n\n", 1.0 / ((double)(i * 10 + 20)), rt0[i], rt1[i], rt2[i], rt3[i], rt4[i]);
   }
 
   double scaling_deviation1;
@@ -120,6 +136,14 @@ int main(int argc, char *argv[])
       return_value++;
   }
 
+  /* the force-gradient integrators are 4th order: from the largest to the smallest dt
+     Delta H must drop by about 3^4, against 3^2 for a 2nd order error */
+  double drop_fg = fabs(rt3[0] / rt3[SCALING_RANGE - 1]);
+  double drop_fg_pos = fabs(rt4[0] / rt4[SCALING_RANGE - 1]);
+  lprintf("MAIN", 0, "Delta H drop from dt=%lf to dt=%lf for FG: %lf FG_pos: %lf\n(should be around 81)\n\n", 1.0 / 20., ldt, drop_fg, drop_fg_pos);
+  if (drop_fg < 20. || drop_fg_pos < 20.)
+    return_value++;
+
   /* close communications */
   finalize_process();
 
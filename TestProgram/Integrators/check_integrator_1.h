@@ -13,7 +13,9 @@ enum
 {
   LEAPFROG,
   O2MN,
-  O4MN
+  O4MN,
+  FG,
+  FG_POS
 };
 
 /* HMC variables */
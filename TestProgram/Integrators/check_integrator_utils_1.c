@@ -366,6 +366,10 @@ void set_integrator_type(ghmc_par *gpar, int type)
 		lprintf("set_integrator_type", 0, "Setting all the integrator type to O2MN");
 	else if (type == O4MN)
 		lprintf("set_integrator_type", 0, "Setting all the integrator type to O4MN");
+	else if (type == FG)
+		lprintf("set_integrator_type", 0, "Setting all the integrator type to FG");
+	else if (type == FG_POS)
+		lprintf("set_integrator_type", 0, "Setting all the integrator type to FG_POS");
 	else
 		error(0 == 0, 0, "set_integrator_type", "Wrong integrator identifier");
 
@@ -378,6 +382,10 @@ void set_integrator_type(ghmc_par *gpar, int type)
 			pint->integrator = &O2MN_multistep;
 		else if (type == O4MN)
 			pint->integrator = &O4MN_multistep;
+		else if (type == FG)
+			pint->integrator = &FG_multistep;
+		else if (type == FG_POS)
+			pint->integrator = &FG_pos_multistep;
 
 		pint = pint->next;
 	} while (pint != NULL);
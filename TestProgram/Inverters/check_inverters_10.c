@@ -0,0 +1,142 @@
+/******************************************************************************
+*
+* Test of the multigrid solver
+*
+******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "random.h"
+#include "error.h"
+#include "geometry.h"
+#include "memory.h"
+#include "update.h"
+#include "global.h"
+#include "suN.h"
+#include "suN_types.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "inverters.h"
+#include "representation.h"
+#include "utils.h"
+#include "logger.h"
+#include "communications.h"
+#include "setup.h"
+
+static double hmass = -0.1;
+
+static void D_op(spinor_field *out, spinor_field *in)
+{
+  Dphi(hmass, out, in);
+}
+
+static void D_pre(spinor_field *out, spinor_field *in)
+{
+  Dphi_eopre(hmass, out, in);
+}
+
+static int check(char *name, spinor_operator op, double err2, spinor_field *in, spinor_field *out, spinor_field *tmp)
+{
+  double tau;
+  op(tmp, out);
+  spinor_field_sub_assign_f(tmp, in);
+  tau = spinor_field_sqnorm_f(tmp) / spinor_field_sqnorm_f(in);
+  lprintf("MG TEST", 0, "test %s = %e (req. %e)\n", name, tau, err2);
+  return (tau > err2) ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+  int iters;
+  spinor_field *in, *out, *tmp, *in_e, *out_e, *tmp_e;
+  double shift = 0.;
+  mshift_par par;
+  mg_par mg;
+
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  fflush(stdout);
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  complete_gf_sendrecv(u_gauge);
+  lprintf("MAIN", 0, "done.\n");
+  represent_gauge_field();
+
+  in = alloc_spinor_field_f(3, &glattice);
+  out = in + 1;
+  tmp = out + 1;
+  in_e = alloc_spinor_field_f(3, &glat_even);
+  out_e = in_e + 1;
+  tmp_e = out_e + 1;
+
+  mg_init(&mg, hmass);
+  for (int mu = 0; mu < 4; mu++)
+    mg.block[mu] = 2;
+  mg.nvec = 4;
+
+  par.n = 1;
+  par.shift = &shift;
+  par.err2 = 1.e-20;
+  par.max_iter = 0;
+  par.add_par = &mg;
+
+  /* full operator */
+  lprintf("MG TEST", 0, "Testing multigrid on D\n");
+  lprintf("MG TEST", 0, "----------------------\n");
+  gaussian_spinor_field(in);
+  spinor_field_zero_f(out);
+  iters = mg_solve(&par, &D_op, in, out);
+  lprintf("MG TEST", 0, "Converged in %d iterations\n", iters);
+  return_value += check("mg_solve D", &D_op, par.err2, in, out, tmp);
+
+  /* even/odd preconditioned operator */
+  lprintf("MG TEST", 0, "Testing multigrid on D_eopre\n");
+  lprintf("MG TEST", 0, "----------------------------\n");
+  gaussian_spinor_field(in_e);
+  spinor_field_zero_f(out_e);
+  iters = mg_solve(&par, &D_pre, in_e, out_e);
+  lprintf("MG TEST", 0, "Converged in %d iterations\n", iters);
+  return_value += check("mg_solve D_eopre", &D_pre, par.err2, in_e, out_e, tmp_e);
+
+  /* incremental refresh of the null space after a change of the gauge field */
+  lprintf("MG TEST", 0, "Testing the refresh of the null space\n");
+  lprintf("MG TEST", 0, "-------------------------------------\n");
+  mg.reuse = 1;
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  complete_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  spinor_field_zero_f(out);
+  iters = mg_solve(&par, &D_op, in, out);
+  lprintf("MG TEST", 0, "Converged in %d iterations\n", iters);
+  return_value += check("mg_solve refresh", &D_op, par.err2, in, out, tmp);
+
+  /* setup from the low modes of (g5 D)^2 */
+  lprintf("MG TEST", 0, "Testing the setup from eva\n");
+  lprintf("MG TEST", 0, "--------------------------\n");
+  mg.setup_eva = 20;
+  mg_setup(&mg);
+  spinor_field_zero_f(out);
+  iters = mg_solve(&par, &D_op, in, out);
+  lprintf("MG TEST", 0, "Converged in %d iterations\n", iters);
+  return_value += check("mg_solve eva", &D_op, par.err2, in, out, tmp);
+
+  mg_free(&mg);
+  free_spinor_field_f(in_e);
+  free_spinor_field_f(in);
+
+  finalize_process();
+
+  return return_value;
+}
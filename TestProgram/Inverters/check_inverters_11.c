@@ -0,0 +1,156 @@
+/******************************************************************************
+*
+* Test of the SAP preconditioned GCR solver
+*
+******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "random.h"
+#include "error.h"
+#include "geometry.h"
+#include "memory.h"
+#include "update.h"
+#include "global.h"
+#include "suN.h"
+#include "suN_types.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "inverters.h"
+#include "representation.h"
+#include "utils.h"
+#include "logger.h"
+#include "communications.h"
+#include "setup.h"
+
+static double hmass = -0.1;
+
+static void D_op(spinor_field *out, spinor_field *in)
+{
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+  Cphi(hmass, out, in);
+#else
+  Dphi(hmass, out, in);
+#endif
+}
+
+static void D_pre(spinor_field *out, spinor_field *in)
+{
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+  Cphi_eopre(hmass, out, in);
+#else
+  Dphi_eopre(hmass, out, in);
+#endif
+}
+
+static int check(char *name, spinor_operator op, double err2, spinor_field *in, spinor_field *out, spinor_field *tmp)
+{
+  double tau;
+  op(tmp, out);
+  spinor_field_sub_assign_f(tmp, in);
+  tau = spinor_field_sqnorm_f(tmp) / spinor_field_sqnorm_f(in);
+  lprintf("SAP TEST", 0, "test %s = %e (req. %e)\n", name, tau, err2);
+  return (tau > err2) ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+  int iters, iters0;
+  spinor_field *in, *out, *tmp, *in_e, *out_e, *tmp_e;
+  double shift = 0.;
+  mshift_par par;
+  SAP_par sap;
+  GCR_par gpar;
+  const int block[4] = {4, 4, 2, 2};
+
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  fflush(stdout);
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  complete_gf_sendrecv(u_gauge);
+  lprintf("MAIN", 0, "done.\n");
+  represent_gauge_field();
+
+  in = alloc_spinor_field_f(3, &glattice);
+  out = in + 1;
+  tmp = out + 1;
+  in_e = alloc_spinor_field_f(3, &glat_even);
+  out_e = in_e + 1;
+  tmp_e = out_e + 1;
+
+  SAP_init(&sap, hmass);
+  for (int mu = 0; mu < 4; mu++)
+    sap.block[mu] = block[mu];
+
+  par.n = 1;
+  par.shift = &shift;
+  par.err2 = 1.e-20;
+  par.max_iter = 0;
+  par.add_par = &sap;
+
+  gpar.err2 = par.err2;
+  gpar.max_iter = 0;
+  gpar.nkv = sap.gcr_nkv;
+
+  /* full operator */
+  lprintf("SAP TEST", 0, "Testing SAP_GCR on D\n");
+  lprintf("SAP TEST", 0, "--------------------\n");
+  gaussian_spinor_field(in);
+  spinor_field_zero_f(out);
+  iters = SAP_GCR(&par, &D_op, in, out);
+  lprintf("SAP TEST", 0, "Converged in %d iterations\n", iters);
+  return_value += check("SAP_GCR D", &D_op, par.err2, in, out, tmp);
+
+  /* the preconditioner must reduce the number of outer iterations */
+  spinor_field_zero_f(out);
+  iters0 = GCR(&gpar, &D_op, NULL, in, out);
+  lprintf("SAP TEST", 0, "Unpreconditioned GCR: %d iterations\n", iters0);
+  if (iters >= iters0)
+  {
+    lprintf("SAP TEST", 0, "SAP does not reduce the number of iterations\n");
+    return_value++;
+  }
+
+  /* even/odd preconditioned operator */
+  lprintf("SAP TEST", 0, "Testing SAP_GCR on D_eopre\n");
+  lprintf("SAP TEST", 0, "--------------------------\n");
+  gaussian_spinor_field(in_e);
+  spinor_field_zero_f(out_e);
+  iters = SAP_GCR(&par, &D_pre, in_e, out_e);
+  lprintf("SAP TEST", 0, "Converged in %d iterations\n", iters);
+  return_value += check("SAP_GCR D_eopre", &D_pre, par.err2, in_e, out_e, tmp_e);
+
+  /* after a change of the gauge field and of the mass */
+  lprintf("SAP TEST", 0, "Testing SAP_GCR on a new gauge field\n");
+  lprintf("SAP TEST", 0, "------------------------------------\n");
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  complete_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  hmass = 0.1;
+  sap.mass = hmass;
+  spinor_field_zero_f(out);
+  iters = SAP_GCR(&par, &D_op, in, out);
+  lprintf("SAP TEST", 0, "Converged in %d iterations\n", iters);
+  return_value += check("SAP_GCR new gauge field", &D_op, par.err2, in, out, tmp);
+
+  SAP_free(&sap);
+  free_spinor_field_f(in_e);
+  free_spinor_field_f(in);
+
+  finalize_process();
+
+  return return_value;
+}
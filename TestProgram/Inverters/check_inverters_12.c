@@ -0,0 +1,121 @@
+/******************************************************************************
+*
+* Test of the CG with half precision Krylov vectors (cg_half)
+*
+******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "random.h"
+#include "error.h"
+#include "geometry.h"
+#include "memory.h"
+#include "update.h"
+#include "global.h"
+#include "suN.h"
+#include "suN_types.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "inverters.h"
+#include "representation.h"
+#include "utils.h"
+#include "logger.h"
+#include "communications.h"
+#include "setup.h"
+
+static double hmass = 0.1;
+
+void M(spinor_field *out, spinor_field *in)
+{
+  g5Dphi_eopre_sq(hmass, out, in);
+}
+
+void M_flt(spinor_field_flt *out, spinor_field_flt *in)
+{
+  g5Dphi_eopre_sq_flt(hmass, out, in);
+}
+
+void M_half(spinor_field_half *out, spinor_field_half *in)
+{
+  g5Dphi_eopre_sq_half(hmass, out, in);
+}
+
+static int check(mshift_par *par, spinor_field *in, spinor_field *out, spinor_field *tmp, char *name)
+{
+  double tau;
+  int cgiters;
+  struct timeval start, end, etime;
+
+  spinor_field_zero_f(out);
+  gettimeofday(&start, 0);
+  cgiters = cg_half(par, &M, &M_flt, &M_half, in, out);
+  gettimeofday(&end, 0);
+  timeval_subtract(&etime, &end, &start);
+
+  M(tmp, out);
+  spinor_field_mul_add_assign_f(tmp, -par->shift[0], out);
+  spinor_field_sub_assign_f(tmp, in);
+  tau = spinor_field_sqnorm_f(tmp) / spinor_field_sqnorm_f(in);
+  lprintf("CG TEST", 0, "%s: %d applications in %ld sec %ld usec, test = %e (req. %e)\n", name, cgiters, etime.tv_sec, etime.tv_usec, tau, par->err2);
+
+  return (tau > par->err2);
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+  int cgiters;
+  mshift_par par;
+  double shift;
+  spinor_field *s1, *s2, *tmp;
+
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+  u_gauge_f_flt = alloc_gfield_f_flt(&glattice);
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  assign_ud2u_f_half();
+  lprintf("MAIN", 0, "done.\n");
+
+  s1 = alloc_spinor_field_f(3, &glat_even);
+  s2 = s1 + 1;
+  tmp = s2 + 1;
+  gaussian_spinor_field(s1);
+
+  par.n = 1;
+  par.shift = &shift;
+  par.err2 = 1.e-20;
+  par.max_iter = 0;
+
+  shift = 0.;
+  return_value += check(&par, s1, s2, tmp, "cg_half");
+  shift = -0.1;
+  return_value += check(&par, s1, s2, tmp, "cg_half with shift");
+
+  /* the half precision links follow the gauge field through assign_ud2u_f */
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  return_value += check(&par, s1, s2, tmp, "cg_half, new gauge field");
+
+  spinor_field_zero_f(s2);
+  cgiters = cg_mshift_flt(&par, &M, &M_flt, s1, s2);
+  lprintf("CG TEST", 0, "cg_mshift_flt for comparison: %d iterations\n", cgiters);
+
+  free_spinor_field_f(s1);
+
+  finalize_process();
+
+  return return_value;
+}
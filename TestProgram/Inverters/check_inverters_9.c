@@ -0,0 +1,141 @@
+/******************************************************************************
+*
+* Test of the block solvers
+*
+******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "random.h"
+#include "error.h"
+#include "geometry.h"
+#include "memory.h"
+#include "update.h"
+#include "global.h"
+#include "suN.h"
+#include "suN_types.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "inverters.h"
+#include "representation.h"
+#include "utils.h"
+#include "logger.h"
+#include "communications.h"
+#include "setup.h"
+
+#define NRHS 4
+
+static double hmass = 0.1;
+
+static void M_op(spinor_field *out, spinor_field *in)
+{
+  g5Dphi_eopre_sq(hmass, out, in);
+}
+
+static void H_op(spinor_field *out, spinor_field *in)
+{
+  g5Dphi_eopre(hmass, out, in);
+}
+
+static spinor_field *mtmp;
+
+static void M_block(spinor_field *out, spinor_field *in, int n)
+{
+  g5Dphi_eopre_block(hmass, mtmp, in, n);
+  g5Dphi_eopre_block(hmass, out, mtmp, n);
+}
+
+static void H_block(spinor_field *out, spinor_field *in, int n)
+{
+  g5Dphi_eopre_block(hmass, out, in, n);
+}
+
+/* the last source is a combination of the others, to test the deflation of the block */
+static void init_sources(spinor_field *in)
+{
+  for (int k = 0; k < NRHS - 1; k++)
+    gaussian_spinor_field(&in[k]);
+  spinor_field_lc_f(&in[NRHS - 1], 0.5, &in[0], -2., &in[1]);
+}
+
+static int check(char *name, spinor_operator op, double shift, double err2, spinor_field *in, spinor_field *out, spinor_field *tmp)
+{
+  int ret = 0;
+  for (int k = 0; k < NRHS; k++)
+  {
+    double tau;
+    op(tmp, &out[k]);
+    spinor_field_mul_add_assign_f(tmp, -shift, &out[k]);
+    spinor_field_sub_assign_f(tmp, &in[k]);
+    tau = spinor_field_sqnorm_f(tmp) / spinor_field_sqnorm_f(&in[k]);
+    lprintf("BLOCK TEST", 0, "test %s[%d] = %e (req. %e)\n", name, k, tau, err2);
+    if (tau > err2)
+      ret += 1;
+  }
+  return ret;
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+  int iters;
+  spinor_field *in, *out, *tmp;
+  double shift = 0.01;
+  mshift_par par;
+  MINRES_par mpar;
+
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  fflush(stdout);
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  complete_gf_sendrecv(u_gauge);
+  lprintf("MAIN", 0, "done.\n");
+  represent_gauge_field();
+
+  in = alloc_spinor_field_f(3 * NRHS + 1, &glat_even);
+  out = in + NRHS;
+  mtmp = out + NRHS;
+  tmp = mtmp + NRHS;
+  init_sources(in);
+
+  /* block CG on g5 D g5 D - shift */
+  lprintf("BLOCK TEST", 0, "Testing block CG\n");
+  lprintf("BLOCK TEST", 0, "----------------\n");
+  par.n = 1;
+  par.shift = &shift;
+  par.err2 = 1.e-24;
+  par.max_iter = 0;
+  for (int k = 0; k < NRHS; k++)
+    spinor_field_zero_f(&out[k]);
+  iters = cg_block(&par, &M_block, in, out, NRHS);
+  lprintf("BLOCK TEST", 0, "Converged in %d MVM\n", iters);
+  return_value += check("cg_block", &M_op, shift, par.err2, in, out, tmp);
+
+  /* block MINRES on g5 D, indefinite */
+  lprintf("BLOCK TEST", 0, "Testing block MINRES\n");
+  lprintf("BLOCK TEST", 0, "--------------------\n");
+  mpar.err2 = 1.e-24;
+  mpar.max_iter = 0;
+  for (int k = 0; k < NRHS; k++)
+    spinor_field_zero_f(&out[k]);
+  iters = MINRES_block(&mpar, &H_block, in, out, NRHS);
+  lprintf("BLOCK TEST", 0, "Converged in %d MVM\n", iters);
+  return_value += check("MINRES_block", &H_op, 0., mpar.err2, in, out, tmp);
+
+  free_spinor_field_f(in);
+
+  finalize_process();
+
+  return return_value;
+}
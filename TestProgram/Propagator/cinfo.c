@@ -0,0 +1,42 @@
+static char MACROS[179+1] = "-DBC_T_PERIODIC -DBC_X_PERIODIC -DBC_Y_PERIODIC -DBC_Z_PERIODIC -DWITH_EO -DNDEBUG -DCHECK_SPINOR_MATCHING -DIO_FLUSH -DREPR_FUNDAMENTAL -DREPR_NAME=@REPR_FUNDAMENTAL@ -DGAUGE_SUN";
+
+static char CI_mkflags[366+1] = "NG = 3\nREPR = REPR_FUNDAMENTAL\nGAUGE_GROUP = GAUGE_SUN\nMACRO += -DBC_T_PERIODIC\nMACRO += -DBC_X_PERIODIC\nMACRO += -DBC_Y_PERIODIC\nMACRO += -DBC_Z_PERIODIC\nMACRO += -DWITH_EO\nMACRO += -DNDEBUG\nMACRO += -DCHECK_SPINOR_MATCHING\nMACRO += -DIO_FLUSH\nCC = gcc\nMPICC = mpicc\nCFLAGS = -Wall -Wshadow -Wfatal-errors -Werror -std=c99 -O3\nINCLUDE = \nLDFLAGS = \n";
+
+static char CI_cpuinfo[1456+1] = "processor	: 0\nvendor_id	: GenuineIntel\ncpu family	: 6\nmodel		: 207\nmodel name	: Intel(R) Xeon(R) Processor\nstepping	: 2\nmicrocode	: 0x1\ncpu MHz		: 2100.000\ncache size	: 307200 KB\nphysical id	: 0\nsiblings	: 1\ncore id		: 0\ncpu cores	: 1\napicid		: 0\ninitial apicid	: 0\nfpu		: yes\nfpu_exception	: yes\ncpuid level	: 32\nwp		: yes\nflags		: fpu vme de pse tsc msr pae mce cx8 apic sep mtrr pge mca cmov pat pse36 clflush mmx fxsr sse sse2 ss syscall nx pdpe1gb rdtscp lm constant_tsc rep_good nopl xtopology nonstop_tsc cpuid tsc_known_freq pni pclmulqdq ssse3 fma cx16 pcid sse4_1 sse4_2 x2apic movbe popcnt tsc_deadline_timer aes xsave avx f16c rdrand hypervisor lahf_lm abm 3dnowprefetch cpuid_fault ssbd ibrs ibpb stibp ibrs_enhanced fsgsbase tsc_adjust bmi1 avx2 smep bmi2 erms invpcid avx512f avx512dq rdseed adx smap avx512ifma clflushopt clwb avx512cd sha_ni avx512bw avx512vl xsaveopt xsavec xgetbv1 xsaves avx_vnni avx512_bf16 wbnoinvd arat avx512vbmi umip pku ospke avx512_vbmi2 gfni vaes vpclmulqdq avx512_vnni avx512_bitalg avx512_vpopcntdq rdpid bus_lock_detect cldemote movdiri movdir64b fsrm md_clear serialize tsxldtrk ibt amx_bf16 avx512_fp16 amx_tile amx_int8 flush_l1d arch_capabilities\nbugs		: spectre_v1 spectre_v2 spec_store_bypass swapgs taa eibrs_pbrsb bhi ibpb_no_ret spectre_v2_user\nbogomips	: 4200.00\nclflush size	: 64\ncache_alignment	: 64\naddress sizes	: 46 bits physical, 57 bits virtual\npower management:\n\n";
+
+static char CI_linux[125+1] = "Linux version 6.18.44-fc-v139 (builder@sandboxing) (gcc (GCC) 15.3.0, GNU ld (GNU Binutils) 2.46) #1 SMP PREEMPT_DYNAMIC @0\n";
+
+static char CI_gcc[1540+1] = "Using built-in specs.\nCOLLECT_GCC=gcc\nCOLLECT_LTO_WRAPPER=/usr/lib/gcc/x86_64-linux-gnu/12/lto-wrapper\nOFFLOAD_TARGET_NAMES=nvptx-none:amdgcn-amdhsa\nOFFLOAD_TARGET_DEFAULT=1\nTarget: x86_64-linux-gnu\nConfigured with: ../src/configure -v --with-pkgversion='Debian 12.2.0-14+deb12u1' --with-bugurl=file:///usr/share/doc/gcc-12/README.Bugs --enable-languages=c,ada,c++,go,d,fortran,objc,obj-c++,m2 --prefix=/usr --with-gcc-major-version-only --program-suffix=-12 --program-prefix=x86_64-linux-gnu- --enable-shared --enable-linker-build-id --libexecdir=/usr/lib --without-included-gettext --enable-threads=posix --libdir=/usr/lib --enable-nls --enable-clocale=gnu --enable-libstdcxx-debug --enable-libstdcxx-time=yes --with-default-libstdcxx-abi=new --enable-gnu-unique-object --disable-vtable-verify --enable-plugin --enable-default-pie --with-system-zlib --enable-libphobos-checking=release --with-target-system-zlib=auto --enable-objc-gc=auto --enable-multiarch --disable-werror --enable-cet --with-arch-32=i686 --with-abi=m64 --with-multilib-list=m32,m64,mx32 --enable-multilib --with-tune=generic --enable-offload-targets=nvptx-none=/build/reproducible-path/gcc-12-12.2.0/debian/tmp-nvptx/usr,amdgcn-amdhsa=/build/reproducible-path/gcc-12-12.2.0/debian/tmp-gcn/usr --enable-offload-defaulted --without-cuda-driver --enable-checking=release --build=x86_64-linux-gnu --host=x86_64-linux-gnu --target=x86_64-linux-gnu\nThread model: posix\nSupported LTO compression algorithms: zlib zstd\ngcc version 12.2.0 (Debian 12.2.0-14+deb12u1) \n";
+
+static char CI_gitinfo[0+1] = " ";
+static char CI_gitrevision[41+1] = " b46d5bfe009621a2a9fbb03b0199237462d7385a ";
+
+#include <stdio.h>
+#include "logger.h"
+
+void print_compiling_info() {
+  printf("MACROS\n@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@\n");
+  printf("%s",MACROS);
+  printf("MkFlags\n@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@\n");
+  printf("%s",CI_mkflags);
+  printf("\n\n");
+  printf("git branch\n@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@\n");
+  printf("%s",CI_gitinfo);
+  printf("\n\n");
+  printf("git revision\n@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@\n");
+  printf("%s",CI_gitrevision);
+  printf("\n\n");
+  printf("/proc/cpuinfo\n@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@\n");
+  printf("%s",CI_cpuinfo);
+  printf("\n\n");
+  printf("/proc/version\n@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@\n");
+  printf("%s",CI_linux);
+  printf("\n\n");
+  printf("gcc -v\n@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@\n");
+  printf("%s",CI_gcc);
+}
+
+
+void print_compiling_info_short() {
+  lprintf("SYSTEM",0,"MACROS=%s",MACROS);
+}
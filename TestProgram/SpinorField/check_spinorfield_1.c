@@ -442,6 +442,61 @@ int main(int argc, char *argv[])
     lprintf("LA TEST", 0, "Test failed ?\n");
     return_value += 1;
   }
+  dmax = 0.0;
+
+  for (i = 0; i < 5; i++)
+  {
+    pk = &ws[i];
+    pl = &ws[9 - i];
+    gaussian_spinor_field(pk);
+    gaussian_spinor_field(pl);
+    spinor_field_copy_f(tmp, pk);
+    r = -0.731;
+    rd = spinor_field_mul_add_assign_sqnorm_f(pk, r, pl);
+
+    d = fabs(rd / spinor_field_sqnorm_f(pk) - 1.0);
+    if (d > dmax)
+      dmax = d;
+
+    spinor_field_mul_add_assign_f(tmp, r, pl);
+    spinor_field_sub_assign_f(tmp, pk);
+    d = sqrt(spinor_field_sqnorm_f(tmp) / spinor_field_sqnorm_f(pk));
+    if (d > dmax)
+      dmax = d;
+  }
+
+  lprintf("LA TEST", 0, "Check of mul_add_assign_sqnorm: %.2e\n\n", dmax);
+  if (dmax > 1e-14)
+  {
+    lprintf("LA TEST", 0, "Test failed ?\n");
+    return_value += 1;
+  }
+  dmax = 0.0;
+
+  for (i = 0; i < 5; i++)
+  {
+    pk = &ws[i];
+    pl = &ws[9 - i];
+    gaussian_spinor_field(pk);
+    gaussian_spinor_field(pl);
+    spinor_field_copy_f(tmp, pk);
+    r = 1.283;
+    spinor_field_xpay_f(pk, r, pl);
+
+    spinor_field_mul_f(tmp, r, tmp);
+    spinor_field_add_assign_f(tmp, pl);
+    spinor_field_sub_assign_f(tmp, pk);
+    d = sqrt(spinor_field_sqnorm_f(tmp) / spinor_field_sqnorm_f(pk));
+    if (d > dmax)
+      dmax = d;
+  }
+
+  lprintf("LA TEST", 0, "Check of xpay: %.2e\n\n", dmax);
+  if (dmax > 1e-14)
+  {
+    lprintf("LA TEST", 0, "Test failed ?\n");
+    return_value += 1;
+  }
   finalize_process();
 
   return return_value;
@@ -0,0 +1,139 @@
+/******************************************************************************
+ *
+ * Test of the pool of the field buffers (field_pool.c)
+ *
+ ******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "suN.h"
+#include "random.h"
+#include "error.h"
+#include "geometry.h"
+#include "memory.h"
+#include "update.h"
+#include "linear_algebra.h"
+#include "global.h"
+#include "logger.h"
+#include "setup.h"
+#include "hr_omp.h"
+
+#include "communications.h"
+
+#define NTHREAD_FIELDS 64
+
+int main(int argc, char *argv[])
+{
+  spinor_field *s1, *s2, *s3;
+  spinor_field_flt *f1;
+  suNf_spinor *p1, *pf1;
+  suNg_field *g1;
+  suNg *pg1;
+  int return_value = 0;
+  int nbad;
+
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  lprintf("POOL TEST", 0, "Recycling of the field buffers\n");
+  lprintf("POOL TEST", 0, "------------------------------\n");
+
+  /* a released buffer is reused by the same type and size only */
+  s1 = alloc_spinor_field_f(2, &glattice);
+  p1 = s1->ptr;
+  gaussian_spinor_field(&s1[0]);
+  free_spinor_field_f(s1);
+
+  s2 = alloc_spinor_field_f(1, &glattice);
+  s3 = alloc_spinor_field_f(2, &glat_even);
+  if (s2->ptr == p1 || s3->ptr == p1)
+  {
+    lprintf("POOL TEST", 0, "Buffer reused for a different size or type\n");
+    return_value += 1;
+  }
+  s1 = alloc_spinor_field_f(2, &glattice);
+  if (s1->ptr != p1)
+  {
+    lprintf("POOL TEST", 0, "Buffer not recycled\n");
+    return_value += 1;
+  }
+  if (s1[1].ptr != s1[0].ptr + glattice.gsize_spinor)
+  {
+    lprintf("POOL TEST", 0, "Wrong layout of a recycled buffer\n");
+    return_value += 1;
+  }
+  gaussian_spinor_field(&s1[1]);
+  spinor_field_copy_f(&s1[0], &s1[1]);
+  spinor_field_sub_assign_f(&s1[0], &s1[1]);
+  if (spinor_field_sqnorm_f(&s1[0]) != 0.)
+  {
+    lprintf("POOL TEST", 0, "Recycled buffer not usable\n");
+    return_value += 1;
+  }
+
+  /* the single precision fields have their own buffers */
+  f1 = alloc_spinor_field_f_flt(1, &glattice);
+  pf1 = (suNf_spinor *)f1->ptr;
+  free_spinor_field_f_flt(f1);
+  f1 = alloc_spinor_field_f_flt(1, &glattice);
+  if ((suNf_spinor *)f1->ptr != pf1)
+  {
+    lprintf("POOL TEST", 0, "Single precision buffer not recycled\n");
+    return_value += 1;
+  }
+
+  /* gauge fields */
+  g1 = alloc_gfield(&glattice);
+  pg1 = g1->ptr;
+  free_gfield(g1);
+  g1 = alloc_gfield(&glattice);
+  if (g1->ptr != pg1)
+  {
+    lprintf("POOL TEST", 0, "Gauge field buffer not recycled\n");
+    return_value += 1;
+  }
+
+  free_gfield(g1);
+  free_spinor_field_f_flt(f1);
+  free_spinor_field_f(s1);
+  free_spinor_field_f(s2);
+  free_spinor_field_f(s3);
+
+  /* concurrent allocations from the OpenMP threads get distinct buffers */
+  nbad = 0;
+  {
+    spinor_field *tf[NTHREAD_FIELDS];
+    _OMP_PRAGMA(_omp_parallel)
+    _OMP_PRAGMA(for schedule(dynamic))
+    for (int i = 0; i < NTHREAD_FIELDS; i++)
+      tf[i] = alloc_spinor_field_f(1, &glat_odd);
+
+    for (int i = 0; i < NTHREAD_FIELDS; i++)
+      for (int j = 0; j < i; j++)
+        if (tf[i]->ptr == tf[j]->ptr)
+          nbad++;
+
+    _OMP_PRAGMA(_omp_parallel)
+    _OMP_PRAGMA(for schedule(dynamic))
+    for (int i = 0; i < NTHREAD_FIELDS; i++)
+      free_spinor_field_f(tf[i]);
+  }
+  if (nbad != 0)
+  {
+    lprintf("POOL TEST", 0, "Same buffer given to %d fields\n", nbad);
+    return_value += 1;
+  }
+
+  pool_report();
+  pool_release();
+
+  lprintf("POOL TEST", 0, "Pool test %s\n", (return_value == 0) ? "passed" : "failed");
+
+  finalize_process();
+
+  return return_value;
+}
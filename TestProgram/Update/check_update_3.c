@@ -0,0 +1,132 @@
+/*******************************************************************************
+* Check the integrator tuner: the records of the tuning log and the
+* application of the proposed step counts
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "random.h"
+#include "error.h"
+#include "geometry.h"
+#include "memory.h"
+#include "update.h"
+#include "global.h"
+#include "observables.h"
+#include "suN.h"
+#include "suN_types.h"
+#include "dirac.h"
+#include "representation.h"
+#include "utils.h"
+#include "logger.h"
+#include "communications.h"
+#include "../HMC/hmc_utils.h"
+#include "setup.h"
+
+hmc_flow flow = init_hmc_flow(flow);
+
+/* number of records of the given kind in the tuning log */
+static int count_records(const char *file, const char *kind, char *last)
+{
+  char line[4096], key[64];
+  int n = 0;
+  FILE *fp = fopen(file, "r");
+
+  if (fp == NULL)
+    return -1;
+  sprintf(key, "\"record\":\"%s\"", kind);
+  while (fgets(line, sizeof(line), fp) != NULL)
+    if (strstr(line, key) != NULL)
+    {
+      n++;
+      if (last != NULL)
+        strcpy(last, line);
+    }
+  fclose(fp);
+  return n;
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+  char summary[4096];
+  integrator_par *ip;
+  ghmc_par *par;
+  int nlev = 0, nmon = 0;
+
+  setup_process(&argc, &argv);
+  setup_gauge_fields();
+
+  init_mc_ghmc(&flow, get_input_filename());
+  par = &flow.hmc_v->hmc_p;
+  error(par->tune_ntraj <= 0 || par->tune_log[0] == '\0' || !par->tune_apply, 1, "main [check_update_3.c]",
+        "The input file must enable the tuner with a log and apply = 1");
+  for (ip = par->integrator; ip != NULL; ip = ip->next)
+  {
+    nlev++;
+    nmon += ip->nmon;
+  }
+
+  /* the log is appended to */
+  if (PID == 0)
+    remove(par->tune_log);
+
+  for (int i = 0; i < par->tune_ntraj; i++)
+  {
+    lprintf("TUNER TEST", 0, "Trajectory %d: %s\n", i + 1, update_ghmc() ? "accepted" : "rejected");
+  }
+
+  if (ghmc_tune_on)
+  {
+    lprintf("TUNER TEST", 0, "The tuner is still active after the window\n");
+    return_value++;
+  }
+
+  if (PID == 0)
+  {
+    int ntraj = count_records(par->tune_log, "trajectory", NULL);
+    int nl = count_records(par->tune_log, "level", NULL);
+    int nm = count_records(par->tune_log, "monomial", NULL);
+    int ns = count_records(par->tune_log, "summary", summary);
+    char *p;
+    double pacc = 0.;
+
+    lprintf("TUNER TEST", 0, "Records: %d trajectory, %d level, %d monomial, %d summary\n", ntraj, nl, nm, ns);
+    if (ntraj != par->tune_ntraj || nl != nlev || nm != nmon || ns != 1)
+    {
+      lprintf("TUNER TEST", 0, "Wrong number of records, expected %d %d %d 1\n", par->tune_ntraj, nlev, nmon);
+      return_value++;
+    }
+    else
+    {
+      p = strstr(summary, "\"predicted_acceptance\":");
+      if (p != NULL)
+        pacc = atof(p + strlen("\"predicted_acceptance\":"));
+      lprintf("TUNER TEST", 0, "Predicted acceptance %1.4f, target %1.4f\n", pacc, par->tune_acc);
+      if (pacc < par->tune_acc)
+        return_value++;
+
+      /* the proposed step counts have been applied */
+      p = strstr(summary, "\"proposed_nsteps\":[");
+      p = (p != NULL) ? p + strlen("\"proposed_nsteps\":[") : NULL;
+      for (ip = par->integrator; ip != NULL && p != NULL; ip = ip->next)
+      {
+        int n = (int)strtol(p, &p, 10);
+        lprintf("TUNER TEST", 0, "Level %d: nsteps = %d, proposed %d\n", ip->level, ip->nsteps, n);
+        if (n != ip->nsteps || n < 1)
+          return_value++;
+        if (*p == ',')
+          p++;
+      }
+    }
+  }
+  bcast_int(&return_value, 1);
+
+  finalize_process();
+  return return_value;
+}
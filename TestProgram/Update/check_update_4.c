@@ -0,0 +1,127 @@
+/*******************************************************************************
+*
+* Check of the chronological guess (mre.c): a solution in the span of the
+* stored vectors is recovered, in single and half precision, with a basis
+* full of newer vectors and from a history shared with another mass
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "random.h"
+#include "error.h"
+#include "geometry.h"
+#include "memory.h"
+#include "update.h"
+#include "global.h"
+#include "suN.h"
+#include "suN_types.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "inverters.h"
+#include "representation.h"
+#include "utils.h"
+#include "logger.h"
+#include "communications.h"
+#include "setup.h"
+
+static double hmass = 0.1;
+
+static void Dop(spinor_field *out, spinor_field *in)
+{
+#ifdef UPDATE_EO
+  Dphi_eopre(hmass, out, in);
+#else
+  Dphi(hmass, out, in);
+#endif
+}
+
+/* relative error of the guess for the solution x = x0 + z x1 */
+static double guess_error(mre_par *par, spinor_field *x0, spinor_field *x1, double complex z, spinor_field *ws)
+{
+  spinor_field *x = ws, *pf = ws + 1, *out = ws + 2;
+
+  spinor_field_copy_f(x, x0);
+  spinor_field_mulc_add_assign_f(x, z, x1);
+  Dop(pf, x);
+  mre_guess(par, 0, out, &Dop, pf);
+  spinor_field_sub_assign_f(out, x);
+  return sqrt(spinor_field_sqnorm_f(out) / spinor_field_sqnorm_f(x));
+}
+
+static int check(const char *name, double err, double tol)
+{
+  lprintf("MRE TEST", 0, "%s: relative error = %1.6e (tolerance %1.1e)\n", name, err, tol);
+  return (err > tol);
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+  spinor_field *x, *ws;
+  mre_par ps, ph, pr, p1, p2;
+  const double complex z = 0.5 + 1.5 * I;
+  double err;
+
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  lprintf("MAIN", 0, "done.\n");
+
+  x = alloc_spinor_field_f(3, &glat_default);
+  ws = alloc_spinor_field_f(3, &glat_default);
+  for (int i = 0; i < 3; i++)
+    gaussian_spinor_field(x + i);
+
+  /* single and half precision */
+  mre_init(&ps, 4, 0, 0, 1e-14);
+  mre_init(&ph, 4, 0, 1, 1e-14);
+  mre_store(&ps, 0, x, 0);
+  mre_store(&ps, 0, x + 1, 0);
+  mre_store(&ph, 0, x, 0);
+  mre_store(&ph, 0, x + 1, 0);
+  return_value += check("single precision", guess_error(&ps, x, x + 1, z, ws), 1e-5);
+  return_value += check("half precision", guess_error(&ph, x, x + 1, z, ws), 1e-3);
+
+  /* the oldest vector is replaced: the newest solution is still in the basis */
+  mre_init(&pr, 2, 0, 0, 1e-14);
+  mre_store(&pr, 0, x, 0);
+  mre_store(&pr, 0, x + 1, 0);
+  mre_store(&pr, 0, x + 2, 0);
+  return_value += check("newest vector", guess_error(&pr, x + 2, x + 1, 0., ws), 1e-5);
+  err = guess_error(&pr, x, x + 1, z, ws);
+  lprintf("MRE TEST", 0, "oldest vector: relative error = %1.6e (expected of order 1)\n", err);
+  return_value += (err < 0.1);
+
+  /* shared history, used at a different mass */
+  mre_init(&p1, 4, 1, 0, 1e-14);
+  mre_init(&p2, 4, 1, 0, 1e-14);
+  mre_store(&p1, 0, x, 0);
+  mre_store(&p1, 0, x + 1, 0);
+  hmass = 0.3;
+  return_value += check("shared history", guess_error(&p2, x, x + 1, z, ws), 1e-5);
+
+  /* iterations saved, from the residual of the last guess */
+  mre_store(&p2, 0, x + 2, 20);
+  lprintf("MRE TEST", 0, "Solves with a guess: %d, saved iterations %1.1f\n", p2.nsolve, p2.zero_iter - p2.iter - p2.guess_iter);
+  return_value += (p2.nsolve != 1 || p2.zero_iter < 20);
+
+  free_spinor_field_f(x);
+  free_spinor_field_f(ws);
+
+  finalize_process();
+
+  return return_value;
+}
@@ -0,0 +1,140 @@
+/*******************************************************************************
+*
+* Check of the RHMC force computed with the mixed precision multi-shift CG
+* against the one computed with the double precision solver
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "random.h"
+#include "error.h"
+#include "geometry.h"
+#include "memory.h"
+#include "update.h"
+#include "global.h"
+#include "suN.h"
+#include "suN_types.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "inverters.h"
+#include "rational_functions.h"
+#include "representation.h"
+#include "utils.h"
+#include "logger.h"
+#include "communications.h"
+#include "setup.h"
+
+static void zero_momenta(suNg_av_field *mom)
+{
+  _MASTER_FOR(&glattice, ix)
+  {
+    for (int mu = 0; mu < 4; mu++)
+    {
+      _algebra_vector_zero_g(*_4FIELD_AT(mom, ix, mu));
+    }
+  }
+}
+
+/* |a-b|^2 and |b|^2 */
+static void momenta_diff(suNg_av_field *a, suNg_av_field *b, double *d2, double *n2)
+{
+  double dsum = 0., nsum = 0.;
+  _MASTER_FOR_SUM(&glattice, ix, dsum, nsum)
+  {
+    for (int mu = 0; mu < 4; mu++)
+    {
+      suNg_algebra_vector f = *_4FIELD_AT(a, ix, mu);
+      double nsq;
+      _algebra_vector_sqnorm_g(nsq, *_4FIELD_AT(b, ix, mu));
+      nsum += nsq;
+      _algebra_vector_sub_assign_g(f, *_4FIELD_AT(b, ix, mu));
+      _algebra_vector_sqnorm_g(nsq, f);
+      dsum += nsq;
+    }
+  }
+  global_sum(&dsum, 1);
+  global_sum(&nsum, 1);
+  *d2 = dsum;
+  *n2 = nsum;
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+  double minev, maxev, d2, n2;
+  rational_app ratio = {0};
+  force_rhmc_par fpar;
+  suNg_av_field *mom[2];
+  spinor_field *pf;
+
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+  if (u_gauge_f_flt == NULL)
+    u_gauge_f_flt = alloc_gfield_f_flt(&glattice);
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  lprintf("MAIN", 0, "done.\n");
+
+  /* rational approximation of H2^(-1/2), as for one flavour */
+  fpar.mass = -0.5;
+  set_dirac_mass(fpar.mass);
+  find_spec_H2(&maxev, &minev);
+  ratio.n = -1;
+  ratio.d = 2;
+  ratio.order = 16;
+  ratio.rel_error = 1e-10;
+  r_app_alloc(&ratio);
+  r_app_set(&ratio, minev, maxev);
+  lprintf("MAIN", 0, "Rational approximation of order %d on [%1.4e,%1.4e]\n", ratio.order, minev, maxev);
+
+  pf = alloc_spinor_field_f(1, &glat_default);
+  gaussian_spinor_field(pf);
+  mom[0] = alloc_avfield(&glattice);
+  mom[1] = alloc_avfield(&glattice);
+
+  fpar.id = 0;
+  fpar.n_pf = 1;
+  fpar.pf = pf;
+  fpar.ratio = &ratio;
+  fpar.inv_err2 = 1e-20;
+
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+  lprintf("RHMC TEST", 0, "Single precision clover operator not available: test skipped\n");
+  zero_momenta(mom[0]);
+  zero_momenta(mom[1]);
+#else
+  for (int k = 0; k < 2; k++)
+  {
+    fpar.mixed = k;
+    fpar.momenta = &mom[k];
+    zero_momenta(mom[k]);
+    force_rhmc(0.1, &fpar);
+  }
+#endif
+
+  momenta_diff(mom[1], mom[0], &d2, &n2);
+  lprintf("RHMC TEST", 0, "Mixed precision force: |F_mixed - F_double|^2 = %1.6e, |F_double|^2 = %1.6e\n", d2, n2);
+  if (d2 > 1e-16 * n2)
+    return_value++;
+
+  free_avfield(mom[0]);
+  free_avfield(mom[1]);
+  free_spinor_field_f(pf);
+  r_app_free(&ratio);
+
+  finalize_process();
+
+  return return_value;
+}
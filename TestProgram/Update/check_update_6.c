@@ -0,0 +1,133 @@
+/*******************************************************************************
+*
+* Check of the deflated solver of the fermion force: the solution must have
+* the requested precision, before and after the refinement of the low modes
+* following a small change of the gauge field, and the low modes must reduce
+* the cost of the solve
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "random.h"
+#include "error.h"
+#include "geometry.h"
+#include "memory.h"
+#include "update.h"
+#include "global.h"
+#include "suN.h"
+#include "suN_types.h"
+#include "dirac.h"
+#include "linear_algebra.h"
+#include "inverters.h"
+#include "representation.h"
+#include "utils.h"
+#include "logger.h"
+#include "communications.h"
+#include "setup.h"
+
+/* |D x - b|^2 / |b|^2 */
+static double rel_residual(spinor_field *x, spinor_field *b, spinor_field *tmp)
+{
+  D(tmp, x);
+  spinor_field_sub_assign_f(tmp, b);
+  return spinor_field_sqnorm_f(tmp) / spinor_field_sqnorm_f(b);
+}
+
+/* undeflated solve from a vanishing initial guess, applications of D */
+static int plain_solve(mshift_par *par, spinor_field *b, spinor_field *x, spinor_field *tmp)
+{
+  int cgiter;
+  spinor_field_g5_f(x, b);
+  H(tmp, x);
+  spinor_field_zero_f(x);
+  cgiter = cg_mshift(par, &H2, tmp, x);
+  return 2 * cgiter + 1;
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+  int mvm_defl, mvm_plain;
+  double res;
+  defl_par dp;
+  mshift_par mpar;
+  double shift = 0.;
+  field_gauge_par gpar;
+  suNg_av_field *mom;
+  spinor_field *b, *x;
+
+  logger_map("DEBUG", "debug");
+
+  setup_process(&argc, &argv);
+
+  setup_gauge_fields();
+
+  lprintf("MAIN", 0, "Generating a random gauge field... ");
+  random_u(u_gauge);
+  start_gf_sendrecv(u_gauge);
+  represent_gauge_field();
+  lprintf("MAIN", 0, "done.\n");
+
+  /* close enough to the critical mass for the low modes to matter */
+#if defined(WITH_CLOVER) || defined(WITH_EXPCLOVER)
+  set_dirac_mass(-1.4);
+#else
+  set_dirac_mass(-1.8);
+#endif
+
+  b = alloc_spinor_field_f(3, &glat_default);
+  x = b + 1;
+  gaussian_spinor_field(b);
+
+  mpar.n = 1;
+  mpar.shift = &shift;
+  mpar.err2 = 1e-20;
+  mpar.max_iter = 0;
+  mpar.add_par = &dp;
+
+  defl_init(&dp, 8, 1);
+
+  /* low modes computed with eva */
+  spinor_field_zero_f(x);
+  mvm_defl = defl_solve(&mpar, &D, b, x);
+  res = rel_residual(x, b, x + 1);
+  lprintf("DEFL TEST", 0, "Deflated solve: MVM = %d, |Dx-b|^2/|b|^2 = %1.6e\n", mvm_defl, res);
+  if (res > 1e-16)
+    return_value++;
+
+  /* small molecular dynamics step of the gauge field */
+  mom = alloc_avfield(&glattice);
+  gaussian_momenta(mom);
+  gpar.field = &u_gauge;
+  gpar.momenta = &mom;
+  update_gauge_field(0.01, &gpar);
+
+  /* low modes refined with Rayleigh-Ritz */
+  spinor_field_zero_f(x);
+  mvm_defl = defl_solve(&mpar, &D, b, x);
+  res = rel_residual(x, b, x + 1);
+  lprintf("DEFL TEST", 0, "Deflated solve after the update: MVM = %d, |Dx-b|^2/|b|^2 = %1.6e\n", mvm_defl, res);
+  if (res > 1e-16)
+    return_value++;
+
+  mpar.add_par = NULL;
+  mvm_plain = plain_solve(&mpar, b, x, x + 1);
+  res = rel_residual(x, b, x + 1);
+  lprintf("DEFL TEST", 0, "Undeflated solve: MVM = %d, |Dx-b|^2/|b|^2 = %1.6e\n", mvm_plain, res);
+  if (mvm_defl >= mvm_plain)
+    return_value++;
+
+  defl_free(&dp);
+  free_avfield(mom);
+  free_spinor_field_f(b);
+
+  finalize_process();
+
+  return return_value;
+}
@@ -0,0 +1,132 @@
+/*******************************************************************************
+* Check the cost accounting of the HMC: one record per trajectory in the cost
+* log, with the work of the trajectory split among the monomials
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "io.h"
+#include "random.h"
+#include "error.h"
+#include "geometry.h"
+#include "memory.h"
+#include "update.h"
+#include "global.h"
+#include "observables.h"
+#include "suN.h"
+#include "suN_types.h"
+#include "dirac.h"
+#include "representation.h"
+#include "utils.h"
+#include "logger.h"
+#include "communications.h"
+#include "../HMC/hmc_utils.h"
+#include "setup.h"
+
+#define NTRAJ 3
+
+hmc_flow flow = init_hmc_flow(flow);
+
+/* value of the first key after p, and sum of the values of the key after the monomials */
+static double get_value(const char *p, const char *key, double *mon_sum)
+{
+  char k[64];
+  const char *q, *mon = strstr(p, "\"monomials\":");
+  double v = -1.;
+
+  sprintf(k, "\"%s\":", key);
+  q = strstr(p, k);
+  if (q != NULL)
+    v = atof(q + strlen(k));
+  *mon_sum = 0.;
+  for (q = (mon != NULL) ? strstr(mon, k) : NULL; q != NULL; q = strstr(q + 1, k))
+    *mon_sum += atof(q + strlen(k));
+  return v;
+}
+
+int main(int argc, char *argv[])
+{
+  int return_value = 0;
+  ghmc_par *par;
+  double mvm[NTRAJ];
+
+  setup_process(&argc, &argv);
+  setup_gauge_fields();
+
+  init_mc_ghmc(&flow, get_input_filename());
+  par = &flow.hmc_v->hmc_p;
+  error(par->cost_log[0] == '\0', 1, "main [check_update_7.c]", "The input file must set cost_log");
+
+  /* the log is appended to */
+  if (PID == 0)
+    remove(par->cost_log);
+
+  getMVM();
+  for (int i = 0; i < NTRAJ; i++)
+  {
+    lprintf("COST TEST", 0, "Trajectory %d: %s\n", i + 1, update_ghmc() ? "accepted" : "rejected");
+    mvm[i] = getMVM();
+  }
+
+  if (PID == 0)
+  {
+    char line[8192];
+    int n = 0;
+    FILE *fp = fopen(par->cost_log, "r");
+    error(fp == NULL, 1, "main [check_update_7.c]", "Cannot open the cost log");
+
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+      double mon_mvm, mon_time, mon_iter, mon_bytes;
+      const double tot_mvm = get_value(line, "mvm", &mon_mvm);
+      const double tot_time = get_value(line, "time", &mon_time);
+      const double tot_iter = get_value(line, "iter", &mon_iter);
+      const double tot_bytes = get_value(line, "halo_bytes", &mon_bytes);
+      const char *gauge = strstr(line, "\"type\":\"gauge\"");
+      const char *hmc = strstr(line, "\"type\":\"hmc\"");
+
+      lprintf("COST TEST", 0, "Record %d: MVM = %g (monomials %g, getMVM %g), time = %g s (monomials %g s), "
+                              "iterations = %g (monomials %g), halo bytes = %g (monomials %g)\n",
+              n + 1, tot_mvm, mon_mvm, (n < NTRAJ) ? mvm[n] : -1., tot_time, mon_time, tot_iter, mon_iter, tot_bytes, mon_bytes);
+      if (n >= NTRAJ || strstr(line, "\"record\":\"cost\"") == NULL)
+      {
+        return_value++;
+        break;
+      }
+      /* all Dirac operators and solves of the trajectory belong to the monomials */
+      if (fabs(tot_mvm - mvm[n]) > 0.5 || fabs(mon_mvm - tot_mvm) > 1.e-6 || fabs(mon_iter - tot_iter) > 1.e-6 || tot_iter <= 0.)
+        return_value++;
+      /* the times are maxima over the processes: their sum may exceed the total slightly */
+      if (mon_time <= 0.5 * tot_time || mon_time > 1.5 * tot_time || mon_bytes > tot_bytes)
+        return_value++;
+      if (NP_T * NP_X * NP_Y * NP_Z > 1 && mon_bytes <= 0.)
+        return_value++;
+      /* the gauge monomial comes with no Dirac operators */
+      if (gauge == NULL || hmc == NULL)
+        return_value++;
+      else
+      {
+        const char *end = (hmc > gauge) ? hmc : line + strlen(line);
+        for (const char *q = strstr(gauge, "\"mvm\":"); q != NULL && q < end; q = strstr(q + 1, "\"mvm\":"))
+          if (atof(q + strlen("\"mvm\":")) != 0.)
+            return_value++;
+      }
+      n++;
+    }
+    fclose(fp);
+    if (n != NTRAJ)
+    {
+      lprintf("COST TEST", 0, "Found %d records, expected %d\n", n, NTRAJ);
+      return_value++;
+    }
+  }
+  bcast_int(&return_value, 1);
+
+  finalize_process();
+  return return_value;
+}
@@ -0,0 +1,188 @@
+/*******************************************************************************
+*
+* Check of the checkpoints written in the background: the files must be equal
+* to the ones written by write_gauge_field, write_scalar_field and
+* write_ranlxd_state, and must appear only when they are complete.
+*
+*******************************************************************************/
+
+#define MAIN_PROGRAM
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "global.h"
+#include "io.h"
+#include "update.h"
+#include "observables.h"
+#include "random.h"
+#include "logger.h"
+#include "communications.h"
+#include "representation.h"
+#include "setup.h"
+#include "memory.h"
+
+/* 0 if the two files have the same content */
+static int compare_files(char *name1, char *name2)
+{
+    int ret = 0;
+    if (PID == 0)
+    {
+        FILE *f1 = fopen(name1, "rb"), *f2 = fopen(name2, "rb");
+        if (f1 == NULL || f2 == NULL)
+        {
+            ret = 1;
+        }
+        else
+        {
+            int c1, c2;
+            do
+            {
+                c1 = fgetc(f1);
+                c2 = fgetc(f2);
+            } while (c1 == c2 && c1 != EOF);
+            ret = (c1 != c2);
+        }
+        if (f1 != NULL)
+            fclose(f1);
+        if (f2 != NULL)
+            fclose(f2);
+    }
+    bcast_int(&ret, 1);
+    return ret;
+}
+
+static int file_exists(char *name)
+{
+    int ret = 0;
+    if (PID == 0)
+    {
+        FILE *f = fopen(name, "rb");
+        if (f != NULL)
+        {
+            ret = 1;
+            fclose(f);
+        }
+    }
+    bcast_int(&ret, 1);
+    return ret;
+}
+
+static void remove_file(char *name)
+{
+    if (PID == 0)
+        remove(name);
+}
+
+int main(int argc, char *argv[])
+{
+    int return_value = 0;
+    double plaq[2];
+    suNg_field *u_save;
+    suNg_scalar_field *s_save;
+    char *files[3][2] = {{"sync_gauge", "async_gauge"}, {"sync_scalar", "async_scalar"}, {"sync_rlxd", "async_rlxd"}};
+
+    setup_process(&argc, &argv);
+
+    setup_gauge_fields();
+    u_scalar = alloc_scalar_field(&glattice);
+    u_save = alloc_gfield(&glattice);
+    s_save = alloc_scalar_field(&glattice);
+
+    lprintf("MAIN", 0, "Generating a random gauge and scalar field... ");
+    random_u(u_gauge);
+    random_s(u_scalar);
+    start_gf_sendrecv(u_gauge);
+    complete_gf_sendrecv(u_gauge);
+    represent_gauge_field();
+    suNg_field_copy(u_save, u_gauge);
+    _MASTER_FOR(&glattice, ix)
+    {
+        *_FIELD_AT(s_save, ix) = *_FIELD_AT(u_scalar, ix);
+    }
+    plaq[0] = avr_plaquette();
+    lprintf("MAIN", 0, "done.\n\n");
+
+    for (int k = 0; k < 3; k++)
+    {
+        remove_file(files[k][0]);
+        remove_file(files[k][1]);
+    }
+
+    write_gauge_field(files[0][0]);
+    write_scalar_field(files[1][0]);
+    write_ranlxd_state(files[2][0]);
+
+    async_save_gauge_field(files[0][1]);
+    async_save_scalar_field(files[1][1]);
+    async_save_ranlxd_state(files[2][1]);
+    async_save_start();
+
+    /* the fields change while the files are written */
+    random_u(u_gauge);
+    random_s(u_scalar);
+    start_gf_sendrecv(u_gauge);
+    complete_gf_sendrecv(u_gauge);
+
+    async_save_wait();
+
+    lprintf("MAIN", 0, "Checking the files written in the background.\n");
+    for (int k = 0; k < 3; k++)
+    {
+        char tmp[256];
+        sprintf(tmp, "%s.tmp", files[k][1]);
+        if (compare_files(files[k][0], files[k][1]))
+        {
+            lprintf("MAIN", 0, "File %s differs from %s\n", files[k][1], files[k][0]);
+            return_value++;
+        }
+        if (file_exists(tmp))
+        {
+            lprintf("MAIN", 0, "File %s was not removed\n", tmp);
+            return_value++;
+        }
+    }
+    lprintf("MAIN", 0, "(should be no differences)\n\n");
+
+    lprintf("MAIN", 0, "Reading back the configuration written in the background... ");
+    read_gauge_field(files[0][1]);
+    read_scalar_field(files[1][1]);
+    plaq[1] = avr_plaquette();
+    lprintf("MAIN", 0, "done.\n\n");
+
+    double dist = 0., sdist = 0.;
+    _MASTER_FOR_SUM(&glattice, ix, dist, sdist)
+    {
+        for (int mu = 0; mu < 4; mu++)
+        {
+            suNg *u = _4FIELD_AT(u_save, ix, mu), *w = _4FIELD_AT(u_gauge, ix, mu);
+            for (int i = 0; i < NG * NG; i++)
+                dist += cabs(u->c[i] - w->c[i]);
+        }
+        suNg_vector *v = _FIELD_AT(s_save, ix), *w = _FIELD_AT(u_scalar, ix);
+        for (int i = 0; i < NG; i++)
+            sdist += cabs(v->c[i] - w->c[i]);
+    }
+    global_sum(&dist, 1);
+    global_sum(&sdist, 1);
+
+    lprintf("MAIN", 0, "Plaquette difference = %.4e\n", fabs(plaq[1] - plaq[0]));
+    lprintf("MAIN", 0, "Gauge field distance = %.4e\n", dist);
+    lprintf("MAIN", 0, "Scalar field distance = %.4e\n", sdist);
+    lprintf("MAIN", 0, "(should be 0)\n\n");
+    if (fabs(plaq[1] - plaq[0]) > 1.e-14 || dist > 1.e-14 || sdist > 1.e-14)
+        return_value++;
+
+    for (int k = 0; k < 3; k++)
+    {
+        remove_file(files[k][0]);
+        remove_file(files[k][1]);
+    }
+
+    free_gfield(u_save);
+    free_scalar_field(s_save);
+
+    finalize_process();
+    return return_value;
+}